@@ -75,6 +75,7 @@ class elfio
     elfio() : sections( this ), segments( this )
     {
         real_file_length = 0;
+        file_view        = 0;
         header           = 0;
         current_file_pos = 0;
         create( ELFCLASS32, ELFDATA2LSB );
@@ -114,6 +115,16 @@ class elfio
 
 //------------------------------------------------------------------------------
     bool load( std::istream &stream )
+    {
+        return load( stream, 0, 0 );
+    }
+
+//------------------------------------------------------------------------------
+    // DECOMPILER BEGIN
+    // The file_data are the whole content of the stream which outlives this
+    // object. Data of sections and segments then refer to them and they are
+    // copied only when they are modified.
+    bool load( std::istream &stream, const char* file_data, size_t file_data_size )
     {
         if ( !stream ) {
             return false;
@@ -123,6 +134,8 @@ class elfio
         stream.seekg( 0, std::ios::end );
         real_file_length = stream.tellg();
         clean();
+        file_view = ( file_data_size == real_file_length ) ? file_data : 0;
+    // DECOMPILER END
 
         unsigned char e_ident[EI_NIDENT];
 
@@ -334,10 +347,10 @@ class elfio
         unsigned char file_class = get_class();
 
         if ( file_class == ELFCLASS64 ) {
-            new_section = new section_impl<Elf64_Shdr>( &convertor, real_file_length );
+            new_section = new section_impl<Elf64_Shdr>( &convertor, real_file_length, file_view );
         }
         else if ( file_class == ELFCLASS32 ) {
-            new_section = new section_impl<Elf32_Shdr>( &convertor, real_file_length );
+            new_section = new section_impl<Elf32_Shdr>( &convertor, real_file_length, file_view );
         }
         else {
             return 0;
@@ -356,10 +369,10 @@ class elfio
         unsigned char file_class = header->get_class();
 
         if ( file_class == ELFCLASS64 ) {
-            new_segment = new segment_impl<Elf64_Phdr>( &convertor, real_file_length );
+            new_segment = new segment_impl<Elf64_Phdr>( &convertor, real_file_length, file_view );
         }
         else if ( file_class == ELFCLASS32 ) {
-            new_segment = new segment_impl<Elf32_Phdr>( &convertor, real_file_length );
+            new_segment = new segment_impl<Elf32_Phdr>( &convertor, real_file_length, file_view );
         }
         else {
             return 0;
@@ -441,10 +454,10 @@ class elfio
             unsigned char file_class = header->get_class();
 
             if ( file_class == ELFCLASS64 ) {
-                seg = new segment_impl<Elf64_Phdr>( &convertor, real_file_length );
+                seg = new segment_impl<Elf64_Phdr>( &convertor, real_file_length, file_view );
             }
             else if ( file_class == ELFCLASS32 ) {
-                seg = new segment_impl<Elf32_Phdr>( &convertor, real_file_length );
+                seg = new segment_impl<Elf32_Phdr>( &convertor, real_file_length, file_view );
             }
             else {
                 return false;
@@ -871,6 +884,7 @@ class elfio
 //------------------------------------------------------------------------------
   private:
     size_t                real_file_length;
+    const char*           file_view;
     elf_header*           header;
     std::ifstream         ifStream;
     std::istream*         iStream;
@@ -74,19 +74,24 @@ class section_impl : public section
 {
   public:
 //------------------------------------------------------------------------------
-    section_impl( const endianess_convertor* convertor_, size_t file_length_ ) :
-        convertor( convertor_ ), file_length( file_length_ )
+    // DECOMPILER BEGIN
+    // If the file_view_ is given, loaded data refer to it instead of being copied.
+    section_impl( const endianess_convertor* convertor_, size_t file_length_,
+                  const char* file_view_ = 0 ) :
+        convertor( convertor_ ), file_length( file_length_ ), file_view( file_view_ )
     {
         std::fill_n( reinterpret_cast<char*>( &header ), sizeof( header ), '\0' );
         is_address_set = false;
         data           = 0;
         data_size      = 0;
+        is_data_owned  = false;
     }
+    // DECOMPILER END
 
 //------------------------------------------------------------------------------
     ~section_impl()
     {
-        delete [] data;
+        release_data();
     }
 
 //------------------------------------------------------------------------------
@@ -158,17 +163,22 @@ class section_impl : public section
     set_data( const char* raw_data, Elf_Word size )
     {
         if ( get_type() != SHT_NOBITS ) {
-            delete [] data;
+            release_data();
+            char* new_data;
             try {
-                data = new char[size];
+                new_data = new char[size];
             } catch (const std::bad_alloc&) {
-                data      = 0;
+                new_data  = 0;
                 data_size = 0;
                 size      = 0;
             }
-            if ( 0 != data && 0 != raw_data ) {
+            if ( 0 != new_data ) {
+                data          = new_data;
+                is_data_owned = true;
+            }
+            if ( 0 != new_data && 0 != raw_data ) {
                 data_size = size;
-                std::copy( raw_data, raw_data + size, data );
+                std::copy( raw_data, raw_data + size, new_data );
             }
         }
 
@@ -187,8 +197,8 @@ class section_impl : public section
     append_data( const char* raw_data, Elf_Word size )
     {
         if ( get_type() != SHT_NOBITS ) {
-            if ( get_size() + size < data_size ) {
-                std::copy( raw_data, raw_data + size, data + get_size() );
+            if ( is_data_owned && get_size() + size < data_size ) {
+                std::copy( raw_data, raw_data + size, const_cast<char*>( data ) + get_size() );
             }
             else {
                 data_size = 2*( data_size + size);
@@ -202,8 +212,9 @@ class section_impl : public section
                 if ( 0 != new_data ) {
                     std::copy( data, data + get_size(), new_data );
                     std::copy( raw_data, raw_data + size, new_data + get_size() );
-                    delete [] data;
-                    data = new_data;
+                    release_data();
+                    data          = new_data;
+                    is_data_owned = true;
                 }
             }
             set_size( get_size() + size );
@@ -224,17 +235,28 @@ class section_impl : public section
           size_t        size )
     {
         if ( get_type() != SHT_NULL && get_type() != SHT_NOBITS && size != 0 ) {
+            release_data();
+            // DECOMPILER BEGIN
+            if ( 0 != file_view && data_offset <= file_length &&
+                 size <= file_length - data_offset ) {
+                data      = file_view + data_offset;
+                data_size = size;
+                return;
+            }
+            // DECOMPILER END
             stream.seekg( data_offset );
-            delete [] data;
+            char* new_data;
             try {
-                data = new char[size];
+                new_data = new char[size];
             } catch (const std::bad_alloc&) {
-                data      = 0;
+                new_data  = 0;
                 data_size = 0;
                 size      = 0;
             }
-            if ( 0 != data ) {
-                stream.read( data, size );
+            if ( 0 != new_data ) {
+                data          = new_data;
+                is_data_owned = true;
+                stream.read( new_data, size );
                 data_size = stream.gcount();
             }
         }
@@ -257,7 +279,7 @@ class section_impl : public section
     load( std::istream&  stream,
           std::streampos header_offset )
     {
-        data = 0;
+        release_data();
         data_size = 0;
         if ( header_offset >= file_length ) {
             return;
@@ -277,15 +299,25 @@ class section_impl : public section
         Elf_Xword size = get_size();
         size = std::min<Elf_Xword>( file_length - section_offset, size );
         if ( 0 == data && SHT_NULL != get_type() && SHT_NOBITS != get_type() && 0 != size ) {
+            // DECOMPILER BEGIN
+            if ( 0 != file_view ) {
+                data      = file_view + section_offset;
+                data_size = size;
+                return;
+            }
+            // DECOMPILER END
+            char* new_data;
             try {
-                data = new char[size];
+                new_data = new char[size];
             } catch (const std::bad_alloc&) {
-                data      = 0;
+                new_data  = 0;
                 data_size = 0;
             }
-            if ( 0 != size ) {
+            if ( 0 != new_data ) {
+                data          = new_data;
+                is_data_owned = true;
                 stream.seekg( section_offset );
-                stream.read( data, size );
+                stream.read( new_data, size );
                 data_size = stream.gcount();
             }
         }
@@ -311,6 +343,19 @@ class section_impl : public section
 
 //------------------------------------------------------------------------------
   private:
+//------------------------------------------------------------------------------
+    // DECOMPILER BEGIN
+    void
+    release_data()
+    {
+        if ( is_data_owned ) {
+            delete [] data;
+        }
+        data          = 0;
+        is_data_owned = false;
+    }
+    // DECOMPILER END
+
 //------------------------------------------------------------------------------
     void
     save_header( std::ostream&  f,
@@ -334,11 +379,13 @@ class section_impl : public section
     T                          header;
     Elf_Half                   index;
     std::string                name;
-    char*                      data;
+    const char*                data;
     Elf_Xword                  data_size;
+    bool                       is_data_owned;
     const endianess_convertor* convertor;
     bool                       is_address_set;
     size_t                     file_length;
+    const char*                file_view;
 };
 
 } // namespace ELFIO
@@ -71,19 +71,24 @@ class segment_impl : public segment
 {
   public:
 //------------------------------------------------------------------------------
-    segment_impl( endianess_convertor* convertor_, size_t file_length_ ) :
-        convertor( convertor_ ), file_length( file_length_ )
+    // DECOMPILER BEGIN
+    // If the file_view_ is given, loaded data refer to it instead of being copied.
+    segment_impl( endianess_convertor* convertor_, size_t file_length_,
+                  const char* file_view_ = 0 ) :
+        convertor( convertor_ ), file_length( file_length_ ), file_view( file_view_ )
     {
         is_offset_set = false;
         std::fill_n( reinterpret_cast<char*>( &ph ), sizeof( ph ), '\0' );
-        data      = 0;
-        data_size = 0;
+        data          = 0;
+        data_size     = 0;
+        is_data_owned = false;
     }
+    // DECOMPILER END
 
 //------------------------------------------------------------------------------
     virtual ~segment_impl()
     {
-        delete [] data;
+        release_data();
     }
 
 //------------------------------------------------------------------------------
@@ -187,7 +192,7 @@ class segment_impl : public segment
     load( std::istream&  stream,
           std::streampos header_offset )
     {
-        data = 0;
+        release_data();
         data_size = 0;
         if ( header_offset >= file_length ) {
             return;
@@ -200,17 +205,27 @@ class segment_impl : public segment
 
         if ( PT_NULL != get_type() && 0 != get_file_size() &&
             segmentOffset < file_length ) {
-            stream.seekg( segmentOffset );
             Elf_Xword size = std::min<Elf_Xword>( file_length - segmentOffset,
                 get_file_size() );
+            // DECOMPILER BEGIN
+            if ( 0 != file_view ) {
+                data      = file_view + segmentOffset;
+                data_size = size;
+                return;
+            }
+            // DECOMPILER END
+            stream.seekg( segmentOffset );
+            char* new_data;
             try {
-                data = new char[size];
+                new_data = new char[size];
             } catch (const std::bad_alloc&) {
-                data = 0;
+                new_data  = 0;
                 data_size = 0;
             }
-            if ( 0 != data ) {
-                stream.read( data, size );
+            if ( 0 != new_data ) {
+                data          = new_data;
+                is_data_owned = true;
+                stream.read( new_data, size );
                 data_size = stream.gcount();
             }
         }
@@ -236,32 +251,60 @@ class segment_impl : public segment
           size_t        size )
     {
         if ( PT_NULL != get_type() && 0 != size ) {
-            stream.seekg( data_offset );
             is_offset_set = true;
-            delete [] data;
+            release_data();
+            // DECOMPILER BEGIN
+            if ( 0 != file_view && data_offset <= file_length &&
+                 size <= file_length - data_offset ) {
+                data      = file_view + data_offset;
+                data_size = size;
+                return;
+            }
+            // DECOMPILER END
+            stream.seekg( data_offset );
+            char* new_data;
             try {
-                data = new char[size];
+                new_data = new char[size];
             } catch (const std::bad_alloc&) {
-                data      = 0;
+                new_data  = 0;
                 data_size = 0;
             }
-            if ( 0 != data ) {
-                stream.read( data, size );
+            if ( 0 != new_data ) {
+                data          = new_data;
+                is_data_owned = true;
+                stream.read( new_data, size );
                 data_size = stream.gcount();
             }
         }
     }
 
+//------------------------------------------------------------------------------
+  private:
+//------------------------------------------------------------------------------
+    // DECOMPILER BEGIN
+    void
+    release_data()
+    {
+        if ( is_data_owned ) {
+            delete [] data;
+        }
+        data          = 0;
+        is_data_owned = false;
+    }
+    // DECOMPILER END
+
 //------------------------------------------------------------------------------
   private:
     T                     ph;
     Elf_Half              index;
-    char*                 data;
+    const char*           data;
     Elf_Xword             data_size;
+    bool                  is_data_owned;
     std::vector<Elf_Half> sections;
     endianess_convertor*  convertor;
     bool                  is_offset_set;
     size_t                file_length;
+    const char*           file_view;
 };
 
 } // namespace ELFIO
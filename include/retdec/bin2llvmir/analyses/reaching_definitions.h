@@ -3,9 +3,8 @@
 * @brief Reaching definitions analysis (RDA) builds UD and DU chains.
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 *
-* Right now, this works on an entire module. But we could insert an another layer
-* that represents functions. Then it would be possible to associate BBs with
-* functions that own them and recompute RDA only for the selected function.
+* The analysis is computed for every function separately. When it is run on an
+* entire module, the functions are analysed in parallel.
 */
 
 #ifndef RETDEC_BIN2LLVMIR_ANALYSES_REACHING_DEFINITIONS_H
@@ -17,6 +16,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include <llvm/ADT/BitVector.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 
@@ -29,6 +29,7 @@ namespace bin2llvmir {
 class Definition;
 class Use;
 class BasicBlockEntry;
+class FunctionEntry;
 class ReachingDefinitionsAnalysis;
 
 using Changed = bool;
@@ -59,6 +60,9 @@ class Definition
 		/// Definition instruction position in its BB.
 		/// Can be used to find out if def dominates its uses in the same BB.
 		unsigned posInBb = 0;
+		/// Definition number in its function.
+		/// Index of the definition in bit vectors of definitions.
+		unsigned id = 0;
 };
 
 class Use
@@ -80,6 +84,20 @@ class Use
 		unsigned posInBb = 0;
 };
 
+/**
+ * All definitions of one value in a function.
+ */
+class ValueDefinitions
+{
+	public:
+		/// Numbers of the definitions.
+		std::vector<unsigned> ids;
+		/// The definitions as a bit vector. It is created only for values with
+		/// so many definitions that resetting them one by one would be slower
+		/// than resetting the whole bit vector.
+		llvm::BitVector mask;
+};
+
 class BasicBlockEntry
 {
 	public:
@@ -90,8 +108,9 @@ class BasicBlockEntry
 				std::ostream& out,
 				const BasicBlockEntry& bbe);
 
-		void initializeKillDefSets();
-		Changed initDefsOut();
+		void initializeKillGenSets(const FunctionEntry& fe);
+		void computeDefsIn(llvm::BitVector& defsIn) const;
+		Changed initDefsOut(llvm::BitVector& tmp);
 
 		const DefSet& defsFromUse(const llvm::Instruction* I) const;
 		const UseSet& usesFromDef(const llvm::Instruction* I) const;
@@ -105,18 +124,46 @@ class BasicBlockEntry
 		UseVector uses;
 
 		BBEntrySet prevBBs;
+		std::vector<BasicBlockEntry*> nextBBs;
 
 		// defsIn is union of prevBBs' defsOuts
-		DefSet defsOut;
-		DefSet genDefs;
-		std::unordered_set<llvm::Value*> killDefs;
+		llvm::BitVector defsOut;
+		/// Last definition of every value defined in this BB.
+		std::vector<unsigned> genDefs;
+		/// Definitions of values defined in this BB.
+		std::vector<const ValueDefinitions*> killDefs;
 
-		bool changed = false;
+		bool inWorkList = false;
 
 	private:
 		unsigned id;
 };
 
+/**
+ * Reaching definitions in one function.
+ *
+ * Definitions are numbered in the order of BBs in the function, sets of
+ * definitions are bit vectors indexed by these numbers.
+ */
+class FunctionEntry
+{
+	public:
+		void initializeBasicBlocksPrev();
+		void initializeKillGenSets();
+		void propagate();
+		void initializeDefsAndUses();
+		void clearInternal();
+
+	public:
+		std::unordered_map<const llvm::BasicBlock*, BasicBlockEntry> bbMap;
+		/// BBs in the order they are in the function.
+		std::vector<BasicBlockEntry*> bbs;
+
+		/// All definitions in the function indexed by their numbers.
+		std::vector<Definition*> defs;
+		std::unordered_map<const llvm::Value*, ValueDefinitions> valueDefs;
+};
+
 class ReachingDefinitionsAnalysis
 {
 	public:
@@ -152,21 +199,18 @@ class ReachingDefinitionsAnalysis
 				llvm::Instruction* I);
 
 	private:
-		void run();
+		void run(llvm::Function& F, FunctionEntry& fe);
 		const BasicBlockEntry& getBasicBlockEntry(const llvm::Instruction* I) const;
-		void initializeBasicBlocks(llvm::Module& M);
-		void initializeBasicBlocks(llvm::Function& F);
-		void initializeBasicBlocksPrev();
-		void initializeKillGenSets();
-		void propagate();
-		void initializeDefsAndUses();
-		void clearInternal();
+		void initializeBasicBlocks(llvm::Function& F, FunctionEntry& fe);
 
 	private:
-		std::map<const llvm::Function*, std::map<const llvm::BasicBlock*, BasicBlockEntry>> bbMap;
+		std::map<const llvm::Function*, FunctionEntry> fncMap;
 		bool _trackFlagRegs = false;
 		const llvm::GlobalVariable* _specialGlobal = nullptr;
 		bool _run = false;
+		/// Was the analysis of the module cancelled before all functions
+		/// were analysed?
+		bool _cancelled = false;
 		Abi* _abi = nullptr;
 };
 
@@ -29,11 +29,13 @@
 #include "retdec/bin2llvmir/providers/names.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_debug.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_ranges.h"
+#include "retdec/bin2llvmir/optimizations/decoder/instruction_cache.h"
 #include "retdec/bin2llvmir/optimizations/decoder/jump_targets.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #include "retdec/bin2llvmir/utils/symbolic_tree_match.h"
 #include "retdec/capstone2llvmir/capstone2llvmir.h"
 #include "retdec/stacofin/stacofin.h"
+#include "retdec/utils/cancellation.h"
 
 namespace retdec {
 namespace bin2llvmir {
@@ -53,6 +55,8 @@ class Decoder : public llvm::ModulePass
 				NameContainer* n,
 				Abi* a);
 
+		void setCancellationToken(const utils::CancellationToken* token);
+
 	private:
 		using ByteData = typename std::pair<const std::uint8_t*, std::size_t>;
 
@@ -296,6 +300,8 @@ class Decoder : public llvm::ModulePass
 		NameContainer* _names = nullptr;
 		Llvm2CapstoneInsnMap* _llvm2capstone = nullptr;
 		Abi* _abi = nullptr;
+		/// If set, decoding stops when it is cancelled.
+		const utils::CancellationToken* _cancellation = nullptr;
 
 		std::unique_ptr<capstone2llvmir::Capstone2LlvmIrTranslator> _c2l;
 		cs_insn* _dryCsInsn = nullptr;
@@ -303,6 +309,8 @@ class Decoder : public llvm::ModulePass
 		llvm::IRBuilder<>* _irb;
 
 		RangesToDecode _ranges;
+		/// Instructions disassembled ahead of decoding.
+		InstructionCache _insnCache;
 		JumpTargets _jumpTargets;
 
 		/// Name of all extern functions gathered from object files
@@ -39,6 +39,10 @@ class RangesToDecode
 		const common::AddressRange* getAlternative(common::Address a) const;
 		const common::AddressRange* get(common::Address a) const;
 
+		const common::AddressRangeContainer& getPrimaryRanges() const;
+		const common::AddressRangeContainer& getAlternativeRanges() const;
+		unsigned getArchitectureInstructionAlignment() const;
+
 		void setArchitectureInstructionAlignment(unsigned a);
 
 	friend std::ostream& operator<<(std::ostream &os, const RangesToDecode& rs);
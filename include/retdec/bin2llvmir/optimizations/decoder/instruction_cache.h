@@ -0,0 +1,107 @@
+/**
+* @file include/retdec/bin2llvmir/optimizations/decoder/instruction_cache.h
+* @brief Cache of speculatively disassembled instructions.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_INSTRUCTION_CACHE_H
+#define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_INSTRUCTION_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <capstone/capstone.h>
+
+#include "retdec/common/address.h"
+#include "retdec/bin2llvmir/optimizations/decoder/decoder_ranges.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/utils/cancellation.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Instructions disassembled ahead of decoding.
+ *
+ * Ranges to decode are split into chunks which are linearly disassembled in
+ * parallel, every thread uses its own Capstone engine. Decoding then takes
+ * instructions from the cache instead of disassembling them again.
+ *
+ * Disassembly is speculative: a linear sweep does not have to hit the same
+ * instruction boundaries as decoding. Outside of the Thumb mode, an
+ * instruction is disassembled the same way whenever its address, bytes and
+ * mode are the same, so any instruction found in the cache is the one
+ * Capstone would produce. Addresses not in the cache are simply disassembled
+ * by the caller.
+ *
+ * In the Thumb mode, Capstone keeps the state of IT blocks between
+ * instructions, so the result depends also on the previously disassembled
+ * instructions. Nothing is cached in this mode.
+ */
+class InstructionCache
+{
+	public:
+		/// Cached instructions (including details) never take more memory
+		/// than this (see getMaxCacheSize()).
+		static const std::size_t maxCacheSize = 512 * 1024 * 1024;
+		/// Size of address ranges disassembled by one thread at a time.
+		static const std::size_t chunkSize = 64 * 1024;
+
+	public:
+		void build(
+				cs_arch arch,
+				cs_mode basicMode,
+				cs_mode extraMode,
+				FileImage* image,
+				const RangesToDecode& ranges,
+				std::size_t threads = 1,
+				const utils::CancellationToken* cancellation = nullptr);
+		void clear();
+
+		std::size_t size() const;
+		static std::size_t getMaxCacheSize();
+
+		const cs_insn* get(
+				cs_mode basicMode,
+				common::Address a,
+				std::size_t maxSize) const;
+		bool disasm(
+				csh ce,
+				cs_mode basicMode,
+				const uint8_t** code,
+				std::size_t* size,
+				uint64_t* address,
+				cs_insn* insn) const;
+
+	private:
+		class Chunk
+		{
+			public:
+				common::Address start;
+				common::Address end;
+				/// Bytes from the chunk start to the end of its range.
+				/// The last instruction may exceed the chunk.
+				const std::uint8_t* bytes = nullptr;
+				std::size_t bytesSize = 0;
+				/// Instructions ordered by their addresses.
+				std::vector<cs_insn> insns;
+				/// Details of instructions, same order as @c insns.
+				std::vector<cs_detail> details;
+		};
+
+		void disassembleChunk(
+				csh ce,
+				unsigned alignment,
+				Chunk& chunk) const;
+
+	private:
+		/// Chunks ordered by their start addresses.
+		std::vector<Chunk> _chunks;
+		cs_mode _basicMode = CS_MODE_LITTLE_ENDIAN;
+		std::size_t _size = 0;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -7,9 +7,13 @@
 #ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_PROVIDER_INIT_PROVIDER_INIT_H
 #define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_PROVIDER_INIT_PROVIDER_INIT_H
 
+#include <memory>
+
 #include <llvm/IR/Module.h>
 #include <llvm/Pass.h>
 
+#include "retdec/utils/cancellation.h"
+
 namespace retdec {
 
 namespace config {
@@ -17,6 +21,11 @@ namespace config {
 class Config;
 
 } // namespace config
+namespace fileformat {
+
+class FileFormat;
+
+} // namespace fileformat
 namespace bin2llvmir {
 
 class ProviderInitialization : public llvm::ModulePass
@@ -28,9 +37,16 @@ class ProviderInitialization : public llvm::ModulePass
 		virtual bool doFinalization(llvm::Module& m) override;
 
 		void setConfig(retdec::config::Config* c);
+		void setInputFile(
+				const std::shared_ptr<retdec::fileformat::FileFormat>& f);
+		void setCancellationToken(const utils::CancellationToken* token);
+
+		static void clearProviders(llvm::Module* m);
 
 	private:
 		retdec::config::Config* _config = nullptr;
+		std::shared_ptr<retdec::fileformat::FileFormat> _inputFile;
+		const utils::CancellationToken* _cancellation = nullptr;
 };
 
 } // namespace bin2llvmir
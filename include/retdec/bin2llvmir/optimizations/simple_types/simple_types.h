@@ -10,6 +10,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -206,6 +207,8 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		virtual bool runOnModule(llvm::Module& m) override;
 		virtual void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
 
+		static void clear(llvm::Module* m);
+
 	private:
 		void buildEqSets(llvm::Module& M);
 		void buildEquations();
@@ -227,6 +230,11 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		FileImage* objf = nullptr;
 
 		std::unordered_set<llvm::Instruction*> instToErase;
+
+		/// The pass runs twice on every module, each run does something
+		/// else. These are modules whose first run was already done.
+		static std::set<llvm::Module*> _firstRunDone;
+		static std::mutex _firstRunDoneMutex;
 };
 
 } // namespace bin2llvmir
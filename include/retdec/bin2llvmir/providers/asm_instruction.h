@@ -7,7 +7,13 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <capstone/capstone.h>
+#include "retdec/capstone2llvmir/insn_arena.h"
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
 #include "retdec/capstone2llvmir/mips/mips_defs.h"
 #include "retdec/capstone2llvmir/powerpc/powerpc_defs.h"
@@ -15,6 +21,7 @@
 
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/ValueHandle.h>
 
 #include "retdec/bin2llvmir/utils/llvm.h"
 #include "retdec/common/address.h"
@@ -154,6 +161,8 @@ class AsmInstruction
 	public:
 		static Llvm2CapstoneInsnMap& getLlvmToCapstoneInsnMap(
 				const llvm::Module* m);
+		static std::shared_ptr<capstone2llvmir::InsnArena>
+				getCapstoneInsnArena(const llvm::Module* m);
 		static llvm::GlobalVariable* getLlvmToAsmGlobalVariable(
 				const llvm::Module* m);
 		static void setLlvmToAsmGlobalVariable(
@@ -175,24 +184,37 @@ class AsmInstruction
 				llvm::Function* f);
 		static bool isLlvmToAsmInstruction(const llvm::Value* inst);
 		static void clear();
+		static void clear(const llvm::Module* m);
 
 	private:
 		const llvm::GlobalVariable* getLlvmToAsmGlobalVariablePrivate(
 				llvm::Module* m) const;
 		bool isLlvmToAsmInstructionPrivate(llvm::Value* inst) const;
+		static bool isLlvmToAsmInstruction(
+				const llvm::Value* inst,
+				const llvm::Value* gv);
 
 	private:
-		using ModuleGlobalPair = std::pair<
-				const llvm::Module*,
-				llvm::GlobalVariable*>;
-		using ModuleInstructionMap = std::pair<
-				const llvm::Module*,
-				std::map<llvm::StoreInst*, cs_insn*>>;
+		/// LLVM to ASM mapping instructions of one module by ASM instruction
+		/// addresses. Entries of deleted mapping instructions are null.
+		struct AddressIndex
+		{
+			/// Number of ASM instructions in the module when the index was
+			/// started.
+			std::size_t asmInsnCount = 0;
+			std::unordered_map<std::uint64_t, llvm::WeakVH> addr2asm;
+		};
+		static AddressIndex& getAddressIndex(const llvm::Module* m);
 
 	private:
 		llvm::StoreInst* _llvmToAsmInstr = nullptr;
-		static std::vector<ModuleGlobalPair> _module2global;
-		static std::vector<ModuleInstructionMap> _module2instMap;
+		static std::map<const llvm::Module*, llvm::GlobalVariable*> _module2global;
+		static std::map<const llvm::Module*, Llvm2CapstoneInsnMap> _module2instMap;
+		static std::map<
+				const llvm::Module*,
+				std::shared_ptr<capstone2llvmir::InsnArena>> _module2arena;
+		static std::map<const llvm::Module*, AddressIndex> _module2addressIndex;
+		static std::mutex _mutex;
 
 	public:
 		template<
@@ -7,6 +7,7 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 
+#include <mutex>
 #include <optional>
 
 #include "retdec/config/config.h"
@@ -15,6 +16,7 @@
 #include <llvm/IR/Module.h>
 
 #include "retdec/common/address.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/filesystem.h"
 
 namespace retdec {
@@ -170,6 +172,10 @@ class Config
 		//
 		llvm::GlobalVariable* getGlobalDummy();
 		fs::path getOutputDirectory();
+		std::size_t getNumberOfThreads() const;
+		void setCancellationToken(const utils::CancellationToken* token);
+		const utils::CancellationToken* getCancellationToken() const;
+		bool isCancelled() const;
 		bool getCryptoPattern(
 				retdec::common::Address addr,
 				std::string& name,
@@ -185,6 +191,7 @@ class Config
 	private:
 		retdec::config::Config& _configDB;
 		llvm::GlobalVariable* _globalDummy = nullptr;
+		const utils::CancellationToken* _cancellation = nullptr;
 
 		llvm::Function* _callFunction = nullptr;
 		llvm::Function* _returnFunction = nullptr;
@@ -206,9 +213,11 @@ class ConfigProvider
 		static bool getConfig(llvm::Module* m, Config*& c);
 		static void doFinalization(llvm::Module* m);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Config> _module2config;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
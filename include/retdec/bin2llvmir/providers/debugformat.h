@@ -7,6 +7,8 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 
+#include <mutex>
+
 #include <llvm/IR/Module.h>
 
 #include "retdec/bin2llvmir/providers/demangler.h"
@@ -49,10 +51,12 @@ class DebugFormatProvider
 		static bool getDebugFormat(llvm::Module* m, DebugFormat*& df);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		/// Mapping of modules to debug info associated with them.
 		static std::map<llvm::Module*, DebugFormat> _module2debug;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -7,6 +7,8 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 
+#include <mutex>
+
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
@@ -134,6 +136,7 @@ class FileImageProvider
 				FileImage*& img);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static FileImage* addFileImage(
@@ -143,6 +146,7 @@ class FileImageProvider
 	private:
 		/// Mapping of modules to file images associated with them.
 		static std::map<llvm::Module*, FileImage> _module2image;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
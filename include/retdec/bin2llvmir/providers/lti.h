@@ -7,6 +7,13 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <llvm/IR/Module.h>
 
 #include "retdec/ctypesparser/json_ctypes_parser.h"
@@ -40,8 +47,28 @@ class Lti
 		FunctionPair getPairFunction(const std::string& name);
 		llvm::Function* getLlvmFunction(const std::string& name);
 
+		static void clearCache();
+
 	private:
-		void loadLtiFile(const std::string& filePath);
+		/// Bit width, type widths, ordered list of loaded LTI files, and
+		/// stamp of the files (see utils::ResultCache::getFilesStamp()).
+		using LtiModuleKey = std::tuple<
+				unsigned,
+				ctypesparser::TypeConfig::TypeWidths,
+				std::vector<std::string>,
+				std::string>;
+		/// LTI module parsed at most once, by the first thread requesting it.
+		struct LtiModuleEntry
+		{
+			std::once_flag parsed;
+			std::shared_ptr<const retdec::ctypes::Module> module;
+		};
+
+	private:
+		static std::shared_ptr<const retdec::ctypes::Module> getLtiModule(
+				const LtiModuleKey& key);
+		static std::shared_ptr<const retdec::ctypes::Module> parseLtiModule(
+				const LtiModuleKey& key);
 		llvm::Type* getLlvmType(std::shared_ptr<retdec::ctypes::Type> type);
 
 	private:
@@ -49,8 +76,13 @@ class Lti
 		Config* _config = nullptr;
 		std::shared_ptr<ctypesparser::TypeConfig> _typeConfig;
 		retdec::loader::Image* _image = nullptr;
-		std::unique_ptr<retdec::ctypes::Module> _ltiModule;
-		ctypesparser::JSONCTypesParser _ltiParser;
+		std::shared_ptr<const retdec::ctypes::Module> _ltiModule;
+
+		/// Parsed LTI modules are immutable and shared by all Lti instances
+		/// (i.e. by all the modules, possibly in different threads).
+		static std::map<LtiModuleKey,
+				std::shared_ptr<LtiModuleEntry>> _ltiModules;
+		static std::mutex _ltiModulesMutex;
 };
 
 class LtiProvider
@@ -64,9 +96,11 @@ class LtiProvider
 		static Lti* getLti(llvm::Module* m);
 		static bool getLti(llvm::Module* m, Lti*& lti);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Lti> _module2lti;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
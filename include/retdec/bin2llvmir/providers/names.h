@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_NAMES_H
 
 #include <map>
+#include <mutex>
 #include <set>
 
 #include "retdec/bin2llvmir/providers/config.h"
@@ -211,9 +212,11 @@ class NamesProvider
 		static NameContainer* getNames(llvm::Module* m);
 		static bool getNames(llvm::Module* m, NameContainer*& names);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, NameContainer> _module2names;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -20,6 +20,7 @@
 
 #include "retdec/common/address.h"
 #include "retdec/capstone2llvmir/exceptions.h"
+#include "retdec/capstone2llvmir/insn_arena.h"
 
 // These are additions to capstone - include them all here.
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
@@ -284,10 +285,19 @@ class Capstone2LlvmIrTranslator
 		 * Default value: true.
 		 */
 		virtual void setGeneratePseudoAsmFunctions(bool f) = 0;
+		/**
+		 * Set arena in which Capstone instructions from translation results
+		 * are allocated. It may be shared with other owners (e.g. it may
+		 * outlive the translator).
+		 *
+		 * Default value: arena created with (and owned by) the translator.
+		 */
+		virtual void setInstructionArena(std::shared_ptr<InsnArena> a) = 0;
 
 		virtual bool isIgnoreUnexpectedOperands() const = 0;
 		virtual bool isIgnoreUnhandledInstructions() const = 0;
 		virtual bool isGeneratePseudoAsmFunctions() const = 0;
+		virtual const std::shared_ptr<InsnArena>& getInstructionArena() const = 0;
 //
 //==============================================================================
 // Mode query & modification methods.
@@ -353,8 +363,8 @@ class Capstone2LlvmIrTranslator
 			/// All created LLVM IR instructions are added to the working LLVM
 			/// module and should be automatically destroyed when module is
 			/// destroyed.
-			/// All capstone instructions are dynamically allocated by this
-			/// method, and must be freed by caller to avoid memory leaks.
+			/// All capstone instructions are allocated in the instruction
+			/// arena, and must not be freed by caller.
 			std::list<std::pair<llvm::StoreInst*, cs_insn*>> insns;
 			/// Byte size of the translated binary chunk.
 			std::size_t size = 0;
@@ -402,8 +412,8 @@ class Capstone2LlvmIrTranslator
 			/// destroyed.
 			llvm::StoreInst* llvmInsn = nullptr;
 			/// Translated capstone instruction.
-			/// Capstone instruction is dynamically allocated by this
-			/// method, and must be freed by caller to avoid memory leaks.
+			/// Capstone instruction is allocated in the instruction arena,
+			/// and must not be freed by caller.
 			cs_insn* capstoneInsn = nullptr;
 			/// Byte size of the translated binary chunk.
 			std::size_t size = 0;
@@ -433,6 +443,18 @@ class Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) = 0;
+		/**
+		 * Translate one already disassembled assembly instruction.
+		 * @param insn  Instruction disassembled in the current mode, with
+		 *              details. It is copied, the result holds the copy.
+		 * @param irb   LLVM IR builder used to create LLVM IR translation.
+		 *              Translated LLVM IR instructions are created at its
+		 *              current position.
+		 * @return See @c TranslationResult structure.
+		 */
+		virtual TranslationResultOne translateOne(
+				const cs_insn& insn,
+				llvm::IRBuilder<>& irb) = 0;
 //
 //==============================================================================
 // Capstone related getters and query methods.
@@ -0,0 +1,65 @@
+/**
+ * @file include/retdec/capstone2llvmir/insn_arena.h
+ * @brief Storage of Capstone instructions kept after their translation.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CAPSTONE2LLVMIR_INSN_ARENA_H
+#define RETDEC_CAPSTONE2LLVMIR_INSN_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <capstone/capstone.h>
+
+namespace retdec {
+namespace capstone2llvmir {
+
+/**
+ * Arena allocating Capstone instructions (@c cs_insn with @c cs_detail) in
+ * slabs of many instructions.
+ *
+ * Instructions are never freed one by one (with the exception of the last
+ * allocated one), all of them are freed at once by @c clear() or when the
+ * arena is destroyed. They must not be freed by @c cs_free().
+ *
+ * Instances of this class are not thread-safe.
+ */
+class InsnArena
+{
+	public:
+		InsnArena(std::size_t slabSize = 1024);
+
+		InsnArena(const InsnArena&) = delete;
+		InsnArena& operator=(const InsnArena&) = delete;
+
+		cs_insn* allocate();
+		cs_insn* allocate(const cs_insn& insn);
+		void deallocateLast();
+
+		void releaseDetails();
+		void clear();
+
+		std::size_t size() const;
+		std::size_t getMemoryUsage() const;
+
+	private:
+		struct Slab
+		{
+			std::unique_ptr<cs_insn[]> insns;
+			/// @c nullptr if details of the slab were released.
+			std::unique_ptr<cs_detail[]> details;
+		};
+
+	private:
+		std::size_t _slabSize;
+		std::vector<Slab> _slabs;
+		/// Number of allocated instructions.
+		std::size_t _size = 0;
+};
+
+} // namespace capstone2llvmir
+} // namespace retdec
+
+#endif
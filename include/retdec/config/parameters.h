@@ -58,12 +58,17 @@ class Parameters
 		void setOutputLlvmirFile(const std::string& file);
 		void setOutputConfigFile(const std::string& file);
 		void setOutputUnpackedFile(const std::string& file);
+		void setOutputProfileFile(const std::string& file);
 		void setOutputFormat(const std::string& format);
 		void setLogFile(const std::string& file);
 		void setErrFile(const std::string& file);
+		void setCacheDirectory(const std::string& dir);
 		void setMaxMemoryLimit(uint64_t limit);
 		void setIsMaxMemoryLimitHalfRam(bool f);
+		void setMaxMemorySoftLimit(uint64_t limit);
 		void setTimeout(uint64_t seconds);
+		void setDecoderTimeout(uint64_t seconds);
+		void setBackendOptsTimeout(uint64_t seconds);
 		void setEntryPoint(const retdec::common::Address& a);
 		void setMainAddress(const retdec::common::Address& a);
 		void setSectionVMA(const retdec::common::Address& a);
@@ -71,6 +76,7 @@ class Parameters
 		void setBackendEnabledOpts(const std::string& o);
 		void setBackendCallInfoObtainer(const std::string& val);
 		void setBackendVarRenamer(const std::string& val);
+		void setBackendThreads(uint64_t n);
 		void setIsDetectStaticCode(bool b);
 		void setIsBackendNoOpts(bool b);
 		void setIsBackendEmitCfg(bool b);
@@ -94,11 +100,16 @@ class Parameters
 		const std::string& getOutputLlvmirFile() const;
 		const std::string& getOutputConfigFile() const;
 		const std::string& getOutputUnpackedFile() const;
+		const std::string& getOutputProfileFile() const;
 		const std::string& getOutputFormat() const;
 		const std::string& getLogFile() const;
 		const std::string& getErrFile() const;
+		const std::string& getCacheDirectory() const;
 		uint64_t getMaxMemoryLimit() const;
+		uint64_t getMaxMemorySoftLimit() const;
 		uint64_t getTimeout() const;
+		uint64_t getDecoderTimeout() const;
+		uint64_t getBackendOptsTimeout() const;
 		retdec::common::Address getEntryPoint() const;
 		retdec::common::Address getMainAddress() const;
 		retdec::common::Address getSectionVMA() const;
@@ -106,6 +117,7 @@ class Parameters
 		const std::string& getBackendEnabledOpts() const;
 		const std::string& getBackendCallInfoObtainer() const;
 		const std::string& getBackendVarRenamer() const;
+		uint64_t getBackendThreads() const;
 		/// @}
 
 		void fixRelativePaths(const std::string& configPath);
@@ -159,18 +171,37 @@ class Parameters
 		std::string _outputLlFile;
 		std::string _outputConfigFile;
 		std::string _outputUnpackedFile;
+		/// Performance profile of the decompilation passes is written into
+		/// this file. If empty, the passes are not profiled.
+		std::string _outputProfileFile;
 		std::string _outputFormat;
 		std::string _logFile;
 		std::string _errFile;
+		/// Intermediate results of the decompilation are cached in this
+		/// directory. If empty, nothing is cached.
+		std::string _cacheDirectory;
 		uint64_t _maxMemoryLimit = 0;
 		bool _maxMemoryLimitHalfRam = true;
+		/// When the resident memory exceeds this limit, expensive parts of
+		/// the decompilation are skipped or downgraded. Zero means three
+		/// quarters of the maximal memory limit (if there is any).
+		uint64_t _maxMemorySoftLimit = 0;
 		uint64_t _timeout = 0;
+		/// Time budgets (in seconds) of the decoding and of the backend
+		/// optimizations. When a budget runs out, the phase is stopped and
+		/// the decompilation continues with what has been done so far.
+		/// Zero means no budget.
+		uint64_t _decoderTimeout = 0;
+		uint64_t _backendOptsTimeout = 0;
 
 		bool _detectStaticCode = true;
 		std::string _backendDisabledOpts;
 		std::string _backendEnabledOpts;
 		std::string _backendCallInfoObtainer = "optim";
 		std::string _backendVarRenamer = "readable";
+		/// Number of threads optimizing functions in the backend in parallel.
+		/// Zero means as many threads as there are CPU cores.
+		uint64_t _backendThreads = 1;
 		bool _backendNoOpts = false;
 		bool _backendEmitCfg = false;
 		bool _backendEmitCg = false;
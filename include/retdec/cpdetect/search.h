@@ -7,6 +7,8 @@
 #ifndef RETDEC_CPDETECT_SEARCH_H
 #define RETDEC_CPDETECT_SEARCH_H
 
+#include <string_view>
+
 #include "retdec/cpdetect/cptypes.h"
 #include "retdec/fileformat/file_format/file_format.h"
 
@@ -41,10 +43,12 @@ class Search
 		};
 	private:
 		retdec::fileformat::FileFormat &parser;
-		/// content of file in hexadecimal string representation
-		std::string nibbles;
-		/// content of file as plain string
-		std::string plain;
+		/// content of file in hexadecimal string representation, created
+		/// only if it differs from the loaded bytes (big endian files) or
+		/// if it is explicitly requested
+		mutable std::string nibbles;
+		/// content of file as plain string (view of loaded bytes)
+		std::string_view plain;
 		/// representation of supported relative jumps
 		std::vector<RelativeJump> jumps;
 		/// average length of one slash representation
@@ -60,6 +64,15 @@ class Search
 		bool haveSlashes() const;
 		std::size_t nibblesFromBytes(std::size_t nBytes) const;
 		std::size_t bytesFromNibbles(std::size_t nNibbles) const;
+		std::size_t getNibblesLength() const;
+		char getNibble(std::size_t index) const;
+		bool hasNibblesOnPosition(
+				const std::string &str,
+				std::size_t position) const;
+		bool findNibblesInContent(
+				const std::string &signPattern,
+				std::size_t startNibble,
+				std::size_t stopNibble) const;
 		/// @}
 	public:
 		Search(retdec::fileformat::FileFormat &fileParser);
@@ -73,7 +86,7 @@ class Search
 		/// @name Getters
 		/// @{
 		const std::string& getNibbles() const;
-		const std::string& getPlainString() const;
+		std::string_view getPlainString() const;
 		/// @}
 
 		/// @name Jump methods
@@ -47,6 +47,24 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::vector<unsigned char> *loadedBytes; ///< reference to serialized content of input file
 		LoadFlags loadFlags;                     ///< load flags for configurable file loading
 
+		/**
+		 * Continuous range [start, end) of offsets or addresses which belongs
+		 * to the single section or segment. Ranges in an index are disjoint
+		 * and sorted by their start.
+		 */
+		struct RegionIndexEntry
+		{
+			std::uint64_t start;
+			std::uint64_t end;
+			const SecSeg *region;
+		};
+
+		bool hasRegionIndex;                                  ///< are the indexes below built?
+		std::vector<RegionIndexEntry> sectionOffsetIndex;     ///< sections by file offsets
+		std::vector<RegionIndexEntry> segmentOffsetIndex;     ///< segments by file offsets
+		std::vector<RegionIndexEntry> sectionAddressIndex;    ///< sections by addresses
+		std::vector<RegionIndexEntry> segmentAddressIndex;    ///< segments by addresses
+
 		/// @name Initialization methods
 		/// @{
 		void init();
@@ -100,6 +118,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		/// @name Protected detection methods
 		/// @{
 		void computeSectionTableHashes();
+		void indexSectionsAndSegments();
 		/// @}
 
 		/// @name Setters
@@ -122,8 +141,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 				retdec::common::Address entryPoint = retdec::common::Address::Undefined,
 				retdec::common::Address sectionVMA = retdec::common::Address::Undefined);
 		void loadStrings();
-		void loadStrings(StringType type, std::size_t charSize);
-		void loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg);
+		void loadStrings(const SecSeg* secSeg);
 		void loadImpHash();
 		void loadExpHash();
 		void loadResourceIconHash();
@@ -7,11 +7,14 @@
 #ifndef RETDEC_FILEFORMAT_FILE_FORMAT_PE_PE_FORMAT_H
 #define RETDEC_FILEFORMAT_FILE_FORMAT_PE_PE_FORMAT_H
 
+#include <mutex>
+
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/fileformat/file_format/pe/pe_format_parser.h"
 #include "retdec/fileformat/types/dotnet_headers/blob_stream.h"
 #include "retdec/fileformat/types/dotnet_headers/guid_stream.h"
 #include "retdec/fileformat/types/dotnet_headers/metadata_stream.h"
+#include "retdec/fileformat/types/dotnet_headers/metadata_tables.h"
 #include "retdec/fileformat/types/dotnet_headers/string_stream.h"
 #include "retdec/fileformat/types/dotnet_headers/user_string_stream.h"
 #include "retdec/fileformat/types/dotnet_types/dotnet_class.h"
@@ -38,8 +41,10 @@ class PeFormat : public FileFormat
 		std::unique_ptr<UserStringStream> userStringStream;        ///< .NET user string stream
 		std::string moduleVersionId;                               ///< .NET module version ID
 		std::string typeLibId;                                     ///< .NET type lib ID
-		std::vector<std::shared_ptr<DotnetClass>> definedClasses;  ///< .NET defined class list
-		std::vector<std::shared_ptr<DotnetClass>> importedClasses; ///< .NET imported class list
+		mutable std::vector<std::shared_ptr<DotnetClass>> definedClasses;  ///< .NET defined class list
+		mutable std::vector<std::shared_ptr<DotnetClass>> importedClasses; ///< .NET imported class list
+		mutable bool dotnetTypesReconstructed = false;                     ///< @c true if .NET classes were reconstructed
+		mutable std::mutex dotnetTypesMutex;                               ///< guards lazy reconstruction of .NET classes
 		std::string typeRefHashCrc32;                              ///< .NET typeref table hash as CRC32
 		std::string typeRefHashMd5;                                ///< .NET typeref table hash as MD5
 		std::string typeRefHashSha256;                             ///< .NET typeref table hash as SHA256
@@ -86,10 +91,11 @@ class PeFormat : public FileFormat
 		void parseGuidStream(std::uint64_t baseAddress, std::uint64_t offset, std::uint64_t size);
 		void parseStringStream(std::uint64_t baseAddress, std::uint64_t offset, std::uint64_t size);
 		void parseUserStringStream(std::uint64_t baseAddress, std::uint64_t offset, std::uint64_t size);
-		template <typename T> void parseMetadataTable(BaseMetadataTable* table, std::uint64_t& address);
+		template <typename T> void parseMetadataTable(BaseMetadataTable* table, MetadataTableReader& reader, std::uint64_t& address);
 		void detectModuleVersionId();
 		void detectTypeLibId();
 		void detectDotnetTypes();
+		void reconstructDotnetTypes() const;
 		std::uint64_t detectPossibleMetadataHeaderAddress() const;
 		void computeTypeRefHashes();
 		/// @}
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <unordered_map>
 
+#include "retdec/fileformat/types/dotnet_headers/signature_reader.h"
 #include "retdec/fileformat/types/dotnet_headers/stream.h"
 
 namespace retdec {
@@ -19,10 +20,13 @@ class BlobStream : public Stream
 {
 	private:
 		std::vector<std::uint8_t> data;
+
+		bool findElement(std::size_t offset, std::size_t& dataOffset, std::size_t& dataSize) const;
 	public:
 		BlobStream(std::vector<std::uint8_t> data, std::uint64_t streamOffset, std::uint64_t streamSize);
 
 		std::vector<std::uint8_t> getElement(std::size_t offset) const;
+		SignatureReader getSignature(std::size_t offset) const;
 };
 
 } // namespace fileformat
@@ -9,6 +9,8 @@
 
 #include <cstdint>
 #include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/fileformat/types/dotnet_headers/metadata_stream.h"
@@ -560,6 +562,25 @@ public:
 	virtual const char* what() const noexcept { return "Invalid .NET record"; }
 };
 
+/**
+ * Reader of metadata table records. Records are decoded straight from the
+ * loaded data of the section which contains the metadata stream, data outside
+ * of it are read through the file.
+ */
+class MetadataTableReader
+{
+	private:
+		const FileFormat* file;                                        ///< file with metadata
+		std::uint64_t viewAddress = 0;                                 ///< address of the first byte of view
+		llvm::StringRef view;                                          ///< loaded data of section with metadata
+		std::unordered_map<std::type_index, std::uint32_t> indexSizes; ///< sizes of indexes of each type
+	public:
+		MetadataTableReader(const FileFormat* file, std::uint64_t address);
+
+		bool readUInt(std::uint64_t address, std::uint32_t size, std::uint64_t& result) const;
+		std::uint32_t& getCachedIndexSize(std::type_index indexType);
+};
+
 /**
  * Base record type
  */
@@ -567,33 +588,28 @@ struct BaseRecord
 {
 	virtual ~BaseRecord() = default;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) = 0;
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) = 0;
 
 protected:
 	template <typename T>
-	T loadUInt(const FileFormat* file, std::uint64_t& address);
+	T loadUInt(MetadataTableReader& reader, std::uint64_t& address);
 
 	template <typename T>
 	std::uint32_t getIndexSize(const MetadataStream* stream);
 
 	template <typename T>
-	T loadIndex(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address)
+	T loadIndex(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address)
 	{
-		std::uint64_t val;
-		if (getIndexSize<T>(stream) == 2)
-		{
-			if (!file->get2Byte(address, val))
-				throw InvalidDotnetRecordError();
+		// Sizes of indexes depend only on sizes of tables, which are known before any record is loaded
+		auto& indexSize = reader.getCachedIndexSize(typeid(T));
+		if (indexSize == 0)
+			indexSize = getIndexSize<T>(stream);
 
-			address += 2;
-		}
-		else
-		{
-			if (!file->get4Byte(address, val))
-				throw InvalidDotnetRecordError();
+		std::uint64_t val;
+		if (!reader.readUInt(address, indexSize, val))
+			throw InvalidDotnetRecordError();
 
-			address += 4;
-		}
+		address += indexSize;
 
 		T index;
 		index.setIndex(val);
@@ -601,9 +617,9 @@ protected:
 	}
 };
 
-template <> std::uint8_t BaseRecord::loadUInt<std::uint8_t>(const FileFormat* file, std::uint64_t& address);
-template <> std::uint16_t BaseRecord::loadUInt<std::uint16_t>(const FileFormat* file, std::uint64_t& address);
-template <> std::uint32_t BaseRecord::loadUInt<std::uint32_t>(const FileFormat* file, std::uint64_t& address);
+template <> std::uint8_t BaseRecord::loadUInt<std::uint8_t>(MetadataTableReader& reader, std::uint64_t& address);
+template <> std::uint16_t BaseRecord::loadUInt<std::uint16_t>(MetadataTableReader& reader, std::uint64_t& address);
+template <> std::uint32_t BaseRecord::loadUInt<std::uint32_t>(MetadataTableReader& reader, std::uint64_t& address);
 
 struct DotnetModule : public BaseRecord
 {
@@ -613,13 +629,13 @@ struct DotnetModule : public BaseRecord
 	GuidStreamIndex encId;
 	GuidStreamIndex encBaseId;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		generation = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		mvId = loadIndex<GuidStreamIndex>(file, stream, address);
-		encId = loadIndex<GuidStreamIndex>(file, stream, address);
-		encBaseId = loadIndex<GuidStreamIndex>(file, stream, address);
+		generation = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		mvId = loadIndex<GuidStreamIndex>(reader, stream, address);
+		encId = loadIndex<GuidStreamIndex>(reader, stream, address);
+		encBaseId = loadIndex<GuidStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -629,11 +645,11 @@ struct TypeRef : public BaseRecord
 	StringStreamIndex typeName;
 	StringStreamIndex typeNamespace;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		resolutionScope = loadIndex<ResolutionScope>(file, stream, address);
-		typeName = loadIndex<StringStreamIndex>(file, stream, address);
-		typeNamespace = loadIndex<StringStreamIndex>(file, stream, address);
+		resolutionScope = loadIndex<ResolutionScope>(reader, stream, address);
+		typeName = loadIndex<StringStreamIndex>(reader, stream, address);
+		typeNamespace = loadIndex<StringStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -661,14 +677,14 @@ struct TypeDef : public BaseRecord
 	bool hasAnsiName() const { return (flags & TypeStringFormatMask) == TypeAnsiClass; }
 	bool hasUnicodeName() const { return (flags & TypeStringFormatMask) == TypeUnicodeClass; }
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint32_t>(file, address);
-		typeName = loadIndex<StringStreamIndex>(file, stream, address);
-		typeNamespace = loadIndex<StringStreamIndex>(file, stream, address);
-		extends = loadIndex<TypeDefOrRef>(file, stream, address);
-		fieldList = loadIndex<FieldTableIndex>(file, stream, address);
-		methodList = loadIndex<MethodDefTableIndex>(file, stream, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		typeName = loadIndex<StringStreamIndex>(reader, stream, address);
+		typeNamespace = loadIndex<StringStreamIndex>(reader, stream, address);
+		extends = loadIndex<TypeDefOrRef>(reader, stream, address);
+		fieldList = loadIndex<FieldTableIndex>(reader, stream, address);
+		methodList = loadIndex<MethodDefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -676,9 +692,9 @@ struct FieldPtr : public BaseRecord
 {
 	FieldTableIndex field;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		field = loadIndex<FieldTableIndex>(file, stream, address);
+		field = loadIndex<FieldTableIndex>(reader, stream, address);
 	}
 };
 
@@ -696,11 +712,11 @@ struct Field : public BaseRecord
 	bool isFamAndAssem() const { return (flags & FieldAccessMask) == FieldFamANDAssem; }
 	bool isStatic() const { return flags & FieldStatic; }
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		signature = loadIndex<BlobStreamIndex>(file, stream, address);
+		flags = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		signature = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -708,9 +724,9 @@ struct MethodPtr : public BaseRecord
 {
 	MethodDefTableIndex method;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		method = loadIndex<MethodDefTableIndex>(file, stream, address);
+		method = loadIndex<MethodDefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -735,14 +751,14 @@ struct MethodDef : public BaseRecord
 	bool isFinal() const { return flags & MethodFinal; }
 	bool isAbstract() const { return flags & MethodAbstract; }
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		rva = loadUInt<std::uint32_t>(file, address);
-		implFlags = loadUInt<std::uint16_t>(file, address);
-		flags = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		signature = loadIndex<BlobStreamIndex>(file, stream, address);
-		paramList = loadIndex<ParamTableIndex>(file, stream, address);
+		rva = loadUInt<std::uint32_t>(reader, address);
+		implFlags = loadUInt<std::uint16_t>(reader, address);
+		flags = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		signature = loadIndex<BlobStreamIndex>(reader, stream, address);
+		paramList = loadIndex<ParamTableIndex>(reader, stream, address);
 	}
 };
 
@@ -750,9 +766,9 @@ struct ParamPtr : public BaseRecord
 {
 	ParamTableIndex param;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		param = loadIndex<ParamTableIndex>(file, stream, address);
+		param = loadIndex<ParamTableIndex>(reader, stream, address);
 	}
 };
 
@@ -764,11 +780,11 @@ struct Param : public BaseRecord
 
 	bool isOut() const { return flags & ParamOut; }
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint16_t>(file, address);
-		sequence = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
+		flags = loadUInt<std::uint16_t>(reader, address);
+		sequence = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -777,10 +793,10 @@ struct InterfaceImpl : public BaseRecord
 	TypeDefTableIndex classType;
 	TypeDefOrRef interfaceType;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		classType = loadIndex<TypeDefTableIndex>(file, stream, address);
-		interfaceType = loadIndex<TypeDefOrRef>(file, stream, address);
+		classType = loadIndex<TypeDefTableIndex>(reader, stream, address);
+		interfaceType = loadIndex<TypeDefOrRef>(reader, stream, address);
 	}
 };
 
@@ -790,11 +806,11 @@ struct MemberRef : public BaseRecord
 	StringStreamIndex name;
 	BlobStreamIndex signature;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		classType = loadIndex<MemberRefParent>(file, stream, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		signature = loadIndex<BlobStreamIndex>(file, stream, address);
+		classType = loadIndex<MemberRefParent>(reader, stream, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		signature = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -804,12 +820,12 @@ struct Constant : public BaseRecord
 	HasConstant parent;
 	BlobStreamIndex value;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		type = loadUInt<std::uint8_t>(file, address);
+		type = loadUInt<std::uint8_t>(reader, address);
 		address += 1; // 1-byte always 0 padding
-		parent = loadIndex<HasConstant>(file, stream, address);
-		value = loadIndex<BlobStreamIndex>(file, stream, address);
+		parent = loadIndex<HasConstant>(reader, stream, address);
+		value = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -819,11 +835,11 @@ struct CustomAttribute : public BaseRecord
 	CustomAttributeType type;
 	BlobStreamIndex value;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		parent = loadIndex<HasCustomAttribute>(file, stream, address);
-		type = loadIndex<CustomAttributeType>(file, stream, address);
-		value = loadIndex<BlobStreamIndex>(file, stream, address);
+		parent = loadIndex<HasCustomAttribute>(reader, stream, address);
+		type = loadIndex<CustomAttributeType>(reader, stream, address);
+		value = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -832,10 +848,10 @@ struct FieldMarshal : public BaseRecord
 	HasFieldMarshal parent;
 	BlobStreamIndex nativeType;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		parent = loadIndex<HasFieldMarshal>(file, stream, address);
-		nativeType = loadIndex<BlobStreamIndex>(file, stream, address);
+		parent = loadIndex<HasFieldMarshal>(reader, stream, address);
+		nativeType = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -845,11 +861,11 @@ struct DeclSecurity : public BaseRecord
 	HasDeclSecurity parent;
 	BlobStreamIndex permissionSet;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		action = loadUInt<std::uint16_t>(file, address);
-		parent = loadIndex<HasDeclSecurity>(file, stream, address);
-		permissionSet = loadIndex<BlobStreamIndex>(file, stream, address);
+		action = loadUInt<std::uint16_t>(reader, address);
+		parent = loadIndex<HasDeclSecurity>(reader, stream, address);
+		permissionSet = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -859,11 +875,11 @@ struct ClassLayout : public BaseRecord
 	std::uint32_t classSize;
 	TypeDefTableIndex parent;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		packingSize = loadUInt<std::uint16_t>(file, address);
-		classSize = loadUInt<std::uint32_t>(file, address);
-		parent = loadIndex<TypeDefTableIndex>(file, stream, address);
+		packingSize = loadUInt<std::uint16_t>(reader, address);
+		classSize = loadUInt<std::uint32_t>(reader, address);
+		parent = loadIndex<TypeDefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -872,10 +888,10 @@ struct FieldLayout : public BaseRecord
 	std::uint32_t offset;
 	FieldTableIndex field;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		offset = loadUInt<std::uint32_t>(file, address);
-		field = loadIndex<FieldTableIndex>(file, stream, address);
+		offset = loadUInt<std::uint32_t>(reader, address);
+		field = loadIndex<FieldTableIndex>(reader, stream, address);
 	}
 };
 
@@ -883,9 +899,9 @@ struct StandAloneSig : public BaseRecord
 {
 	BlobStreamIndex signature;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		signature = loadIndex<BlobStreamIndex>(file, stream, address);
+		signature = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -894,10 +910,10 @@ struct EventMap : public BaseRecord
 	TypeDefTableIndex parent;
 	EventTableIndex eventList;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		parent = loadIndex<TypeDefTableIndex>(file, stream, address);
-		eventList = loadIndex<EventTableIndex>(file, stream, address);
+		parent = loadIndex<TypeDefTableIndex>(reader, stream, address);
+		eventList = loadIndex<EventTableIndex>(reader, stream, address);
 	}
 };
 
@@ -907,11 +923,11 @@ struct Event : public BaseRecord
 	StringStreamIndex name;
 	TypeDefOrRef eventType;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		eventFlags = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		eventType = loadIndex<TypeDefOrRef>(file, stream, address);
+		eventFlags = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		eventType = loadIndex<TypeDefOrRef>(reader, stream, address);
 	}
 };
 
@@ -919,9 +935,9 @@ struct PropertyPtr : public BaseRecord
 {
 	PropertyTableIndex property;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		property = loadIndex<PropertyTableIndex>(file, stream, address);
+		property = loadIndex<PropertyTableIndex>(reader, stream, address);
 	}
 };
 
@@ -930,10 +946,10 @@ struct PropertyMap : public BaseRecord
 	TypeDefTableIndex parent;
 	PropertyTableIndex propertyList;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		parent = loadIndex<TypeDefTableIndex>(file, stream, address);
-		propertyList = loadIndex<PropertyTableIndex>(file, stream, address);
+		parent = loadIndex<TypeDefTableIndex>(reader, stream, address);
+		propertyList = loadIndex<PropertyTableIndex>(reader, stream, address);
 	}
 };
 
@@ -943,11 +959,11 @@ struct Property : public BaseRecord
 	StringStreamIndex name;
 	BlobStreamIndex type;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint16_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		type = loadIndex<BlobStreamIndex>(file, stream, address);
+		flags = loadUInt<std::uint16_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		type = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -957,11 +973,11 @@ struct MethodSemantics : public BaseRecord
 	MethodDefTableIndex method;
 	HasSemantics association;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		semantics = loadUInt<std::uint16_t>(file, address);
-		method = loadIndex<MethodDefTableIndex>(file, stream, address);
-		association = loadIndex<HasSemantics>(file, stream, address);
+		semantics = loadUInt<std::uint16_t>(reader, address);
+		method = loadIndex<MethodDefTableIndex>(reader, stream, address);
+		association = loadIndex<HasSemantics>(reader, stream, address);
 	}
 };
 
@@ -971,11 +987,11 @@ struct MethodImpl : public BaseRecord
 	MethodDefOrRef methodBody;
 	MethodDefOrRef methodDeclaration;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		classType = loadIndex<TypeDefTableIndex>(file, stream, address);
-		methodBody = loadIndex<MethodDefOrRef>(file, stream, address);
-		methodDeclaration = loadIndex<MethodDefOrRef>(file, stream, address);
+		classType = loadIndex<TypeDefTableIndex>(reader, stream, address);
+		methodBody = loadIndex<MethodDefOrRef>(reader, stream, address);
+		methodDeclaration = loadIndex<MethodDefOrRef>(reader, stream, address);
 	}
 };
 
@@ -983,9 +999,9 @@ struct ModuleRef : public BaseRecord
 {
 	StringStreamIndex name;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		name = loadIndex<StringStreamIndex>(file, stream, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -993,9 +1009,9 @@ struct TypeSpec : public BaseRecord
 {
 	BlobStreamIndex signature;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		signature = loadIndex<BlobStreamIndex>(file, stream, address);
+		signature = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1006,12 +1022,12 @@ struct ImplMap : public BaseRecord
 	StringStreamIndex importName;
 	ModuleRefTableIndex importScope;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		mappingFlags = loadUInt<std::uint16_t>(file, address);
-		memberForwarded = loadIndex<MemberForwarded>(file, stream, address);
-		importName = loadIndex<StringStreamIndex>(file, stream, address);
-		importScope = loadIndex<ModuleRefTableIndex>(file, stream, address);
+		mappingFlags = loadUInt<std::uint16_t>(reader, address);
+		memberForwarded = loadIndex<MemberForwarded>(reader, stream, address);
+		importName = loadIndex<StringStreamIndex>(reader, stream, address);
+		importScope = loadIndex<ModuleRefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -1020,10 +1036,10 @@ struct FieldRVA : public BaseRecord
 	std::uint32_t rva;
 	FieldTableIndex field;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		rva = loadUInt<std::uint32_t>(file, address);
-		field = loadIndex<FieldTableIndex>(file, stream, address);
+		rva = loadUInt<std::uint32_t>(reader, address);
+		field = loadIndex<FieldTableIndex>(reader, stream, address);
 	}
 };
 
@@ -1032,10 +1048,10 @@ struct ENCLog : public BaseRecord
 	std::uint32_t token;
 	std::uint32_t funcCode;
 
-	virtual void load(const FileFormat* file, const MetadataStream*, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream*, std::uint64_t& address) override
 	{
-		token = loadUInt<std::uint32_t>(file, address);
-		funcCode = loadUInt<std::uint32_t>(file, address);
+		token = loadUInt<std::uint32_t>(reader, address);
+		funcCode = loadUInt<std::uint32_t>(reader, address);
 	}
 };
 
@@ -1043,9 +1059,9 @@ struct ENCMap : public BaseRecord
 {
 	std::uint32_t token;
 
-	virtual void load(const FileFormat* file, const MetadataStream*, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream*, std::uint64_t& address) override
 	{
-		token = loadUInt<std::uint32_t>(file, address);
+		token = loadUInt<std::uint32_t>(reader, address);
 	}
 };
 
@@ -1061,17 +1077,17 @@ struct Assembly : public BaseRecord
 	StringStreamIndex name;
 	StringStreamIndex culture;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		hashAlgId = loadUInt<std::uint32_t>(file, address);
-		majorVersion = loadUInt<std::uint16_t>(file, address);
-		minorVersion = loadUInt<std::uint16_t>(file, address);
-		buildNumber = loadUInt<std::uint16_t>(file, address);
-		revisionNumber = loadUInt<std::uint16_t>(file, address);
-		flags = loadUInt<std::uint32_t>(file, address);
-		publicKey = loadIndex<BlobStreamIndex>(file, stream, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		culture = loadIndex<StringStreamIndex>(file, stream, address);
+		hashAlgId = loadUInt<std::uint32_t>(reader, address);
+		majorVersion = loadUInt<std::uint16_t>(reader, address);
+		minorVersion = loadUInt<std::uint16_t>(reader, address);
+		buildNumber = loadUInt<std::uint16_t>(reader, address);
+		revisionNumber = loadUInt<std::uint16_t>(reader, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		publicKey = loadIndex<BlobStreamIndex>(reader, stream, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		culture = loadIndex<StringStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1079,9 +1095,9 @@ struct AssemblyProcessor : public BaseRecord
 {
 	std::uint32_t processor;
 
-	virtual void load(const FileFormat* file, const MetadataStream*, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream*, std::uint64_t& address) override
 	{
-		processor = loadUInt<std::uint32_t>(file, address);
+		processor = loadUInt<std::uint32_t>(reader, address);
 	}
 };
 
@@ -1091,11 +1107,11 @@ struct AssemblyOS : public BaseRecord
 	std::uint32_t osMajorVersion;
 	std::uint32_t osMinorVersion;
 
-	virtual void load(const FileFormat* file, const MetadataStream*, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream*, std::uint64_t& address) override
 	{
-		osPlatformId = loadUInt<std::uint32_t>(file, address);
-		osMajorVersion = loadUInt<std::uint32_t>(file, address);
-		osMinorVersion = loadUInt<std::uint32_t>(file, address);
+		osPlatformId = loadUInt<std::uint32_t>(reader, address);
+		osMajorVersion = loadUInt<std::uint32_t>(reader, address);
+		osMinorVersion = loadUInt<std::uint32_t>(reader, address);
 	}
 };
 
@@ -1111,17 +1127,17 @@ struct AssemblyRef : public BaseRecord
 	StringStreamIndex culture;
 	BlobStreamIndex hashValue;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		majorVersion = loadUInt<std::uint16_t>(file, address);
-		minorVersion = loadUInt<std::uint16_t>(file, address);
-		buildNumber = loadUInt<std::uint16_t>(file, address);
-		revisionNumber = loadUInt<std::uint16_t>(file, address);
-		flags = loadUInt<std::uint32_t>(file, address);
-		publicKeyOrToken = loadIndex<BlobStreamIndex>(file, stream, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		culture = loadIndex<StringStreamIndex>(file, stream, address);
-		hashValue = loadIndex<BlobStreamIndex>(file, stream, address);
+		majorVersion = loadUInt<std::uint16_t>(reader, address);
+		minorVersion = loadUInt<std::uint16_t>(reader, address);
+		buildNumber = loadUInt<std::uint16_t>(reader, address);
+		revisionNumber = loadUInt<std::uint16_t>(reader, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		publicKeyOrToken = loadIndex<BlobStreamIndex>(reader, stream, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		culture = loadIndex<StringStreamIndex>(reader, stream, address);
+		hashValue = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1130,10 +1146,10 @@ struct AssemblyRefProcessor : public BaseRecord
 	std::uint32_t processor;
 	AssemblyRefTableIndex assemblyRef;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		processor = loadUInt<std::uint32_t>(file, address);
-		assemblyRef = loadIndex<AssemblyRefTableIndex>(file, stream, address);
+		processor = loadUInt<std::uint32_t>(reader, address);
+		assemblyRef = loadIndex<AssemblyRefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -1144,12 +1160,12 @@ struct AssemblyRefOS : public BaseRecord
 	std::uint32_t osMinorVersion;
 	AssemblyRefTableIndex assemblyRef;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		osPlatformId = loadUInt<std::uint32_t>(file, address);
-		osMajorVersion = loadUInt<std::uint32_t>(file, address);
-		osMinorVersion = loadUInt<std::uint32_t>(file, address);
-		assemblyRef = loadIndex<AssemblyRefTableIndex>(file, stream, address);
+		osPlatformId = loadUInt<std::uint32_t>(reader, address);
+		osMajorVersion = loadUInt<std::uint32_t>(reader, address);
+		osMinorVersion = loadUInt<std::uint32_t>(reader, address);
+		assemblyRef = loadIndex<AssemblyRefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -1159,11 +1175,11 @@ struct File : public BaseRecord
 	StringStreamIndex name;
 	BlobStreamIndex hashValue;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint32_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		hashValue = loadIndex<BlobStreamIndex>(file, stream, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		hashValue = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1175,13 +1191,13 @@ struct ExportedType : public BaseRecord
 	StringStreamIndex typeNamespace;
 	Implementation implementation;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		flags = loadUInt<std::uint32_t>(file, address);
-		typeDefId = loadUInt<std::uint32_t>(file, address);
-		typeName = loadIndex<StringStreamIndex>(file, stream, address);
-		typeNamespace = loadIndex<StringStreamIndex>(file, stream, address);
-		implementation = loadIndex<Implementation>(file, stream, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		typeDefId = loadUInt<std::uint32_t>(reader, address);
+		typeName = loadIndex<StringStreamIndex>(reader, stream, address);
+		typeNamespace = loadIndex<StringStreamIndex>(reader, stream, address);
+		implementation = loadIndex<Implementation>(reader, stream, address);
 	}
 };
 
@@ -1192,12 +1208,12 @@ struct ManifestResource : public BaseRecord
 	StringStreamIndex name;
 	Implementation implementation;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		offset = loadUInt<std::uint32_t>(file, address);
-		flags = loadUInt<std::uint32_t>(file, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
-		implementation = loadIndex<Implementation>(file, stream, address);
+		offset = loadUInt<std::uint32_t>(reader, address);
+		flags = loadUInt<std::uint32_t>(reader, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
+		implementation = loadIndex<Implementation>(reader, stream, address);
 	}
 };
 
@@ -1206,10 +1222,10 @@ struct NestedClass : public BaseRecord
 	TypeDefTableIndex nestedClass;
 	TypeDefTableIndex enclosingClass;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		nestedClass = loadIndex<TypeDefTableIndex>(file, stream, address);
-		enclosingClass = loadIndex<TypeDefTableIndex>(file, stream, address);
+		nestedClass = loadIndex<TypeDefTableIndex>(reader, stream, address);
+		enclosingClass = loadIndex<TypeDefTableIndex>(reader, stream, address);
 	}
 };
 
@@ -1220,12 +1236,12 @@ struct GenericParam : public BaseRecord
 	TypeDefOrMethodDef owner;
 	StringStreamIndex name;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		number = loadUInt<std::uint16_t>(file, address);
-		flags = loadUInt<std::uint16_t>(file, address);
-		owner = loadIndex<TypeDefOrMethodDef>(file, stream, address);
-		name = loadIndex<StringStreamIndex>(file, stream, address);
+		number = loadUInt<std::uint16_t>(reader, address);
+		flags = loadUInt<std::uint16_t>(reader, address);
+		owner = loadIndex<TypeDefOrMethodDef>(reader, stream, address);
+		name = loadIndex<StringStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1234,10 +1250,10 @@ struct MethodSpec : public BaseRecord
 	MethodDefOrRef method;
 	BlobStreamIndex instantiation;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		method = loadIndex<MethodDefOrRef>(file, stream, address);
-		instantiation = loadIndex<BlobStreamIndex>(file, stream, address);
+		method = loadIndex<MethodDefOrRef>(reader, stream, address);
+		instantiation = loadIndex<BlobStreamIndex>(reader, stream, address);
 	}
 };
 
@@ -1246,10 +1262,10 @@ struct GenericParamContstraint : public BaseRecord
 	GenericParamTableIndex owner;
 	TypeDefOrRef constraint;
 
-	virtual void load(const FileFormat* file, const MetadataStream* stream, std::uint64_t& address) override
+	virtual void load(MetadataTableReader& reader, const MetadataStream* stream, std::uint64_t& address) override
 	{
-		owner = loadIndex<GenericParamTableIndex>(file, stream, address);
-		constraint = loadIndex<TypeDefOrRef>(file, stream, address);
+		owner = loadIndex<GenericParamTableIndex>(reader, stream, address);
+		constraint = loadIndex<TypeDefOrRef>(reader, stream, address);
 	}
 };
 
@@ -0,0 +1,43 @@
+/**
+ * @file include/retdec/fileformat/types/dotnet_headers/signature_reader.h
+ * @brief Class for reading .NET signatures.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_SIGNATURE_READER_H
+#define RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_SIGNATURE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Sequential reader of signature in the \#Blob stream. It refers to the data
+ * of the stream, so it is cheap to copy, and it must not outlive the stream.
+ */
+class SignatureReader
+{
+	private:
+		const std::uint8_t *data = nullptr; ///< signature data
+		std::size_t size = 0;               ///< size of signature data
+		std::size_t position = 0;           ///< position of the next byte to read
+	public:
+		SignatureReader() = default;
+		SignatureReader(const std::uint8_t *data, std::size_t size);
+
+		bool isEmpty() const;
+		std::size_t getRemainingSize() const;
+		std::uint8_t peekByte() const;
+
+		bool skip(std::size_t count);
+		bool readByte(std::uint8_t &result);
+		bool readUnsigned(std::uint64_t &result);
+		bool readSigned(std::int64_t &result);
+};
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
@@ -22,7 +22,7 @@ class DotnetTypeReconstructor
 		using ClassTable = std::map<std::size_t, std::shared_ptr<DotnetClass>>;
 		using ClassToMethodTable = std::unordered_map<const DotnetClass*, std::vector<std::unique_ptr<DotnetMethod>>>;
 		using MethodTable = std::map<std::size_t, DotnetMethod*>;
-		using SignatureTable = std::map<const DotnetMethod*, std::vector<std::uint8_t>>;
+		using SignatureTable = std::map<const DotnetMethod*, SignatureReader>;
 
 		DotnetTypeReconstructor(const MetadataStream* metadata, const StringStream* strings, const BlobStream* blob);
 
@@ -50,17 +50,17 @@ class DotnetTypeReconstructor
 		std::unique_ptr<DotnetField> createField(const Field* field, const DotnetClass* ownerClass);
 		std::unique_ptr<DotnetProperty> createProperty(const Property* property, const DotnetClass* ownerClass);
 		std::unique_ptr<DotnetMethod> createMethod(const MethodDef* methodDef, const DotnetClass* ownerClass);
-		std::unique_ptr<DotnetParameter> createMethodParameter(std::size_t paramIdx, std::size_t startIdx, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod, std::vector<std::uint8_t>& signature);
+		std::unique_ptr<DotnetParameter> createMethodParameter(std::size_t paramIdx, std::size_t startIdx, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod, SignatureReader& signature);
 
-		template <typename T> std::unique_ptr<T> createDataTypeFollowedByReference(std::vector<std::uint8_t>& data);
-		template <typename T> std::unique_ptr<T> createDataTypeFollowedByType(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
-		template <typename T, typename U> std::unique_ptr<T> createGenericReference(std::vector<std::uint8_t>& data, const U* owner);
-		std::unique_ptr<DotnetDataTypeGenericInst> createGenericInstantiation(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
-		std::unique_ptr<DotnetDataTypeArray> createArray(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
-		template <typename T> std::unique_ptr<T> createModifier(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
-		std::unique_ptr<DotnetDataTypeFnPtr> createFnPtr(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		template <typename T> std::unique_ptr<T> createDataTypeFollowedByReference(SignatureReader& data);
+		template <typename T> std::unique_ptr<T> createDataTypeFollowedByType(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		template <typename T, typename U> std::unique_ptr<T> createGenericReference(SignatureReader& data, const U* owner);
+		std::unique_ptr<DotnetDataTypeGenericInst> createGenericInstantiation(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		std::unique_ptr<DotnetDataTypeArray> createArray(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		template <typename T> std::unique_ptr<T> createModifier(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		std::unique_ptr<DotnetDataTypeFnPtr> createFnPtr(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
 
-		std::unique_ptr<DotnetDataTypeBase> dataTypeFromSignature(std::vector<std::uint8_t>& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
+		std::unique_ptr<DotnetDataTypeBase> dataTypeFromSignature(SignatureReader& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod);
 
 		const DotnetClass* selectClass(const TypeDefOrRef& typeDefOrRef) const;
 
@@ -7,6 +7,9 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_EXPORT_TABLE_EXPORT_TABLE_H
 #define RETDEC_FILEFORMAT_TYPES_EXPORT_TABLE_EXPORT_TABLE_H
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "retdec/fileformat/types/export_table/export.h"
@@ -25,6 +28,18 @@ class ExportTable
 		std::string expHashCrc32;                   ///< exphash CRC32
 		std::string expHashMd5;                     ///< exphash MD5
 		std::string expHashSha256;                  ///< exphash SHA256
+
+		/// @name Lookup indexes, they map keys to the first matching export
+		/// @{
+		mutable std::unordered_map<std::string, std::size_t> exportsByName;
+		mutable std::unordered_map<unsigned long long, std::size_t> exportsByAddress;
+		mutable std::unordered_map<std::uint64_t, std::size_t> exportsByOrdinal;
+		mutable std::atomic<bool> indexesValid{false};
+		mutable std::mutex indexesMutex;
+		/// @}
+
+		void indexExport(std::size_t exportIndex) const;
+		void buildIndexes() const;
 	public:
 		/// @name Getters
 		/// @{
@@ -34,6 +49,7 @@ class ExportTable
 		const std::string& getExphashSha256() const;
 		const Export* getExport(std::size_t exportIndex) const;
 		const Export* getExport(const std::string &name) const;
+		const Export* getExportByOrdinal(std::uint64_t ordinalNumber) const;
 		const Export* getExportOnAddress(unsigned long long address) const;
 		/// @}
 
@@ -7,7 +7,10 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_IMPORT_TABLE_IMPORT_TABLE_H
 #define RETDEC_FILEFORMAT_TYPES_IMPORT_TABLE_IMPORT_TABLE_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "retdec/fileformat/types/import_table/import.h"
@@ -29,6 +32,29 @@ class ImportTable
 		std::string impHashMd5;                       ///< imphash MD5
 		std::string impHashSha256;                    ///< imphash SHA256
 		std::string impHashTlsh;
+	private:
+		/**
+		 * Hash of the pair of library index and ordinal number.
+		 */
+		struct LibraryOrdinalHash
+		{
+			std::size_t operator()(const std::pair<std::uint64_t, std::uint64_t> &key) const
+			{
+				return std::hash<std::uint64_t>()(key.first * 0x9E3779B97F4A7C15ULL ^ key.second);
+			}
+		};
+
+		/// @name Lookup indexes, they map keys to the first matching import
+		/// @{
+		mutable std::unordered_map<std::string, std::size_t> importsByName;
+		mutable std::unordered_map<unsigned long long, std::size_t> importsByAddress;
+		mutable std::unordered_map<std::pair<std::uint64_t, std::uint64_t>, std::size_t, LibraryOrdinalHash> importsByOrdinal;
+		mutable std::atomic<bool> indexesValid{false};
+		mutable std::mutex indexesMutex;
+		/// @}
+
+		void indexImport(std::size_t importIndex) const;
+		void buildIndexes() const;
 	public:
 		/// @name Getters
 		/// @{
@@ -46,6 +72,7 @@ class ImportTable
 		std::string getLibrary(std::size_t libraryIndex) const;
 		const Import* getImport(std::size_t importIndex) const;
 		const Import* getImport(const std::string &name) const;
+		const Import* getImport(const std::string &libraryName, std::uint64_t ordinalNumber) const;
 		const Import* getImportOnAddress(unsigned long long address) const;
 		/// @}
 
@@ -0,0 +1,39 @@
+/**
+ * @file include/retdec/fileformat/types/strings/string_scanner.h
+ * @brief Detection of strings in raw data.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+#define RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "retdec/fileformat/types/strings/string.h"
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Position of a string in the scanned data. It refers to the data, so the
+ * content of the string is extracted only when it is needed.
+ */
+struct StringRange
+{
+	StringType type;     ///< type of the string
+	std::size_t offset;  ///< offset of the first byte of the string in the data
+	std::size_t length;  ///< number of characters of the string
+};
+
+std::vector<StringRange> findStrings(const std::uint8_t *data, std::size_t size,
+		std::size_t minLength, bool bigEndian);
+std::string getStringContent(const std::uint8_t *data, const StringRange &range,
+		bool bigEndian);
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
@@ -17,6 +17,8 @@ std::string getCrc32(const unsigned char *data, std::uint64_t length);
 std::string getMd5(const unsigned char *data, std::uint64_t length);
 std::string getSha1(const unsigned char *data, std::uint64_t length);
 std::string getSha256(const unsigned char *data, std::uint64_t length);
+void getCrc32Md5Sha256(const unsigned char *data, std::uint64_t length,
+		std::string &crc32, std::string &md5, std::string &sha256);
 
 } // namespace fileformat
 } // namespace retdec
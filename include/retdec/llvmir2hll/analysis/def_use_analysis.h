@@ -31,6 +31,9 @@ class Variable;
 *
 * See the description of DefUseAnalysis for more info (mainly concerning the
 * book that this implementation is based on: [ItC]).
+*
+* The @c gen, @c kill, @c in, and @c out sets are needed only to compute @c du.
+* DefUseAnalysis::updateDefUseChains() updates just @c du and clears them.
 */
 class DefUseChains {
 public:
@@ -117,6 +120,7 @@ public:
 		std::function<bool (ShPtr<Variable>)> shouldBeIncluded =
 			[](auto) { return true; }
 	);
+	void updateDefUseChains(ShPtr<DefUseChains> ducs, const VarSet &vars);
 
 	static ShPtr<DefUseAnalysis> create(ShPtr<Module> module,
 		ShPtr<ValueAnalysis> va, ShPtr<VarUsesVisitor> vuv = nullptr);
@@ -71,6 +71,8 @@ class UseDefAnalysis: private retdec::utils::NonCopyable {
 public:
 	ShPtr<UseDefChains> getUseDefChains(ShPtr<Function> func,
 		ShPtr<DefUseChains> ducs);
+	void updateUseDefChains(ShPtr<UseDefChains> udcs,
+		ShPtr<DefUseChains> ducs, const VarSet &vars);
 
 	static ShPtr<UseDefAnalysis> create(ShPtr<Module> module);
 
@@ -73,9 +73,11 @@
 #include "retdec/llvmir2hll/var_name_gen/var_name_gens/num_var_name_gen.h"
 #include "retdec/llvmir2hll/var_renamer/var_renamer.h"
 #include "retdec/llvmir2hll/var_renamer/var_renamer_factory.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/pass_profiler.h"
 #include "retdec/utils/string.h"
 
 #ifndef RETDEC_LLVMIR2HLL_LLVMIR2HLL_H
@@ -110,6 +112,8 @@ public:
 
 	void setConfig(retdec::config::Config* c);
 	void setOutputString(std::string* outString);
+	void setPassProfiler(retdec::utils::PassProfiler* profiler);
+	void setCancellationToken(const retdec::utils::CancellationToken* token);
 
 private:
 	bool initialize(llvm::Module &m);
@@ -138,6 +142,7 @@ private:
 
 	llvmir2hll::StringSet parseListOfOpts(
 			const std::string &opts) const;
+	unsigned getNumOfBackendThreads() const;
 	llvmir2hll::StringVector getIdsOfPatternFindersToBeRun() const;
 	llvmir2hll::PatternFinderRunner::PatternFinders instantiatePatternFinders(
 		const llvmir2hll::StringVector &pfsIds);
@@ -180,6 +185,12 @@ private:
 
 	/// Output string stream.
 	std::unique_ptr<llvm::raw_string_ostream> outStringStream;
+
+	/// Profiler of the optimizations (may be null).
+	retdec::utils::PassProfiler* passProfiler = nullptr;
+
+	/// When cancelled, the remaining optimizations are skipped (may be null).
+	const retdec::utils::CancellationToken* cancellation = nullptr;
 };
 
 } // namespace llvmir2hll
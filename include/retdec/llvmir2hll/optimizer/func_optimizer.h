@@ -7,6 +7,8 @@
 #ifndef RETDEC_LLVMIR2HLL_OPTIMIZER_FUNC_OPTIMIZER_H
 #define RETDEC_LLVMIR2HLL_OPTIMIZER_FUNC_OPTIMIZER_H
 
+#include <vector>
+
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 
@@ -38,10 +40,18 @@ class Module;
 *
 * The functions are not optimized in any particular order. Optimizations for a
 * single function should not affect optimizations of other functions.
+* Optimizers for which this holds strictly (see canBeRunInParallel()) may be
+* run over several functions at once by optimizeInParallel().
 *
 * Instances of this class have reference object semantics.
 */
 class FuncOptimizer: public Optimizer {
+public:
+	virtual bool canBeRunInParallel() const;
+
+	static void optimizeInParallel(
+		const std::vector<ShPtr<FuncOptimizer>> &optimizers);
+
 protected:
 	FuncOptimizer(ShPtr<Module> module);
 
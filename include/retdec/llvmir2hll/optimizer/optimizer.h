@@ -11,6 +11,7 @@
 
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/visitors/ordered_all_visitor.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/non_copyable.h"
 
 namespace retdec {
@@ -50,6 +51,9 @@ public:
 	virtual std::string getId() const = 0;
 
 	ShPtr<Module> optimize();
+	ShPtr<Module> getModule() const;
+
+	void setCancellationToken(const retdec::utils::CancellationToken *token);
 
 	/**
 	* @brief Creates an instance of OptimizerType with the given arguments and
@@ -74,9 +78,15 @@ protected:
 	virtual void doOptimization();
 	virtual void doFinalization();
 
+	bool isCancelled() const;
+
 protected:
 	/// The module that is being optimized.
 	ShPtr<Module> module;
+
+	/// When cancelled, the optimization should stop as soon as it can leave
+	/// the module in a consistent state (may be null).
+	const retdec::utils::CancellationToken *cancellation;
 };
 
 } // namespace llvmir2hll
@@ -7,16 +7,21 @@
 #ifndef RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 #define RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 
+#include <vector>
+
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/types.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/non_copyable.h"
+#include "retdec/utils/pass_profiler.h"
 
 namespace retdec {
 namespace llvmir2hll {
 
 class ArithmExprEvaluator;
 class CallInfoObtainer;
+class FuncOptimizer;
 class HLLWriter;
 class Module;
 class ValueAnalysis;
@@ -32,14 +37,21 @@ public:
 	OptimizerManager(const StringSet &enabledOpts, const StringSet &disabledOpts,
 		ShPtr<HLLWriter> hllWriter, ShPtr<ValueAnalysis> va,
 		ShPtr<CallInfoObtainer> cio, ShPtr<ArithmExprEvaluator> arithmExprEvaluator,
-		bool enableDebug = false);
+		bool enableDebug = false, unsigned numOfThreads = 1,
+		retdec::utils::PassProfiler *profiler = nullptr,
+		const retdec::utils::CancellationToken *cancellation = nullptr);
 
 	void optimize(ShPtr<Module> m);
 
 private:
 	void printOptimization(const std::string &optName) const;
 	bool optShouldBeRun(const std::string &optName) const;
-	void runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer);
+	void runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer,
+		const std::vector<ShPtr<FuncOptimizer>> &parallelOptimizers = {});
+	void runOptimizer(ShPtr<Optimizer> optimizer,
+		const std::vector<ShPtr<FuncOptimizer>> &parallelOptimizers);
+	void saveMemory();
+	bool isCancelled();
 	bool shouldSecondCopyPropagationBeRun() const;
 
 	template<typename Optimization, typename... Args>
@@ -67,6 +79,18 @@ private:
 	/// Enable emission of debug messages?
 	bool enableDebug;
 
+	/// Maximal number of threads optimizing functions in parallel.
+	unsigned numOfThreads;
+
+	/// Profiler of the run optimizations (may be null).
+	retdec::utils::PassProfiler *profiler;
+
+	/// When cancelled, no further optimizations are run (may be null).
+	const retdec::utils::CancellationToken *cancellation;
+
+	/// Has the cancellation already been reported?
+	bool cancellationReported;
+
 	/// Should we recover from out-of-memory errors during optimizations?
 	bool recoverFromOutOfMemory;
 
@@ -50,6 +50,7 @@ public:
 	BreakContinueReturnOptimizer(ShPtr<Module> module);
 
 	virtual std::string getId() const override { return "BreakContinueReturn"; }
+	virtual bool canBeRunInParallel() const override { return true; }
 
 private:
 	/// @name Visitor Interface
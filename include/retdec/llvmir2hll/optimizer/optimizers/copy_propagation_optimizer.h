@@ -78,6 +78,8 @@ private:
 	/// @}
 
 	void performOptimization();
+	void computeChangedVars();
+	void addVarsInStmtToChangedVars(ShPtr<Statement> stmt);
 	bool stmtOrUseHasBeenModified(ShPtr<Statement> stmt, const StmtSet &uses) const;
 	void handleCaseEmptyUses(ShPtr<Statement> stmt, ShPtr<Variable> stmtLhsVar);
 	void handleCaseSingleUse(ShPtr<Statement> stmt, ShPtr<Variable> stmtLhsVar,
@@ -140,6 +142,10 @@ private:
 	/// Set of statements that have been modified (altered or removed).
 	StmtSet modifiedStmts;
 
+	/// Variables whose def-use and use-def chains have to be updated after
+	/// the statements in @c modifiedStmts have been modified.
+	VarSet changedVars;
+
 	/// Has the code changed?
 	bool codeChanged;
 };
@@ -34,6 +34,7 @@ public:
 	DerefAddressOptimizer(ShPtr<Module> module);
 
 	virtual std::string getId() const override { return "DerefAddress"; }
+	virtual bool canBeRunInParallel() const override { return true; }
 
 private:
 	/// @name Visitor Interface
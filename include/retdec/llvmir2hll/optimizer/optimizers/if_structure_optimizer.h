@@ -135,6 +135,7 @@ public:
 	IfStructureOptimizer(ShPtr<Module> module);
 
 	virtual std::string getId() const override { return "IfStructure"; }
+	virtual bool canBeRunInParallel() const override { return true; }
 
 private:
 	/// @name Visitor Interface
@@ -52,6 +52,7 @@ public:
 	LoopLastContinueOptimizer(ShPtr<Module> module);
 
 	virtual std::string getId() const override { return "LoopLastContinue"; }
+	virtual bool canBeRunInParallel() const override { return true; }
 
 private:
 	/// @name Visitor Interface
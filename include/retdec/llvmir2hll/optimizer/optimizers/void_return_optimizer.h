@@ -37,6 +37,7 @@ public:
 	VoidReturnOptimizer(ShPtr<Module> module);
 
 	virtual std::string getId() const override { return "VoidReturn"; }
+	virtual bool canBeRunInParallel() const override { return true; }
 
 private:
 	/// @name Visitor Interface
@@ -8,6 +8,8 @@
 #define RETDEC_LLVMIR2HLL_SUPPORT_SUBJECT_H
 
 #include <algorithm>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 #include "retdec/llvmir2hll/support/smart_ptr.h"
@@ -37,6 +39,9 @@ namespace llvmir2hll {
 * };
 * @endcode
 *
+* Adding, removing, and notifying observers is thread-safe so that functions
+* sharing subjects (e.g. global variables) can be optimized in parallel.
+*
 * @see Observer
 */
 template<typename SubjectType, typename ArgType = SubjectType>
@@ -89,6 +94,7 @@ public:
 	* @param[in] observer Observer to be added.
 	*/
 	void addObserver(ObserverPtr observer) {
+		std::lock_guard<std::mutex> lock(getObserversMutex());
 		observers.push_back(observer);
 	}
 
@@ -105,6 +111,7 @@ public:
 	* @brief Removes all observers.
 	*/
 	void removeObservers() {
+		std::lock_guard<std::mutex> lock(getObserversMutex());
 		observers.clear();
 	}
 
@@ -125,7 +132,12 @@ public:
 	void notifyObservers(ShPtr<ArgType> arg = nullptr) {
 		// We have to iterate over a copy of the container because it can be
 		// modified during the iteration (either by us or in an update() call).
-		for (const auto &observer : ObserverContainer(observers)) {
+		ObserverContainer observersCopy;
+		{
+			std::lock_guard<std::mutex> lock(getObserversMutex());
+			observersCopy = observers;
+		}
+		for (const auto &observer : observersCopy) {
 			notifyObserverOrRemoveItIfNotExists(observer, arg);
 		}
 	}
@@ -189,6 +201,7 @@ private:
 	* @brief Removes the given observer and all the non-existing observers.
 	*/
 	void removeObserverAndNonExistingObservers(ObserverPtr observer) {
+		std::lock_guard<std::mutex> lock(getObserversMutex());
 		observers.erase(std::remove_if(observers.begin(), observers.end(),
 			[&observer](const auto &other) {
 				return other.expired() || observer.lock() == other.lock();
@@ -196,7 +209,22 @@ private:
 		));
 	}
 
+	/**
+	* @brief Returns the mutex guarding the list of observers.
+	*
+	* Subjects share a small pool of mutexes instead of having one each
+	* because there are lots of them.
+	*/
+	std::mutex &getObserversMutex() const {
+		static std::mutex mutexes[ObserversMutexCount];
+		auto address = reinterpret_cast<std::uintptr_t>(this);
+		return mutexes[(address / alignof(Subject)) % ObserversMutexCount];
+	}
+
 private:
+	/// Number of mutexes guarding lists of observers.
+	static constexpr std::size_t ObserversMutexCount = 64;
+
 	/// Container to store observers.
 	ObserverContainer observers;
 };
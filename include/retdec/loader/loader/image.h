@@ -7,7 +7,9 @@
 #ifndef RETDEC_LOADER_RETDEC_LOADER_IMAGE_H
 #define RETDEC_LOADER_RETDEC_LOADER_IMAGE_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include "retdec/utils/byte_value_storage.h"
 #include "retdec/fileformat/fftypes.h"
@@ -80,10 +82,24 @@ protected:
 	void removeSegment(Segment* segment);
 	void nameSegment(Segment* segment);
 	void sortSegments();
+	void invalidateSegmentIndex();
 
 	void setStatusMessage(const std::string& message);
 
 private:
+	/**
+	 * Continuous address range [start, end) which belongs to the single segment.
+	 * Ranges in the index are disjoint and sorted by their start address.
+	 */
+	struct SegmentIndexEntry
+	{
+		std::uint64_t start;
+		std::uint64_t end;
+		const Segment* segment;
+	};
+
+	void _buildSegmentIndex() const;
+
 	const Segment* _getSegment(std::size_t index) const;
 	const Segment* _getSegment(const std::string& name) const;
 	const Segment* _getSegmentWithIndex(std::size_t index) const;
@@ -94,6 +110,11 @@ private:
 	std::uint64_t _baseAddress;
 	NameGenerator _namelessSegNameGen;
 	std::string _statusMessage;
+
+	mutable std::vector<SegmentIndexEntry> _segmentIndex;
+	mutable std::atomic<std::size_t> _segmentIndexLastHit;
+	mutable std::atomic<bool> _segmentIndexValid;
+	mutable std::mutex _segmentIndexMutex;
 };
 
 } // namespace loader
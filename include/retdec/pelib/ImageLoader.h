@@ -110,18 +110,45 @@ struct PELIB_FILE_PAGE
 		return true;
 	}
 
+	// Initializes the page with a full page of valid data. To save memory, the data are not copied.
+	// The page only refers to them until it is written to, so they must outlive the page.
+	bool setFileBackedPage(const std::uint8_t * data)
+	{
+		buffer.clear();
+		fileData = data;
+		isInvalidPage = false;
+		isZeroPage = false;
+		return true;
+	}
+
 	// Initializes the page as zero page. To save memory, we won't initialize buffer
 	void setZeroPage()
 	{
 		buffer.clear();
+		fileData = nullptr;
 		isInvalidPage = false;
 		isZeroPage = true;
 	}
 
+	// Returns the page data (PELIB_PAGE_SIZE bytes) or nullptr if the page has no data
+	const std::uint8_t * data() const
+	{
+		if(fileData != nullptr)
+			return fileData;
+		return buffer.empty() ? nullptr : buffer.data();
+	}
+
 	void writeToPage(const void * data, size_t offset, size_t length)
 	{
 		if(offset < PELIB_PAGE_SIZE)
 		{
+			// Make a private copy of a file-backed page before writing to it
+			if(fileData != nullptr)
+			{
+				buffer.assign(fileData, fileData + PELIB_PAGE_SIZE);
+				fileData = nullptr;
+			}
+
 			// Make sure that there is buffer allocated
 			if(buffer.size() != PELIB_PAGE_SIZE)
 				buffer.resize(PELIB_PAGE_SIZE);
@@ -133,7 +160,8 @@ struct PELIB_FILE_PAGE
 		}
 	}
 
-	ByteBuffer buffer;                    // A page-sized buffer, holding one image page. Empty if isInvalidPage
+	ByteBuffer buffer;                    // A page-sized buffer, holding one image page. Empty if isInvalidPage or file-backed
+	const std::uint8_t * fileData = nullptr; // Page data in the loaded file content if the page is file-backed
 	bool isInvalidPage;                   // For invalid pages within image (SectionAlignment > 0x1000)
 	bool isZeroPage;                      // For sections with VirtualSize != 0, RawSize = 0
 };
@@ -147,6 +175,15 @@ class ImageLoader
 
 	ImageLoader(std::uint32_t loaderFlags = 0);
 
+	// Pages may point into streamFileData. A copy would point into the buffer of the original,
+	// so the loader can't be copied. Moving keeps the buffer, and thus the pointers, valid.
+	ImageLoader(const ImageLoader &) = delete;
+	ImageLoader & operator=(const ImageLoader &) = delete;
+	ImageLoader(ImageLoader &&) = default;
+	ImageLoader & operator=(ImageLoader &&) = default;
+
+	// Note that pages of the mapped image may refer directly to the fileData,
+	// which therefore must not be changed or destroyed while the image is in use.
 	int Load(ByteBuffer & fileData, bool loadHeadersOnly = false);
 	int Load(std::istream & fs, std::streamoff fileOffset = 0, bool loadHeadersOnly = false);
 	int Load(const char * fileName, bool loadHeadersOnly = false);
@@ -482,6 +519,7 @@ class ImageLoader
 	PELIB_IMAGE_FILE_HEADER fileHeader;                 // Loaded NT file header
 	PELIB_IMAGE_OPTIONAL_HEADER optionalHeader;         // 32/64-bit optional header
 	ByteBuffer rawFileData;                             // Loaded content of the image in case it couldn't have been mapped
+	ByteBuffer streamFileData;                          // Content of the file loaded from a stream, pages may refer to it
 	LoaderError ldrError;
 	std::uint64_t savedFileSize;                        // Size of the raw file
 	std::uint32_t windowsBuildNumber;
@@ -15,24 +15,108 @@
 #include "retdec/common/function.h"
 #include "retdec/config/config.h"
 
+namespace llvm {
+
+class OptPassGate;
+
+} // namespace llvm
+
 namespace retdec {
 
+namespace fileformat {
+
+class FileFormat;
+
+} // namespace fileformat
+
+namespace utils {
+
+class CancellationToken;
+
+} // namespace utils
+
 struct LlvmModuleContextPair
 {
 	LlvmModuleContextPair(LlvmModuleContextPair&&) = default;
-	~LlvmModuleContextPair()
-	{
-		// Order matters: module destructor uses context.
-		module.reset();
-		context.reset();
-	}
+	~LlvmModuleContextPair();
+
 	std::unique_ptr<llvm::Module> module;
 	std::unique_ptr<llvm::LLVMContext> context;
 };
 
+/**
+ * A single decompilation job.
+ *
+ * Session owns its own LLVM context and module, and all the data bin2llvmir
+ * providers create for the job are associated with this module and released
+ * when the session is destroyed. Therefore, several sessions can be created
+ * and run in parallel (each one in its own thread) in one process.
+ *
+ * Logging (\c retdec::utils::io::Log) is process-global and it is not
+ * (re)configured by the session.
+ */
+class DecompilationSession
+{
+	public:
+		/**
+		 * \param config    Decompilation configuration. It must outlive
+		 *                  the session.
+		 * \param outString If set, decompilation output is returned in this
+		 *                  string. Otherwise, output file is expected to be
+		 *                  set in \p config.
+		 */
+		DecompilationSession(
+				retdec::config::Config& config,
+				std::string* outString = nullptr
+		);
+		~DecompilationSession();
+
+		DecompilationSession(const DecompilationSession&) = delete;
+		DecompilationSession& operator=(const DecompilationSession&) = delete;
+
+		/**
+		 * Use already parsed input file \p inputFile instead of parsing
+		 * the input file from the configuration again. Its content is
+		 * then shared by all the decompilation phases.
+		 */
+		void setInputFile(
+				const std::shared_ptr<retdec::fileformat::FileFormat>& inputFile
+		);
+
+		/**
+		 * When \p cancellation gets cancelled, the decoding and all the
+		 * optional passes and optimizations stop, and the output is produced
+		 * from what has been decompiled so far. The token must outlive the
+		 * session.
+		 */
+		void setCancellationToken(
+				const retdec::utils::CancellationToken* cancellation
+		);
+
+		/**
+		 * Run the decompilation.
+		 * \return Exit code of the decompilation, \c EXIT_SUCCESS if it
+		 *         succeeded.
+		 */
+		int run();
+
+		llvm::Module* getModule() const;
+
+	private:
+		retdec::config::Config& _config;
+		std::string* _outString = nullptr;
+		std::shared_ptr<retdec::fileformat::FileFormat> _inputFile;
+		const retdec::utils::CancellationToken* _cancellation = nullptr;
+		std::unique_ptr<llvm::OptPassGate> _passGate;
+		std::unique_ptr<llvm::LLVMContext> _context;
+		std::unique_ptr<llvm::Module> _module;
+};
+
 /**
  * \param[in]  inputPath Path the the input file to disassemble.
- * \param[out] fs        Set of functions to fill.
+ * \param[out] fs        Set of functions to fill. Capstone instructions in
+ *                       its basic blocks are valid as long as the returned
+ *                       module exists.
  * \return Pointer to LLVM module created by the disassembly,
  *         or \c nullptr if the disassembly failed.
  */
@@ -45,10 +129,23 @@ LlvmModuleContextPair disassemble(
  * Run a decompilation according to a \p config configuration.
  * If \p outString is set, decompilation output will be returned
  * in this string. Otherwise, output file is expected to be set in \p config.
+ *
+ * If \p inputFile is set, it is used instead of parsing the input file
+ * from \p config again.
+ *
+ * If \p cancellation is set, the decompilation stops early when it gets
+ * cancelled (see \c DecompilationSession::setCancellationToken()).
+ *
+ * Logging is set up from \p config parameters. Use \c DecompilationSession
+ * directly to run several decompilations at the same time.
+ *
+ * \return Exit code of the decompilation, \c EXIT_SUCCESS if it succeeded.
  */
-bool decompile(
+int decompile(
 		retdec::config::Config& config,
-		std::string* outString = nullptr
+		std::string* outString = nullptr,
+		const std::shared_ptr<retdec::fileformat::FileFormat>& inputFile = nullptr,
+		const retdec::utils::CancellationToken* cancellation = nullptr
 );
 
 } // namespace retdec
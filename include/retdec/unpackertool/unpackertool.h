@@ -8,9 +8,27 @@
 #define RETDEC_UNPACKERTOOL_UNPACKERTOOL_H
 
 namespace retdec {
+
+namespace fileformat {
+
+class FileFormat;
+
+} // namespace fileformat
+
 namespace unpackertool {
 
-int _main(int argc, char** argv);
+/**
+ * Run unpacker with the given program arguments.
+ * \param argc      Number of arguments.
+ * \param argv      Arguments.
+ * \param inputFile Optional already parsed input file. If it was created from
+ *                  the same path as the input file in \p argv, it is used
+ *                  for packer detection instead of parsing the file again.
+ */
+int _main(
+		int argc,
+		char** argv,
+		retdec::fileformat::FileFormat* inputFile = nullptr);
 
 } // namespace unpackertool
 } // namespace retdec
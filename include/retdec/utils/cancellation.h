@@ -0,0 +1,59 @@
+/**
+* @file include/retdec/utils/cancellation.h
+* @brief Cooperative cancellation of long-running work.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_CANCELLATION_H
+#define RETDEC_UTILS_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Cooperative cancellation of long-running work.
+*
+* Work that supports cancellation checks @c isCancelled() at suitable points
+* and stops cleanly once it returns @c true. A token is cancelled explicitly
+* by @c cancel(), when its deadline passes, or when its parent token is
+* cancelled. A child token can therefore be used to give a part of the work
+* its own (shorter) time budget.
+*
+* All the methods are thread-safe, so a token may be cancelled from a
+* different thread than the one doing the work.
+*/
+class CancellationToken {
+public:
+	using Clock = std::chrono::steady_clock;
+
+public:
+	explicit CancellationToken(const CancellationToken *parent = nullptr);
+
+	CancellationToken(const CancellationToken &) = delete;
+	CancellationToken &operator=(const CancellationToken &) = delete;
+
+	void cancel();
+	void setDeadline(Clock::time_point deadline);
+	void setTimeout(Clock::duration timeout);
+	bool hasDeadline() const;
+
+	bool isCancelled() const;
+
+private:
+	/// Token whose cancellation also cancels this token (may be null).
+	const CancellationToken *parent = nullptr;
+
+	/// Has the token been cancelled explicitly?
+	std::atomic<bool> cancelled;
+
+	/// Deadline as the number of clock ticks since the epoch of @c Clock.
+	std::atomic<Clock::rep> deadline;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
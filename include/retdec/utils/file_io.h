@@ -117,9 +117,27 @@ template <typename N> bool readFile(
 	if (!fileStream.good())
 		return false;
 
-	const bool untilEof = !desiredSize;
+	bool untilEof = !desiredSize;
 	if (untilEof)
-		desiredSize = FILE_BURST_READ_LENGTH;
+	{
+		// If the stream size is known, read the rest of it at once. Reading
+		// by bursts would reallocate (and copy) the result over and over,
+		// which temporarily needs up to twice the memory for large files.
+		auto pos = fileStream.tellg();
+		fileStream.seekg(0, std::ios::end);
+		auto end = fileStream.tellg();
+		fileStream.seekg(start, std::ios::beg);
+		if (!fileStream.good())
+			return false;
+
+		if (pos != std::streampos(-1) && end != std::streampos(-1) && end > pos)
+		{
+			desiredSize = static_cast<std::size_t>(end - pos);
+			untilEof = false;
+		}
+		else
+			desiredSize = FILE_BURST_READ_LENGTH;
+	}
 
 	result.clear();
 	std::size_t alreadyRead = 0;
@@ -16,6 +16,24 @@ std::size_t getTotalSystemMemory();
 bool limitSystemMemory(std::size_t limit);
 bool limitSystemMemoryToHalfOfTotalSystemMemory();
 
+std::size_t getCurrentResidentMemory();
+std::size_t getPeakResidentMemory();
+std::size_t getCurrentVirtualMemory();
+
+/**
+* @brief Kind of memory the soft memory limit is compared with.
+*/
+enum class MemoryKind {
+	Resident, ///< Resident set size (physical memory in use).
+	Virtual   ///< Virtual memory (what is limited by @c limitSystemMemory()).
+};
+
+void setMemorySoftLimit(std::size_t limit,
+	MemoryKind kind = MemoryKind::Resident);
+std::size_t getMemorySoftLimit();
+MemoryKind getMemorySoftLimitKind();
+bool isMemorySoftLimitExceeded();
+
 } // namespace utils
 } // namespace retdec
 
@@ -0,0 +1,25 @@
+/**
+* @file include/retdec/utils/parallel.h
+* @brief Processing of independent items by several threads.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PARALLEL_H
+#define RETDEC_UTILS_PARALLEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace retdec {
+namespace utils {
+
+std::size_t getNumberOfThreads(std::uint64_t configuredThreads);
+
+void parallelFor(std::size_t count, std::size_t threads,
+	const std::function<bool (std::size_t item, std::size_t thread)> &process);
+
+} // namespace utils
+} // namespace retdec
+
+#endif
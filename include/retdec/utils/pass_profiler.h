@@ -0,0 +1,137 @@
+/**
+* @file include/retdec/utils/pass_profiler.h
+* @brief Collection of performance data about passes of the decompilation.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PASS_PROFILER_H
+#define RETDEC_UTILS_PASS_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Size of an intermediate representation.
+*
+* What is counted as a block or an instruction depends on the representation.
+*/
+struct IrSize {
+	std::uint64_t functions = 0;
+	std::uint64_t blocks = 0;
+	std::uint64_t instructions = 0;
+	/// Memory taken by the assembly instructions the IR was translated from
+	/// (in bytes), if they are kept.
+	std::uint64_t asmInstructionsMemory = 0;
+};
+
+/**
+* @brief Resources consumed by a single run of a single pass.
+*
+* Times are in seconds, memory sizes are in bytes.
+*/
+struct PassProfile {
+	/// Part of the decompiler the pass belongs to (e.g. @c bin2llvmir).
+	std::string component;
+	/// Name of the pass.
+	std::string name;
+	/// Number of passes the pass was run in (nested passes have depth > 0).
+	std::size_t depth = 0;
+
+	double wallTime = 0.0;
+	/// Processor time of the whole process, including worker threads started
+	/// by the pass. It is meaningful only if @c ranAlone is @c true.
+	double cpuTime = 0.0;
+	/// Processor time of the thread that ran the pass (work of other threads,
+	/// e.g. worker threads of the pass or threads of other jobs, is not
+	/// included).
+	double threadCpuTime = 0.0;
+	/// Was the pass the only job running in the process during its whole run?
+	/// If not, @c cpuTime includes work of other jobs.
+	bool ranAlone = false;
+
+	/// Resident memory of the whole process before the pass. Memory sizes are
+	/// process-wide, so they include memory of concurrently running jobs.
+	std::size_t residentMemoryBefore = 0;
+	/// Resident memory of the whole process after the pass.
+	std::size_t residentMemoryAfter = 0;
+	/// Peak resident memory of the whole process since its start, as observed
+	/// at the end of the pass.
+	std::size_t peakResidentMemory = 0;
+
+	IrSize irSizeBefore;
+	IrSize irSizeAfter;
+
+	std::int64_t getResidentMemoryDelta() const;
+};
+
+/**
+* @brief Marks a job (e.g. a decompilation) running in the process.
+*
+* Processor time of the whole process is attributed to a pass only if the job
+* the pass belongs to was the only job running in the process during the pass.
+* Create an instance for the lifetime of every job that may run concurrently
+* with other jobs.
+*/
+class RunningJob {
+public:
+	RunningJob();
+	~RunningJob();
+
+	RunningJob(const RunningJob &) = delete;
+	RunningJob &operator=(const RunningJob &) = delete;
+
+	static std::size_t getRunningJobsCount();
+	static std::uint64_t getStartedJobsCount();
+};
+
+/**
+* @brief Measures resources consumed by passes of the decompilation.
+*
+* Every call of @c startPass() has to be paired with a call of @c endPass().
+* Passes may be nested (e.g. optimizations run by a pass), in which case
+* @c endPass() ends the most recently started pass.
+*
+* Instances of this class are not thread-safe.
+*/
+class PassProfiler {
+public:
+	void startPass(const std::string &component, const std::string &name,
+		const IrSize &irSize = IrSize());
+	void endPass(const IrSize &irSize = IrSize());
+	void endAllPasses();
+	bool isPassRunning() const;
+
+	const std::vector<PassProfile> &getProfiles() const;
+
+private:
+	/// A pass that has been started but not ended yet.
+	struct RunningPass {
+		/// Index of the profile of the pass in @c profiles.
+		std::size_t index;
+		std::chrono::steady_clock::time_point wallStart;
+		double cpuStart;
+		double threadCpuStart;
+		/// Number of running jobs when the pass was started.
+		std::size_t runningJobs;
+		/// Number of jobs started before the pass was started.
+		std::uint64_t startedJobs;
+	};
+
+private:
+	/// Profiles of all the passes, in the order they were started.
+	std::vector<PassProfile> profiles;
+
+	/// Stack of the currently running passes.
+	std::vector<RunningPass> running;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,53 @@
+/**
+* @file include/retdec/utils/result_cache.h
+* @brief On-disk cache of results of an analysis of a file.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_RESULT_CACHE_H
+#define RETDEC_UTILS_RESULT_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief On-disk cache of results of an analysis of a file.
+*
+* Every cache entry is identified by a key (typically a hash of the analyzed
+* content and of the options the analysis depends on) and consists of
+* several named artifacts. An entry is stored in a directory named after the
+* key, with one file per artifact.
+*
+* Entries are stored atomically (written into a temporary directory which is
+* then renamed), so several processes can share one cache directory. All
+* errors are ignored, the cache is only an optimization.
+*/
+class ResultCache {
+public:
+	using Artifacts = std::map<std::string, std::string>;
+
+public:
+	explicit ResultCache(const std::string &directory);
+
+	bool isEnabled() const;
+
+	bool load(const std::string &key, Artifacts &artifacts) const;
+	bool store(const std::string &key, const Artifacts &artifacts) const;
+
+	static std::string getFilesStamp(const std::vector<std::string> &paths);
+
+private:
+	std::string getEntryPath(const std::string &key) const;
+
+private:
+	std::string directory;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -22,6 +22,8 @@ std::string timestampToDate(std::time_t timestamp);
 std::string timestampToGmtDatetime(std::time_t timestamp);
 
 double getElapsedTime();
+double getThreadCpuTime();
+double getProcessCpuTime();
 
 } // namespace utils
 } // namespace retdec
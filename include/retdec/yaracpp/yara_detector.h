@@ -7,8 +7,11 @@
 #ifndef RETDEC_YARACPP_YARA_DETECTOR_H
 #define RETDEC_YARACPP_YARA_DETECTOR_H
 
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "retdec/yaracpp/yara_rule.h"
@@ -38,6 +41,11 @@ class YaraDetector
 				std::vector<YaraRule> &storedDetected;
 				/// link to undetected rules
 				std::vector<YaraRule> &storedUndetected;
+				/// rule file the scanned rules come from
+				std::string ruleFile;
+				/// namespace -> rule file of the scanned rules if they come
+				/// from more files
+				const std::map<std::string, std::string> *namespaceFiles = nullptr;
 			public:
 				CallbackSettings(
 						bool cStoreAll,
@@ -50,6 +58,11 @@ class YaraDetector
 				void addDetected(YaraRule &rule);
 				void addUndetected(YaraRule &rule);
 				bool storeAllRules() const;
+				void setRuleFile(const std::string &pathToFile);
+				void setNamespaceFiles(
+						const std::map<std::string, std::string> *files
+				);
+				std::string getRuleFile(const std::string &nameSpace) const;
 				/// @}
 		};
 
@@ -72,20 +85,29 @@ class YaraDetector
 	private:
 		/// compiler or text rules
 		YR_COMPILER *compiler = nullptr;
-		/// representation of files with rules
-		std::vector<FILE*> files;
 		/// representation of detected rules
 		std::vector<YaraRule> detectedRules;
 		/// representation of undetected rules
 		std::vector<YaraRule> undetectedRules;
-		/// rules from input text files
-		YR_RULES* textFilesRules = nullptr;
-		/// rules from precompiled files
-		std::vector<YR_RULES*> precompiledRules;
+		/// rules from text strings
+		YR_RULES* textRules = nullptr;
+		/// text files with rules and their namespaces
+		std::vector<std::pair<std::string, std::string>> textFiles;
+		/// compiler the text files are checked by, it contains the first
+		/// @c compiledTextFiles of them
+		YR_COMPILER *filesCompiler = nullptr;
+		/// number of text files added into @c filesCompiler
+		std::size_t compiledTextFiles = 0;
+		/// rules compiled from all text files, shared with other detectors
+		std::shared_ptr<YR_RULES> textFilesRules;
+		/// namespace -> text file, empty if more files share the namespace
+		std::map<std::string, std::string> textFilesNamespaces;
+		/// precompiled files and their rules, shared with other detectors
+		std::vector<std::pair<std::string, std::shared_ptr<YR_RULES>>> precompiledRules;
 		/// internal state of instance
 		bool stateIsValid = true;
-		/// indicates whether text files need recompilation
-		bool needsRecompilation = true;
+		/// indicates whether text rules need recompilation
+		bool needsRecompilation = false;
 
 		/// @name Static auxiliary methods
 		/// @{
@@ -99,11 +121,16 @@ class YaraDetector
 
 		/// @name Auxiliary detection methods
 		/// @{
-		template <typename T> bool analyzeWithScan(
-				T&& value,
-				bool storeAllRules = false
+		bool analyzeData(
+				const std::uint8_t *data,
+				std::size_t size,
+				bool storeAllRules
 		);
 		YR_RULES* getCompiledRules();
+		bool addToFilesCompiler(
+				const std::vector<std::pair<std::string, std::string>>& files
+		);
+		void destroyFilesCompiler();
 		/// @}
 	public:
 		YaraDetector();
@@ -117,6 +144,7 @@ class YaraDetector
 				const std::string &nameSpace = std::string()
 		);
 		bool isInValidState() const;
+		static void setRulesCacheDirectory(const std::string &dir);
 		/// @}
 
 		/// @name Detection methods
@@ -126,7 +154,7 @@ class YaraDetector
 				bool storeAllRules = false
 		);
 		bool analyze(
-				std::vector<std::uint8_t> &bytes,
+				const std::vector<std::uint8_t> &bytes,
 				bool storeAllRules = false
 		);
 		const std::vector<YaraRule>& getDetectedRules() const;
@@ -23,12 +23,14 @@ class YaraRule
 {
 	private:
 		std::string name;
+		std::string ruleFile;
 		std::vector<YaraMeta> metas;
 		std::vector<YaraMatch> matches;
 	public:
 		/// @name Const getters
 		/// @{
 		const std::string &getName() const;
+		const std::string &getRuleFile() const;
 		const YaraMeta* getMeta(const std::string &id) const;
 		const YaraMatch* getMatch(std::size_t index) const;
 		const YaraMatch* getFirstMatch() const;
@@ -48,6 +50,7 @@ class YaraRule
 		/// @name Setters
 		/// @{
 		void setName(const std::string &ruleName);
+		void setRuleFile(const std::string &pathToFile);
 		/// @}
 
 		/// @name Other methods
@@ -4,21 +4,25 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <iomanip>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
-#include <llvm/ADT/PostOrderIterator.h>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/time.h"
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/names.h"
 #define debug_enabled false
 #include "retdec/bin2llvmir/utils/llvm.h"
@@ -29,12 +33,28 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/**
+ * Modules with fewer instructions than this per thread are analysed by fewer
+ * threads, small modules by just one.
+ */
+const std::size_t MIN_INSTRUCTIONS_PER_THREAD = 20000;
+
+} // anonymous namespace
+
 //
 //=============================================================================
 //  ReachingDefinitionsAnalysis
 //=============================================================================
 //
 
+/**
+ * Analyse all functions of module @a M. Large modules are analysed by up to
+ * the configured number of threads (see Config::getNumberOfThreads()).
+ * If the analysis gets cancelled, functions which were not analysed yet have
+ * no definitions and uses, and wasRun() returns @c false.
+ */
 bool ReachingDefinitionsAnalysis::runOnModule(
 		Module& M,
 		Abi* abi,
@@ -45,8 +65,59 @@ bool ReachingDefinitionsAnalysis::runOnModule(
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(&M);
 
 	clear();
-	initializeBasicBlocks(M);
-	run();
+
+	// All the entries are created before the threads are started, every
+	// thread then modifies only entries of the functions it analyses.
+	//
+	std::vector<std::pair<Function*, FunctionEntry*>> fncs;
+	for (Function& F : M)
+	{
+		fncs.emplace_back(&F, &fncMap[&F]);
+	}
+
+	// Threads do not pay off for small modules.
+	//
+	std::size_t instructions = 0;
+	for (auto& f : fncs)
+	{
+		instructions += f.first->getInstructionCount();
+	}
+	auto* config = ConfigProvider::getConfig(&M);
+	std::size_t threads = std::min(
+			config ? config->getNumberOfThreads() : 1,
+			std::max<std::size_t>(
+					1,
+					instructions / MIN_INSTRUCTIONS_PER_THREAD));
+
+	std::vector<char> analysed(fncs.size(), false);
+	parallelFor(fncs.size(), threads, [&](std::size_t i, std::size_t)
+	{
+		if (config && config->isCancelled())
+		{
+			return false;
+		}
+		run(*fncs[i].first, *fncs[i].second);
+		analysed[i] = true;
+		return true;
+	});
+
+	// Functions which were not analysed because of the cancellation have no
+	// definitions and uses, and the analysis is not marked as run.
+	//
+	if (std::find(analysed.begin(), analysed.end(), false) != analysed.end())
+	{
+		for (std::size_t i = 0; i < fncs.size(); ++i)
+		{
+			if (!analysed[i])
+			{
+				fncMap.erase(fncs[i].first);
+			}
+		}
+		_cancelled = true;
+		return false;
+	}
+
+	LOG << *this << "\n";
 
 	_run = true;
 	return false;
@@ -62,38 +133,36 @@ bool ReachingDefinitionsAnalysis::runOnFunction(
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(F.getParent());
 
 	clear();
-	initializeBasicBlocks(F);
-	run();
-
-	_run = true;
-	return false;
-}
-
-void ReachingDefinitionsAnalysis::run()
-{
-	initializeBasicBlocksPrev();
-	initializeKillGenSets();
-	propagate();
-	initializeDefsAndUses();
+	run(F, fncMap[&F]);
 
 	LOG << *this << "\n";
 
-	clearInternal();
+	_run = true;
+	return false;
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Module& M)
+/**
+ * Compute RDA for function @a F into @a fe.
+ * This touches only @a fe, so it can run for several functions at once.
+ */
+void ReachingDefinitionsAnalysis::run(llvm::Function& F, FunctionEntry& fe)
 {
-	for (Function& F : M)
-	{
-		initializeBasicBlocks(F);
-	}
+	initializeBasicBlocks(F, fe);
+	fe.initializeBasicBlocksPrev();
+	fe.initializeKillGenSets();
+	fe.propagate();
+	fe.initializeDefsAndUses();
+	fe.clearInternal();
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
+void ReachingDefinitionsAnalysis::initializeBasicBlocks(
+		llvm::Function& F,
+		FunctionEntry& fe)
 {
+	fe.bbs.reserve(F.size());
 	for (BasicBlock& B : F)
 	{
-		BasicBlockEntry bbe(&B, bbMap.size());
+		BasicBlockEntry bbe(&B, fe.bbs.size());
 
 		int insnPos = -1;
 		for (Instruction& I : B)
@@ -200,14 +269,16 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 			}
 		}
 
-		bbMap[&F][&B] = bbe;
+		auto& entry = fe.bbMap[&B] = std::move(bbe);
+		fe.bbs.push_back(&entry);
 	}
 }
 
 void ReachingDefinitionsAnalysis::clear()
 {
-	bbMap.clear();
+	fncMap.clear();
 	_run = false;
+	_cancelled = false;
 }
 
 bool ReachingDefinitionsAnalysis::wasRun() const
@@ -215,93 +286,190 @@ bool ReachingDefinitionsAnalysis::wasRun() const
 	return _run;
 }
 
-/**
- * Clear internal structures used to compute RDA, but not needed to use it once
- * it is computed.
- */
-void ReachingDefinitionsAnalysis::clearInternal()
+const BasicBlockEntry& ReachingDefinitionsAnalysis::getBasicBlockEntry(
+		const Instruction* I) const
 {
-	for (auto& pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	auto* F = I->getFunction();
+	auto pair1 = fncMap.find(F);
+	if (pair1 == fncMap.end() && _cancelled)
 	{
-		BasicBlockEntry& bb = pair.second;
-		bb.defsOut.clear();
-		bb.genDefs.clear();
-		bb.killDefs.clear();
+		static const BasicBlockEntry emptyEntry;
+		return emptyEntry;
 	}
+	assert(pair1 != fncMap.end() && "we do not have this function in fncMap");
+
+	auto* BB = I->getParent();
+	auto pair = pair1->second.bbMap.find(BB);
+	assert(pair != pair1->second.bbMap.end() && "we do not have this basic block in bbMap");
+
+	return pair->second;
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev()
+const DefSet& ReachingDefinitionsAnalysis::defsFromUse(const Instruction* I) const
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	return getBasicBlockEntry(I).defsFromUse(I);
+}
+
+const UseSet& ReachingDefinitionsAnalysis::usesFromDef(const Instruction* I) const
+{
+	return getBasicBlockEntry(I).usesFromDef(I);
+}
+
+const Definition* ReachingDefinitionsAnalysis::getDef(const Instruction* I) const
+{
+	return getBasicBlockEntry(I).getDef(I);
+}
+
+const Use* ReachingDefinitionsAnalysis::getUse(const Instruction* I) const
+{
+	return getBasicBlockEntry(I).getUse(I);
+}
+
+std::ostream& operator<<(std::ostream& out, const ReachingDefinitionsAnalysis& rda)
+{
+	for (auto &pair1 : rda.fncMap)
+	for (auto* bbe : pair1.second.bbs)
+	{
+		out << *bbe;
+	}
+	return out;
+}
+
+//
+//=============================================================================
+//  FunctionEntry
+//=============================================================================
+//
+
+void FunctionEntry::initializeBasicBlocksPrev()
+{
+	for (auto* entry : bbs)
 	{
-		auto B = pair.first;
-		auto &entry = pair.second;
+		auto B = entry->bb;
 
 		for (auto PI = pred_begin(B), E = pred_end(B); PI != E; ++PI)
 		{
 			auto* pred = *PI;
-			auto p = pair1.second.find(pred);
+			auto p = bbMap.find(pred);
 
-			assert(p != pair1.second.end() && "we should have all BBs stored in bbMap");
+			assert(p != bbMap.end() && "we should have all BBs stored in bbMap");
 
-			entry.prevBBs.insert( &p->second );
+			entry->prevBBs.insert( &p->second );
+			p->second.nextBBs.push_back(entry);
 		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeKillGenSets()
+/**
+ * Number all the definitions and initialize KILL and GEN sets of all BBs.
+ */
+void FunctionEntry::initializeKillGenSets()
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto* bbe : bbs)
+	for (Definition& d : bbe->defs)
 	{
-		pair.second.initializeKillDefSets();
+		d.id = defs.size();
+		defs.push_back(&d);
+		valueDefs[d.getSource()].ids.push_back(d.id);
+	}
+
+	// Resetting bits one by one is faster than resetting the whole bit
+	// vector only if there are less definitions than (64-bit) bit vector
+	// words.
+	//
+	std::size_t words = (defs.size() + 63) / 64;
+	for (auto& vd : valueDefs)
+	{
+		if (vd.second.ids.size() > words)
+		{
+			vd.second.mask.resize(defs.size());
+			for (auto id : vd.second.ids)
+			{
+				vd.second.mask.set(id);
+			}
+		}
+	}
+
+	for (auto* bbe : bbs)
+	{
+		bbe->initializeKillGenSets(*this);
 	}
 }
 
-void ReachingDefinitionsAnalysis::propagate()
+/**
+ * Iterate over BBs until defsOut of all of them are stable. Only successors of
+ * BBs whose defsOut changed are visited again. BBs unreachable from the entry
+ * BB are not visited at all, nothing reaches them and they reach nothing.
+ */
+void FunctionEntry::propagate()
 {
-	for (auto &pair1 : bbMap)
+	for (auto* bbe : bbs)
+	{
+		bbe->defsOut.resize(defs.size());
+	}
+	if (bbs.empty())
 	{
-		const Function* fnc = pair1.first;
+		return;
+	}
 
-		std::vector<BasicBlockEntry*> workList;
-		workList.reserve(pair1.second.size());
-		ReversePostOrderTraversal<const Function*> RPOT(fnc); // Expensive to create
-		for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
+	// Find reachable BBs, they are visited in the order they are in the
+	// function.
+	//
+	std::vector<BasicBlockEntry*> stack = {bbs.front()};
+	bbs.front()->inWorkList = true;
+	while (!stack.empty())
+	{
+		auto* bbe = stack.back();
+		stack.pop_back();
+		for (auto* next : bbe->nextBBs)
 		{
-			const BasicBlock* bb = *I;
-			auto fIt = pair1.second.find(bb);
-			assert(fIt != pair1.second.end());
-			workList.push_back(&(fIt->second));
-
-			fIt->second.changed = true;
+			if (!next->inWorkList)
+			{
+				next->inWorkList = true;
+				stack.push_back(next);
+			}
 		}
-
-		bool changed = true;
-		while (changed)
+	}
+	std::deque<BasicBlockEntry*> workList;
+	for (auto* bbe : bbs)
+	{
+		if (bbe->inWorkList)
 		{
-			changed = false;
+			workList.push_back(bbe);
+		}
+	}
 
-			for (auto* bbe : workList)
+	llvm::BitVector tmp(defs.size());
+	while (!workList.empty())
+	{
+		auto* bbe = workList.front();
+		workList.pop_front();
+		bbe->inWorkList = false;
+
+		if (bbe->initDefsOut(tmp))
+		{
+			for (auto* next : bbe->nextBBs)
 			{
-				changed |= bbe->initDefsOut();
+				if (!next->inWorkList)
+				{
+					next->inWorkList = true;
+					workList.push_back(next);
+				}
 			}
 		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeDefsAndUses()
+void FunctionEntry::initializeDefsAndUses()
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	llvm::BitVector defsIn;
+	for (auto* bbe : bbs)
 	{
-		BasicBlockEntry &bb = pair.second;
+		bool defsInComputed = false;
 
-		for (Use &u : bb.uses)
+		for (Use &u : bbe->uses)
 		{
-			for (auto dIt = bb.defs.rbegin(); dIt != bb.defs.rend(); ++dIt)
+			for (auto dIt = bbe->defs.rbegin(); dIt != bbe->defs.rend(); ++dIt)
 			{
 				Definition &d = *dIt;
 
@@ -320,13 +488,24 @@ void ReachingDefinitionsAnalysis::initializeDefsAndUses()
 
 			if (u.defs.empty())
 			{
-				for (auto p : bb.prevBBs)
-				for (auto d : p->defsOut)
+				auto vdIt = valueDefs.find(u.src);
+				if (vdIt == valueDefs.end())
+				{
+					continue;
+				}
+
+				if (!defsInComputed)
+				{
+					bbe->computeDefsIn(defsIn);
+					defsInComputed = true;
+				}
+
+				for (auto id : vdIt->second.ids)
 				{
-					if (d->getSource() == u.src)
+					if (defsIn.test(id))
 					{
-						d->uses.insert(&u);
-						u.defs.insert(d);
+						defs[id]->uses.insert(&u);
+						u.defs.insert(defs[id]);
 					}
 				}
 			}
@@ -334,48 +513,21 @@ void ReachingDefinitionsAnalysis::initializeDefsAndUses()
 	}
 }
 
-const BasicBlockEntry& ReachingDefinitionsAnalysis::getBasicBlockEntry(
-		const Instruction* I) const
-{
-	auto* F = I->getFunction();
-	auto pair1 = bbMap.find(F);
-	assert(pair1 != bbMap.end() && "we do not have this function in bbMap");
-
-	auto* BB = I->getParent();
-	auto pair = pair1->second.find(BB);
-	assert(pair != pair1->second.end() && "we do not have this basic block in bbMap");
-
-	return pair->second;
-}
-
-const DefSet& ReachingDefinitionsAnalysis::defsFromUse(const Instruction* I) const
-{
-	return getBasicBlockEntry(I).defsFromUse(I);
-}
-
-const UseSet& ReachingDefinitionsAnalysis::usesFromDef(const Instruction* I) const
-{
-	return getBasicBlockEntry(I).usesFromDef(I);
-}
-
-const Definition* ReachingDefinitionsAnalysis::getDef(const Instruction* I) const
-{
-	return getBasicBlockEntry(I).getDef(I);
-}
-
-const Use* ReachingDefinitionsAnalysis::getUse(const Instruction* I) const
-{
-	return getBasicBlockEntry(I).getUse(I);
-}
-
-std::ostream& operator<<(std::ostream& out, const ReachingDefinitionsAnalysis& rda)
+/**
+ * Clear internal structures used to compute RDA, but not needed to use it once
+ * it is computed.
+ */
+void FunctionEntry::clearInternal()
 {
-	for (auto &pair1 : rda.bbMap)
-	for (auto& pair : pair1.second)
+	for (auto* bbe : bbs)
 	{
-		out << pair.second;
+		bbe->defsOut.clear();
+		bbe->genDefs.clear();
+		bbe->killDefs.clear();
+		bbe->nextBBs.clear();
 	}
-	return out;
+	defs.clear();
+	valueDefs.clear();
 }
 
 //
@@ -391,52 +543,72 @@ BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b, std::size_t _id) :
 
 }
 
-void BasicBlockEntry::initializeKillDefSets()
+void BasicBlockEntry::initializeKillGenSets(const FunctionEntry& fe)
 {
 	killDefs.clear();
 	genDefs.clear();
 
+	std::unordered_set<const llvm::Value*> killed;
 	for (auto dIt = defs.rbegin(); dIt != defs.rend(); ++dIt)
 	{
 		Definition& d = *dIt;
 
-		bool added = (killDefs.insert(d.getSource())).second;
+		bool added = (killed.insert(d.getSource())).second;
 		if (added)
 		{
-			genDefs.insert(&d);
+			genDefs.push_back(d.id);
+			killDefs.push_back(&fe.valueDefs.find(d.getSource())->second);
 		}
 	}
 }
 
 /**
  * REACH_in[B] = Sum (p in pred[B]) (REACH_out[p])
- * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
  */
-Changed BasicBlockEntry::initDefsOut()
+void BasicBlockEntry::computeDefsIn(llvm::BitVector& defsIn) const
 {
-	auto oldSz = defsOut.size();
-
-	if (defsOut.empty() && !genDefs.empty())
+	defsIn.reset();
+	defsIn.resize(defsOut.size());
+	for (auto* p : prevBBs)
 	{
-		defsOut = std::move(genDefs);
+		defsIn |= p->defsOut;
 	}
+}
 
-	for (auto* p : prevBBs)
+/**
+ * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
+ * @param tmp Bit vector used to compute the new REACH_out[B].
+ * @return @c True if REACH_out[B] changed, @c false otherwise.
+ */
+Changed BasicBlockEntry::initDefsOut(llvm::BitVector& tmp)
+{
+	computeDefsIn(tmp);
+
+	for (auto* vd : killDefs)
 	{
-		if (p->changed)
+		if (vd->mask.empty())
 		{
-			for (auto* d : p->defsOut)
+			for (auto id : vd->ids)
 			{
-				if (killDefs.find(d->getSource()) == killDefs.end())
-				{
-					defsOut.insert(d);
-				}
+				tmp.reset(id);
 			}
 		}
+		else
+		{
+			tmp.reset(vd->mask);
+		}
+	}
+	for (auto id : genDefs)
+	{
+		tmp.set(id);
 	}
 
-	changed = oldSz != defsOut.size();
-	return changed;
+	if (tmp == defsOut)
+	{
+		return false;
+	}
+	std::swap(tmp, defsOut);
+	return true;
 }
 
 std::string BasicBlockEntry::getName() const
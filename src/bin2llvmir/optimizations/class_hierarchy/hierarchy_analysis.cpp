@@ -33,6 +33,11 @@ ClassHierarchyAnalysis::ClassHierarchyAnalysis() :
 
 bool ClassHierarchyAnalysis::runOnModule(Module& M)
 {
+	if (skipModule(M))
+	{
+		return false;
+	}
+
 	if (!ConfigProvider::getConfig(&M, config))
 	{
 		LOG << "[ABORT] config file is not available\n";
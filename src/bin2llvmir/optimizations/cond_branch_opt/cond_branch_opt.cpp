@@ -40,6 +40,11 @@ CondBranchOpt::CondBranchOpt() :
 
 bool CondBranchOpt::runOnModule(llvm::Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_config = ConfigProvider::getConfig(_module);
 	_abi = AbiProvider::getAbi(_module);
@@ -49,6 +49,11 @@ ConstantsAnalysis::ConstantsAnalysis() :
 
 bool ConstantsAnalysis::runOnModule(llvm::Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_config = ConfigProvider::getConfig(_module);
 	_abi = AbiProvider::getAbi(_module);
@@ -63,7 +63,13 @@ std::size_t Decoder::decodeJumpTargetDryRun_arm64(
 	// bytes.first  -> Code
 	// bytes.second -> Code size
 	// addr         -> Address of first instruction
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (_insnCache.disasm(
+			ce,
+			_c2l->getBasicMode(),
+			&bytes.first,
+			&bytes.second,
+			&addr,
+			_dryCsInsn))
 	{
 
 		if (strict && first && !looksLikeArm64FunctionStart(_dryCsInsn))
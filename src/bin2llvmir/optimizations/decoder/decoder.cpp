@@ -76,6 +76,15 @@ bool Decoder::runOnModuleCustom(
 	return runCatcher();
 }
 
+/**
+ * Decoding stops (keeping everything decoded so far) when the given token
+ * gets cancelled, or when the decoder time budget from the config runs out.
+ */
+void Decoder::setCancellationToken(const utils::CancellationToken* token)
+{
+	_cancellation = token;
+}
+
 bool Decoder::runCatcher()
 {
 	// TODO: here, we shoudl catch only the most severe capstone2llvmir
@@ -145,13 +154,39 @@ void Decoder::decode()
 {
 	LOG << "\n" << "decode():" << std::endl;
 
+	utils::CancellationToken cancellation(_cancellation);
+	if (auto t = _config->getConfig().parameters.getDecoderTimeout())
+	{
+		cancellation.setTimeout(std::chrono::seconds(t));
+	}
+
+	_insnCache.build(
+			_c2l->getArchitecture(),
+			_c2l->getBasicMode(),
+			_c2l->getExtraMode(),
+			_image,
+			_ranges,
+			_config->getNumberOfThreads(),
+			&cancellation);
+	LOG << "\t" << "pre-decoded instructions : " << _insnCache.size()
+			<< std::endl;
+
 	JumpTarget jt;
 	while (getJumpTarget(jt))
 	{
+		if (cancellation.isCancelled())
+		{
+			Log::error() << Log::Warning << "decoding cancelled, "
+					<< "the rest of the input is left undecoded" << std::endl;
+			break;
+		}
+
 		LOG << "\t" << "processing : " << jt << std::endl;
 		decodeJumpTarget(jt);
 	}
 
+	_insnCache.clear();
+
 	if (!_somethingDecoded)
 	{
 		throw std::runtime_error("No instructions were decoded");
@@ -338,6 +373,17 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne
 Decoder::translate(ByteData& bytes, common::Address& addr, llvm::IRBuilder<>& irb)
 {
+	// Instructions disassembled by the prepass are only translated.
+	//
+	if (auto* insn = _insnCache.get(_c2l->getBasicMode(), addr, bytes.second))
+	{
+		auto res = _c2l->translateOne(*insn, irb);
+		bytes.first += res.size;
+		bytes.second -= res.size;
+		addr += res.size;
+		return res;
+	}
+
 	auto res = _c2l->translateOne(bytes.first, bytes.second, addr, irb);
 
 	// MIPS 64-bit mode can decompile more instructions than the 32-bit mode.
@@ -85,6 +85,7 @@ void Decoder::initTranslator()
 			_module,
 			basicMode,
 			extraMode);
+	_c2l->setInstructionArena(AsmInstruction::getCapstoneInsnArena(_module));
 }
 
 /**
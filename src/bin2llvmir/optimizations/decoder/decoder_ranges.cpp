@@ -192,11 +192,27 @@ const common::AddressRange* RangesToDecode::get(common::Address a) const
 	return p ? p : getAlternative(a);
 }
 
+const common::AddressRangeContainer& RangesToDecode::getPrimaryRanges() const
+{
+	return _primaryRanges;
+}
+
+const common::AddressRangeContainer&
+RangesToDecode::getAlternativeRanges() const
+{
+	return _alternativeRanges;
+}
+
 void RangesToDecode::setArchitectureInstructionAlignment(unsigned a)
 {
 	archInsnAlign = a;
 }
 
+unsigned RangesToDecode::getArchitectureInstructionAlignment() const
+{
+	return archInsnAlign;
+}
+
 std::ostream& operator<<(std::ostream &os, const RangesToDecode& rs)
 {
 	os << "Primary ranges:" << std::endl;
@@ -0,0 +1,283 @@
+/**
+* @file src/bin2llvmir/optimizations/decoder/instruction_cache.cpp
+* @brief Cache of speculatively disassembled instructions.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+
+#include "retdec/bin2llvmir/optimizations/decoder/instruction_cache.h"
+#include "retdec/utils/memory.h"
+#include "retdec/utils/parallel.h"
+
+using namespace retdec::common;
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Disassemble all the primary and alternative @a ranges in the given mode
+ * by at most @a threads threads.
+ * The cache is filled until its size limit (see getMaxCacheSize()) or the
+ * memory soft limit is reached, or until @a cancellation gets cancelled.
+ * Nothing is cached in the Thumb mode.
+ */
+void InstructionCache::build(
+		cs_arch arch,
+		cs_mode basicMode,
+		cs_mode extraMode,
+		FileImage* image,
+		const RangesToDecode& ranges,
+		std::size_t threads,
+		const utils::CancellationToken* cancellation)
+{
+	clear();
+	_basicMode = basicMode;
+	if (arch == CS_ARCH_ARM && basicMode == CS_MODE_THUMB)
+	{
+		return;
+	}
+
+	// Chunks are created here, threads then only fill them.
+	//
+	for (auto* rs : {&ranges.getPrimaryRanges(), &ranges.getAlternativeRanges()})
+	for (auto& r : *rs)
+	{
+		auto bytes = image->getImage()->getRawSegmentData(r.getStart());
+		if (bytes.first == nullptr)
+		{
+			continue;
+		}
+		std::size_t rangeSize = r.getEnd() - r.getStart();
+		rangeSize = std::min<std::size_t>(rangeSize, bytes.second);
+
+		for (std::size_t off = 0; off < rangeSize; off += chunkSize)
+		{
+			Chunk c;
+			c.start = r.getStart() + off;
+			c.end = r.getStart() + std::min(off + chunkSize, rangeSize);
+			c.bytes = bytes.first + off;
+			c.bytesSize = rangeSize - off;
+			_chunks.push_back(std::move(c));
+		}
+	}
+	std::sort(_chunks.begin(), _chunks.end(),
+			[](const Chunk& a, const Chunk& b) { return a.start < b.start; });
+
+	// Every thread uses its own engine.
+	//
+	std::vector<csh> engines;
+	std::size_t threadsCount = std::min(
+			std::max<std::size_t>(1, threads),
+			_chunks.size());
+	for (std::size_t i = 0; i < threadsCount; ++i)
+	{
+		csh ce = 0;
+		if (cs_open(arch, static_cast<cs_mode>(basicMode + extraMode), &ce)
+				!= CS_ERR_OK)
+		{
+			break;
+		}
+		if (cs_option(ce, CS_OPT_DETAIL, CS_OPT_ON) != CS_ERR_OK)
+		{
+			cs_close(&ce);
+			break;
+		}
+		engines.push_back(ce);
+	}
+	auto closeEngines = [&engines]()
+	{
+		for (auto& ce : engines)
+		{
+			cs_close(&ce);
+		}
+		engines.clear();
+	};
+
+	unsigned alignment = ranges.getArchitectureInstructionAlignment();
+	const std::size_t insnSize = sizeof(cs_insn) + sizeof(cs_detail);
+	const std::size_t maxSize = getMaxCacheSize();
+	std::atomic<std::size_t> cachedSize(0);
+	try
+	{
+		utils::parallelFor(
+				engines.empty() ? 0 : _chunks.size(),
+				engines.size(),
+				[&](std::size_t i, std::size_t thread)
+		{
+			if (cachedSize >= maxSize
+					|| utils::isMemorySoftLimitExceeded()
+					|| (cancellation && cancellation->isCancelled()))
+			{
+				return false;
+			}
+
+			disassembleChunk(engines[thread], alignment, _chunks[i]);
+			cachedSize += _chunks[i].insns.size() * insnSize;
+			return true;
+		});
+	}
+	catch (...)
+	{
+		closeEngines();
+		clear();
+		throw;
+	}
+	closeEngines();
+
+	_chunks.erase(
+			std::remove_if(_chunks.begin(), _chunks.end(),
+					[](const Chunk& c) { return c.insns.empty(); }),
+			_chunks.end());
+	for (auto& c : _chunks)
+	{
+		_size += c.insns.size();
+	}
+}
+
+/**
+ * Linear sweep of one chunk. Bytes which can not be disassembled are skipped
+ * by the architecture instruction alignment.
+ */
+void InstructionCache::disassembleChunk(
+		csh ce,
+		unsigned alignment,
+		Chunk& chunk) const
+{
+	cs_insn* insn = cs_malloc(ce);
+
+	const std::size_t step = alignment ? alignment : 1;
+	const uint8_t* code = chunk.bytes;
+	std::size_t size = chunk.bytesSize;
+	uint64_t addr = chunk.start;
+	while (addr < chunk.end && size > 0)
+	{
+		if (cs_disasm_iter(ce, &code, &size, &addr, insn))
+		{
+			chunk.insns.push_back(*insn);
+			chunk.details.push_back(*insn->detail);
+		}
+		else if (size > step)
+		{
+			code += step;
+			size -= step;
+			addr += step;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	for (std::size_t i = 0; i < chunk.insns.size(); ++i)
+	{
+		chunk.insns[i].detail = &chunk.details[i];
+	}
+
+	cs_free(insn, 1);
+}
+
+void InstructionCache::clear()
+{
+	_chunks.clear();
+	_size = 0;
+}
+
+/**
+ * @return Number of cached instructions.
+ */
+std::size_t InstructionCache::size() const
+{
+	return _size;
+}
+
+/**
+ * @return Maximal size of the cached instructions: @c maxCacheSize, or
+ * a quarter of the memory soft limit if it is set and lower. The rest of the
+ * memory is left to decoding.
+ */
+std::size_t InstructionCache::getMaxCacheSize()
+{
+	std::size_t maxSize = maxCacheSize;
+	if (std::size_t softLimit = utils::getMemorySoftLimit())
+	{
+		maxSize = std::min(maxSize, softLimit / 4);
+	}
+	return maxSize;
+}
+
+/**
+ * @return Instruction disassembled at address @a a in @a basicMode, which is
+ * at most @a maxSize bytes long, or @c nullptr if there is no such instruction
+ * in the cache.
+ */
+const cs_insn* InstructionCache::get(
+		cs_mode basicMode,
+		common::Address a,
+		std::size_t maxSize) const
+{
+	if (basicMode != _basicMode || _chunks.empty() || a.isUndefined())
+	{
+		return nullptr;
+	}
+
+	auto cIt = std::upper_bound(_chunks.begin(), _chunks.end(), a,
+			[](const Address& a, const Chunk& c) { return a < c.start; });
+	if (cIt == _chunks.begin())
+	{
+		return nullptr;
+	}
+	--cIt;
+	if (a >= cIt->end)
+	{
+		return nullptr;
+	}
+
+	auto iIt = std::lower_bound(cIt->insns.begin(), cIt->insns.end(), a,
+			[](const cs_insn& i, const Address& a) { return i.address < a; });
+	if (iIt == cIt->insns.end()
+			|| iIt->address != a
+			|| iIt->size > maxSize)
+	{
+		return nullptr;
+	}
+
+	return &(*iIt);
+}
+
+/**
+ * Drop-in replacement for @c cs_disasm_iter(). The instruction is copied from
+ * the cache if it is there, otherwise it is disassembled by @a ce, which must
+ * be set to @a basicMode.
+ */
+bool InstructionCache::disasm(
+		csh ce,
+		cs_mode basicMode,
+		const uint8_t** code,
+		std::size_t* size,
+		uint64_t* address,
+		cs_insn* insn) const
+{
+	auto* cached = get(basicMode, *address, *size);
+	if (cached == nullptr)
+	{
+		return cs_disasm_iter(ce, code, size, address, insn);
+	}
+
+	cs_detail* detail = insn->detail;
+	*insn = *cached;
+	insn->detail = detail;
+	if (detail)
+	{
+		*detail = *cached->detail;
+	}
+
+	*code += cached->size;
+	*size -= cached->size;
+	*address += cached->size;
+	return true;
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
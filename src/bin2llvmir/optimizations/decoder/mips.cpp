@@ -53,7 +53,13 @@ bool Decoder::disasm_mips(
 		uint64_t& a,
 		cs_insn* i)
 {
-	bool ret = cs_disasm_iter(ce, &bytes.first, &bytes.second, &a, i);
+	bool ret = _insnCache.disasm(
+			ce,
+			m,
+			&bytes.first,
+			&bytes.second,
+			&a,
+			i);
 
 	if (ret == false && (m & CS_MODE_MIPS32))
 	{
@@ -30,7 +30,13 @@ std::size_t Decoder::decodeJumpTargetDryRun_ppc(
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (_insnCache.disasm(
+			ce,
+			_c2l->getBasicMode(),
+			&bytes.first,
+			&bytes.second,
+			&addr,
+			_dryCsInsn))
 	{
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
@@ -33,7 +33,13 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 	bool storeOneToEax = false;
 	bool lastSyscall = false;
 	std::size_t decodedSz = 0;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (_insnCache.disasm(
+			ce,
+			_c2l->getBasicMode(),
+			&bytes.first,
+			&bytes.second,
+			&addr,
+			_dryCsInsn))
 	{
 		decodedSz += _dryCsInsn->size;
 		auto& detail = _dryCsInsn->detail->x86;
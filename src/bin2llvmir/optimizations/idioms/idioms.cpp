@@ -61,6 +61,8 @@ bool Idioms::doFinalization(Module &M) {
  * @return true if an exchange was made
  */
 bool Idioms::runOnFunction(Function & f) {
+	if (skipFunction(f))
+		return false;
 
 	m_config = ConfigProvider::getConfig(f.getParent());
 
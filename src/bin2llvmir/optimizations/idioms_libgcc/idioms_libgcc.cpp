@@ -1403,6 +1403,11 @@ IdiomsLibgcc::IdiomsLibgcc() :
 
 bool IdiomsLibgcc::runOnModule(Module& M)
 {
+	if (skipModule(M))
+	{
+		return false;
+	}
+
 	_module = &M;
 	_config = ConfigProvider::getConfig(_module);
 	_abi = AbiProvider::getAbi(_module);
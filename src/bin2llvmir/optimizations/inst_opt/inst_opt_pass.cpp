@@ -31,6 +31,11 @@ InstructionOptimizer::InstructionOptimizer() :
 
 bool InstructionOptimizer::runOnModule(Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	return run();
 }
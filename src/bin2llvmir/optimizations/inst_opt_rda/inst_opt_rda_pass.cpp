@@ -10,12 +10,24 @@
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda_pass.h"
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
+#include "retdec/utils/io/log.h"
+#include "retdec/utils/memory.h"
 
 using namespace llvm;
+using namespace retdec::utils::io;
 
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/// Number of instructions processed between checks of the memory soft limit.
+/// Obtaining the memory of the process is not free (e.g. it reads /proc on
+/// Linux), so it is not checked before each of many small functions.
+const std::size_t MEMORY_CHECK_INTERVAL = 10000;
+
+} // anonymous namespace
+
 char InstructionRdaOptimizer::ID = 0;
 
 static RegisterPass<InstructionRdaOptimizer> X(
@@ -33,6 +45,11 @@ InstructionRdaOptimizer::InstructionRdaOptimizer() :
 
 bool InstructionRdaOptimizer::runOnModule(Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_abi = AbiProvider::getAbi(_module);
 	return run();
@@ -49,8 +66,27 @@ bool InstructionRdaOptimizer::run()
 {
 	bool changed = false;
 
+	// Start with a check, the memory may be short already.
+	std::size_t uncheckedInsns = MEMORY_CHECK_INTERVAL;
 	for (Function& f : *_module)
 	{
+		// RDA of large functions is memory expensive. The optimization is
+		// not needed for correct output, so rather skip the rest of it than
+		// run out of memory.
+		auto insns = f.getInstructionCount();
+		uncheckedInsns += insns;
+		if (uncheckedInsns >= MEMORY_CHECK_INTERVAL)
+		{
+			uncheckedInsns = insns;
+			if (utils::isMemorySoftLimitExceeded())
+			{
+				Log::error() << Log::Warning << "memory soft limit exceeded, "
+						<< "skipping RDA-based optimization of the remaining "
+						<< "functions" << std::endl;
+				break;
+			}
+		}
+
 		changed |= runOnFunction(&f);
 	}
 
@@ -40,6 +40,11 @@ MainDetection::MainDetection() :
 
 bool MainDetection::runOnModule(llvm::Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_config = ConfigProvider::getConfig(_module);
 	_image = FileImageProvider::getFileImage(_module);
@@ -52,6 +52,11 @@ ParamReturn::ParamReturn() :
 
 bool ParamReturn::runOnModule(Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_config = ConfigProvider::getConfig(_module);
 	_abi = AbiProvider::getAbi(_module);
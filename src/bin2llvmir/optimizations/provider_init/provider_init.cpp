@@ -11,6 +11,7 @@
 #include "retdec/utils/io/log.h"
 #include "retdec/bin2llvmir/analyses/symbolic_tree.h"
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/optimizations/simple_types/simple_types.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/calling_convention/calling_convention.h"
@@ -168,19 +169,53 @@ void ProviderInitialization::setConfig(retdec::config::Config* c)
 	_config = c;
 }
 
+/**
+ * Use already parsed input file @a f instead of parsing the input file
+ * from config again. It is used only if it was created from the same path
+ * as the config's input file.
+ */
+void ProviderInitialization::setInputFile(
+		const std::shared_ptr<retdec::fileformat::FileFormat>& f)
+{
+	_inputFile = f;
+}
+
+/**
+ * Analyses run over the whole module stop early when @a token gets
+ * cancelled.
+ */
+void ProviderInitialization::setCancellationToken(
+		const utils::CancellationToken* token)
+{
+	_cancellation = token;
+}
+
+/**
+ * Clear all the provider data associated with the module @a m.
+ * Data of other modules (possibly being processed in other threads)
+ * are left untouched.
+ */
+void ProviderInitialization::clearProviders(llvm::Module* m)
+{
+	AbiProvider::clear(m);
+	AsmInstruction::clear(m);
+	ConfigProvider::clear(m);
+	DebugFormatProvider::clear(m);
+	DemanglerProvider::clear(m);
+	FileImageProvider::clear(m);
+	LtiProvider::clear(m);
+	NamesProvider::clear(m);
+	SimpleTypesAnalysis::clear(m);
+}
+
 /**
  * @return Always @c false -- this pass does not modify module.
  */
 bool ProviderInitialization::runOnModule(Module& m)
 {
-	AbiProvider::clear();
-	AsmInstruction::clear();
-	ConfigProvider::clear();
-	DebugFormatProvider::clear();
-	DemanglerProvider::clear();
-	FileImageProvider::clear();
-	LtiProvider::clear();
-	NamesProvider::clear();
+	// Module may have been allocated at the address of some already
+	// destroyed module -> get rid of its stale data.
+	clearProviders(&m);
 	SymbolicTree::clear();
 	CallingConventionProvider::clear();
 
@@ -196,13 +231,15 @@ bool ProviderInitialization::runOnModule(Module& m)
 	{
 		throw std::runtime_error("ProviderInitialization: c == nullptr");
 	}
+	c->setCancellationToken(_cancellation);
 
 	// Fileimage.
 	//
-	auto* f = FileImageProvider::addFileImage(
-			&m,
-			c->getConfig().parameters.getInputFile(),
-			c);
+	auto& inputFile = c->getConfig().parameters.getInputFile();
+	auto* f = _inputFile && _inputFile->getPathToFile() == inputFile
+			? FileImageProvider::addFileImage(&m, _inputFile, c)
+			: FileImageProvider::addFileImage(&m, inputFile, c);
+	_inputFile.reset();
 	if (f == nullptr)
 	{
 		throw std::runtime_error("ProviderInitialization: f == nullptr");
@@ -361,7 +398,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 	{
 		yara.addRuleFile(crypto);
 	}
-	yara.analyze(c->getConfig().parameters.getInputFile());
+	yara.analyze(f->getFileFormat()->getBytes());
 	for(const auto &rule : yara.getDetectedRules())
 	{
 		common::Pattern p = saveCryptoRule(
@@ -403,7 +440,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	NamesProvider::addNames(&m, c, debug, f, d, lti);
 
-	AsmInstruction::clear();
+	AsmInstruction::clear(&m);
 
 	return false;
 }
@@ -39,6 +39,11 @@ RegisterLocalization::RegisterLocalization() :
 
 bool RegisterLocalization::runOnModule(Module& M)
 {
+	if (skipModule(M))
+	{
+		return false;
+	}
+
 	_module = &M;
 	_abi = AbiProvider::getAbi(_module);
 	_config = ConfigProvider::getConfig(_module);
@@ -49,6 +49,9 @@ std::string priority2string(eSourcePriority p)
 
 char SimpleTypesAnalysis::ID = 0;
 
+std::set<llvm::Module*> SimpleTypesAnalysis::_firstRunDone;
+std::mutex SimpleTypesAnalysis::_firstRunDoneMutex;
+
 static RegisterPass<SimpleTypesAnalysis> X(
 		"retdec-simple-types",
 		"Simple types recovery optimization",
@@ -67,8 +70,22 @@ void SimpleTypesAnalysis::getAnalysisUsage(AnalysisUsage& AU) const
 
 }
 
+/**
+ * Forget that the first run of the pass was done on module @a m.
+ */
+void SimpleTypesAnalysis::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_firstRunDoneMutex);
+	_firstRunDone.erase(m);
+}
+
 bool SimpleTypesAnalysis::runOnModule(Module& M)
 {
+	if (skipModule(M))
+	{
+		return false;
+	}
+
 	if (!ConfigProvider::getConfig(&M, config))
 	{
 		LOG << "[ABORT] config file is not available\n";
@@ -82,12 +99,18 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	module = &M;
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(module);
 
-	static bool first = true;
+	bool first = false;
+	{
+		std::lock_guard<std::mutex> lock(_firstRunDoneMutex);
+		first = _firstRunDone.insert(module).second;
+		if (!first)
+		{
+			_firstRunDone.erase(module);
+		}
+	}
 
 	if (first)
 	{
-		first = false;
-
 		RDA.runOnModule(M, AbiProvider::getAbi(&M));
 		buildEqSets(M);
 		buildEquations();
@@ -99,8 +122,6 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	}
 	else
 	{
-		first = true;
-
 		instToErase.clear();
 
 		IrModifier irModif(module, config);
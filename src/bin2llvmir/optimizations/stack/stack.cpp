@@ -42,6 +42,11 @@ StackAnalysis::StackAnalysis() :
 
 bool StackAnalysis::runOnModule(llvm::Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_config = ConfigProvider::getConfig(_module);
 	_abi = AbiProvider::getAbi(_module);
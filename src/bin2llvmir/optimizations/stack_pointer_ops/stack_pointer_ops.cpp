@@ -41,6 +41,11 @@ StackPointerOpsRemove::StackPointerOpsRemove() :
 
 bool StackPointerOpsRemove::runOnModule(Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	_module = &m;
 	_abi = AbiProvider::getAbi(_module);
 	return run();
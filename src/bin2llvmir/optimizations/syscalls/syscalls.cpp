@@ -30,6 +30,11 @@ SyscallFixer::SyscallFixer() :
 
 bool SyscallFixer::runOnModule(llvm::Module& M)
 {
+	if (skipModule(M))
+	{
+		return false;
+	}
+
 	_module = &M;
 	_config = ConfigProvider::getConfig(_module);
 	_image = FileImageProvider::getFileImage(_module);
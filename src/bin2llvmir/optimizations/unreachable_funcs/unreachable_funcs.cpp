@@ -115,6 +115,11 @@ void UnreachableFuncs::getAnalysisUsage(AnalysisUsage& au) const
 
 bool UnreachableFuncs::runOnModule(Module& m)
 {
+	if (skipModule(m))
+	{
+		return false;
+	}
+
 	module = &m;
 	config = ConfigProvider::getConfig(module);
 	return run();
@@ -20,8 +20,15 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
-std::vector<AsmInstruction::ModuleGlobalPair> AsmInstruction::_module2global;
-std::vector<AsmInstruction::ModuleInstructionMap> AsmInstruction::_module2instMap;
+std::map<const llvm::Module*, llvm::GlobalVariable*> AsmInstruction::_module2global;
+std::map<const llvm::Module*, Llvm2CapstoneInsnMap> AsmInstruction::_module2instMap;
+std::map<
+		const llvm::Module*,
+		std::shared_ptr<capstone2llvmir::InsnArena>> AsmInstruction::_module2arena;
+std::map<
+		const llvm::Module*,
+		AsmInstruction::AddressIndex> AsmInstruction::_module2addressIndex;
+std::mutex AsmInstruction::_mutex;
 
 AsmInstruction::AsmInstruction()
 {
@@ -35,8 +42,23 @@ AsmInstruction::AsmInstruction(llvm::Instruction* inst)
 		return;
 	}
 
+	auto* m = inst->getModule();
+	auto* gv = getLlvmToAsmGlobalVariable(m);
+	if (gv == nullptr)
+	{
+		return;
+	}
+	if (isLlvmToAsmInstruction(inst, gv))
+	{
+		_llvmToAsmInstr = cast<StoreInst>(inst);
+		return;
+	}
+
+	// The walk is not cached: whether a mapping instruction still precedes
+	// the instruction depends on the order of instructions, which LLVM does
+	// not report changes of. Checking it would cost as much as the walk.
 	auto* bb = inst->getParent();
-	while (inst && !isLlvmToAsmInstructionPrivate(inst))
+	while (inst && !isLlvmToAsmInstruction(inst, gv))
 	{
 		if (&bb->front() == inst)
 		{
@@ -56,8 +78,7 @@ AsmInstruction::AsmInstruction(llvm::Instruction* inst)
 		}
 	}
 
-	auto* s = dyn_cast_or_null<StoreInst>(inst);
-	_llvmToAsmInstr = isLlvmToAsmInstructionPrivate(s) ? s : nullptr;
+	_llvmToAsmInstr = cast_or_null<StoreInst>(inst);
 }
 
 AsmInstruction::AsmInstruction(llvm::BasicBlock* bb)
@@ -77,10 +98,16 @@ AsmInstruction::AsmInstruction(llvm::Function* f)
 		return;
 	}
 
+	auto* gv = getLlvmToAsmGlobalVariable(f->getParent());
+	if (gv == nullptr)
+	{
+		return;
+	}
+
 	for (auto it = inst_begin(f), e = inst_end(f); it != e; ++it)
 	{
 		Instruction* i = &(*it);
-		if (isLlvmToAsmInstructionPrivate(i))
+		if (isLlvmToAsmInstruction(i, gv))
 		{
 			_llvmToAsmInstr = dyn_cast_or_null<StoreInst>(i);
 			return;
@@ -95,6 +122,12 @@ AsmInstruction::AsmInstruction(llvm::Module* m, retdec::common::Address addr)
 		return;
 	}
 
+	auto* gv = getLlvmToAsmGlobalVariable(m);
+	if (gv == nullptr)
+	{
+		return;
+	}
+
 	ConstantInt* ci = ConstantInt::get(
 			Type::getInt64Ty(m->getContext()),
 			addr,
@@ -104,11 +137,31 @@ AsmInstruction::AsmInstruction(llvm::Module* m, retdec::common::Address addr)
 		return;
 	}
 
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& index = getAddressIndex(m);
+		auto it = index.addr2asm.find(addr.getValue());
+		if (it != index.addr2asm.end())
+		{
+			auto* s = cast_or_null<StoreInst>(static_cast<Value*>(it->second));
+			if (s && s->getParent()
+					&& s->getValueOperand() == ci
+					&& s->getPointerOperand() == gv)
+			{
+				_llvmToAsmInstr = s;
+				return;
+			}
+		}
+	}
+
 	for (auto* u : ci->users())
 	{
-		if (isLlvmToAsmInstructionPrivate(u))
+		if (isLlvmToAsmInstruction(u, gv))
 		{
-			_llvmToAsmInstr = dyn_cast_or_null<StoreInst>(u);
+			_llvmToAsmInstr = cast<StoreInst>(u);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			getAddressIndex(m).addr2asm[addr.getValue()] = _llvmToAsmInstr;
 			return;
 		}
 	}
@@ -186,38 +239,41 @@ const llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariablePrivate(
 Llvm2CapstoneInsnMap& AsmInstruction::getLlvmToCapstoneInsnMap(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2instMap)
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _module2instMap[m];
+}
+
+/**
+ * Capstone instructions mapped to LLVM instructions of module @a m are
+ * allocated in this arena. They are all freed when the module's data are
+ * cleared.
+ */
+std::shared_ptr<capstone2llvmir::InsnArena> AsmInstruction::getCapstoneInsnArena(
+		const llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& arena = _module2arena[m];
+	if (arena == nullptr)
 	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
+		arena = std::make_shared<capstone2llvmir::InsnArena>();
 	}
-
-	auto it = _module2instMap.emplace(_module2instMap.end(), std::make_pair(
-			m,
-			std::map<llvm::StoreInst*, cs_insn*>()));
-	return it->second;
+	return arena;
 }
 
 llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariable(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2global)
-	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
-	}
-	return nullptr;
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _module2global.find(m);
+	return it != _module2global.end() ? it->second : nullptr;
 }
 
 void AsmInstruction::setLlvmToAsmGlobalVariable(
 		const llvm::Module* m,
 		llvm::GlobalVariable* gv)
 {
-	_module2global.emplace_back(m, gv);
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2global.emplace(m, gv);
 }
 
 retdec::common::Address AsmInstruction::getInstructionAddress(
@@ -315,6 +371,14 @@ bool AsmInstruction::isLlvmToAsmInstructionPrivate(llvm::Value* inst) const
 	return s->getPointerOperand() == getLlvmToAsmGlobalVariablePrivate(m);
 }
 
+bool AsmInstruction::isLlvmToAsmInstruction(
+		const llvm::Value* inst,
+		const llvm::Value* gv)
+{
+	auto* s = dyn_cast_or_null<StoreInst>(inst);
+	return s && gv && s->getPointerOperand() == gv;
+}
+
 bool AsmInstruction::isLlvmToAsmInstruction(const llvm::Value* inst)
 {
 	auto* s = dyn_cast_or_null<StoreInst>(inst);
@@ -328,8 +392,41 @@ bool AsmInstruction::isLlvmToAsmInstruction(const llvm::Value* inst)
 
 void AsmInstruction::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2global.clear();
 	_module2instMap.clear();
+	_module2arena.clear();
+	_module2addressIndex.clear();
+}
+
+void AsmInstruction::clear(const llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2global.erase(m);
+	_module2instMap.erase(m);
+	_module2arena.erase(m);
+	_module2addressIndex.erase(m);
+}
+
+/**
+ * Get the index of mapping instructions by addresses in module @a m.
+ * The index is started over when a new ASM instruction was registered in the
+ * module, because its mapping instruction may store an address which is
+ * already indexed. Caller must hold @c _mutex.
+ */
+AsmInstruction::AddressIndex& AsmInstruction::getAddressIndex(
+		const llvm::Module* m)
+{
+	auto it = _module2instMap.find(m);
+	auto asmInsnCount = it != _module2instMap.end() ? it->second.size() : 0;
+
+	auto& index = _module2addressIndex[m];
+	if (index.asmInsnCount != asmInsnCount)
+	{
+		index.addr2asm.clear();
+		index.asmInsnCount = asmInsnCount;
+	}
+	return index;
 }
 
 bool AsmInstruction::isValid() const
@@ -344,16 +441,15 @@ bool AsmInstruction::isInvalid() const
 
 cs_insn* AsmInstruction::getCapstoneInsn() const
 {
-	for (auto& p : _module2instMap)
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto mit = _module2instMap.find(_llvmToAsmInstr->getModule());
+	if (mit == _module2instMap.end())
 	{
-		if (p.first == _llvmToAsmInstr->getModule())
-		{
-			auto it =  p.second.find(_llvmToAsmInstr);
-			return it != p.second.end() ? it->second : nullptr;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	auto it = mit->second.find(_llvmToAsmInstr);
+	return it != mit->second.end() ? it->second : nullptr;
 }
 
 std::string AsmInstruction::getDsm() const
@@ -12,6 +12,7 @@
 #include "retdec/bin2llvmir/providers/demangler.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 #include "retdec/bin2llvmir/utils/llvm.h"
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/string.h"
 
 using namespace llvm;
@@ -467,6 +468,33 @@ fs::path Config::getOutputDirectory()
 	return fs::canonical(fsp).parent_path();
 }
 
+/**
+ * @return Maximal number of threads analysing the module in parallel, as
+ * configured by the backend threads parameter.
+ */
+std::size_t Config::getNumberOfThreads() const
+{
+	return utils::getNumberOfThreads(getConfig().parameters.getBackendThreads());
+}
+
+/**
+ * Long-running analyses stop early when @a token gets cancelled.
+ */
+void Config::setCancellationToken(const utils::CancellationToken* token)
+{
+	_cancellation = token;
+}
+
+const utils::CancellationToken* Config::getCancellationToken() const
+{
+	return _cancellation;
+}
+
+bool Config::isCancelled() const
+{
+	return _cancellation && _cancellation->isCancelled();
+}
+
 void Config::setLlvmCallPseudoFunction(llvm::Function* f)
 {
 	_callFunction = f;
@@ -733,15 +761,20 @@ void Config::tagFunctionsWithUsedCryptoGlobals()
 //
 
 std::map<llvm::Module*, Config> ConfigProvider::_module2config;
+std::mutex ConfigProvider::_mutex;
 
 Config* ConfigProvider::addConfig(llvm::Module* m, retdec::config::Config& c)
 {
-	auto p = _module2config.emplace(m, Config::fromConfig(m, c));
+	auto config = Config::fromConfig(m, c);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2config.emplace(m, std::move(config));
 	return &p.first->second;
 }
 
 Config* ConfigProvider::getConfig(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2config.find(m);
 	return f != _module2config.end() ? &f->second : nullptr;
 }
@@ -766,8 +799,18 @@ void ConfigProvider::doFinalization(llvm::Module* m)
  */
 void ConfigProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2config.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void ConfigProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2config.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
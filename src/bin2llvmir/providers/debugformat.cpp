@@ -24,6 +24,7 @@ namespace bin2llvmir {
 //
 
 std::map<Module*, DebugFormat> DebugFormatProvider::_module2debug;
+std::mutex DebugFormatProvider::_mutex;
 
 /**
  * Create and add to provider a debug info for the given module @a m, file
@@ -42,15 +43,15 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 		return nullptr;
 	}
 
-	auto p = _module2debug.emplace(
-			m,
-			DebugFormat(
-					objf,
-					pdbFile,
-					nullptr, // symbol table -- not needed.
-					demangler ? demangler->getDemangler() : nullptr
-			)
+	DebugFormat df(
+			objf,
+			pdbFile,
+			nullptr, // symbol table -- not needed.
+			demangler ? demangler->getDemangler() : nullptr
 	);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2debug.emplace(m, std::move(df));
 	return &p.first->second;
 }
 
@@ -61,6 +62,7 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 DebugFormat* DebugFormatProvider::getDebugFormat(
 		llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2debug.find(m);
 	return f != _module2debug.end() ? &f->second : nullptr;
 }
@@ -84,8 +86,18 @@ bool DebugFormatProvider::getDebugFormat(llvm::Module* m, DebugFormat*& df)
  */
 void DebugFormatProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2debug.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void DebugFormatProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2debug.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
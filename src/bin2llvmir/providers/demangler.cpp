@@ -119,6 +119,7 @@ std::unique_ptr<Demangler> DemanglerFactory::getBorlandDemangler(
 /********************** Demangler Provider ************************/
 /******************************************************************/
 std::map<Module *, std::unique_ptr<Demangler>> DemanglerProvider::_module2demangler;
+std::mutex DemanglerProvider::_mutex;
 
 /**
  * Create and add to provider a demangler for the given module @a m
@@ -144,6 +145,7 @@ Demangler *DemanglerProvider::addDemangler(
 		d = DemanglerFactory::getItaniumDemangler(llvmModule, config, typeConfig);
 	}
 
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto p = _module2demangler.insert(std::make_pair(llvmModule, std::move(d)));
 
 	return p.first->second.get();
@@ -155,6 +157,7 @@ Demangler *DemanglerProvider::addDemangler(
  */
 Demangler *DemanglerProvider::getDemangler(llvm::Module *m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2demangler.find(m);
 	return f != _module2demangler.end() ? f->second.get() : nullptr;
 }
@@ -180,8 +183,18 @@ bool DemanglerProvider::getDemangler(
  */
 void DemanglerProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2demangler.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void DemanglerProvider::clear(llvm::Module *m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2demangler.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
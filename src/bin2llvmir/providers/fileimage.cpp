@@ -626,6 +626,7 @@ bool FileImage::isImportTerminating(
 //
 
 std::map<llvm::Module*, FileImage> FileImageProvider::_module2image;
+std::mutex FileImageProvider::_mutex;
 
 /**
  * Create and add to provider a file image created from file at @a path for
@@ -659,6 +660,7 @@ FileImage* FileImageProvider::addFileImage(
 		llvm::Module* m,
 		FileImage img)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto p = _module2image.emplace(m, std::move(img));
 	return &p.first->second;
 }
@@ -670,6 +672,7 @@ FileImage* FileImageProvider::addFileImage(
 FileImage* FileImageProvider::getFileImage(
 		llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2image.find(m);
 	return f != _module2image.end() ? &f->second : nullptr;
 }
@@ -695,8 +698,18 @@ bool FileImageProvider::getFileImage(
  */
 void FileImageProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2image.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void FileImageProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2image.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
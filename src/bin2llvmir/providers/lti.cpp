@@ -16,6 +16,7 @@
 #include "retdec/ctypes/union_type.h"
 #include "retdec/ctypes/unknown_type.h"
 #include "retdec/ctypes/void_type.h"
+#include "retdec/utils/result_cache.h"
 #include "retdec/utils/string.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/utils/ctypes2llvm.h"
@@ -31,6 +32,10 @@ namespace bin2llvmir {
 //=============================================================================
 //
 
+std::map<Lti::LtiModuleKey, std::shared_ptr<Lti::LtiModuleEntry>>
+		Lti::_ltiModules;
+std::mutex Lti::_ltiModulesMutex;
+
 Lti::Lti(
 	llvm::Module *m,
 	Config *c,
@@ -42,17 +47,15 @@ Lti::Lti(
 		_typeConfig(typeConfig),
 		_image(objf)
 {
-	_ltiModule = std::make_unique<retdec::ctypes::Module>(
-			std::make_shared<retdec::ctypes::Context>());
-
-	_ltiParser = ctypesparser::JSONCTypesParser(
-			static_cast<unsigned>(c->getConfig().architecture.getBitSize()));
+	// Files are loaded in this order, the first definition of a function
+	// wins.
+	std::vector<std::string> ltiFiles;
 
 	for (auto& l : _config->getConfig().parameters.libraryTypeInfoPaths)
 	{
 		if (retdec::utils::endsWith(l, "cstdlib.json"))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 	}
 
@@ -68,12 +71,12 @@ Lti::Lti(
 		if (retdec::utils::endsWith(l, "windows.json")
 				&& _config->getConfig().fileFormat.isPe())
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (winDriver
 				&& retdec::utils::endsWith(l, "windrivers.json"))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "linux.json")
 				&& (_config->getConfig().fileFormat.isElf()
@@ -81,28 +84,107 @@ Lti::Lti(
 				|| _config->getConfig().fileFormat.isIntelHex()
 				|| _config->getConfig().fileFormat.isRaw()))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "arm.json") &&
 				_config->getConfig().architecture.isArm32OrThumb())
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 	}
+
+	_ltiModule = getLtiModule(std::make_tuple(
+			static_cast<unsigned>(c->getConfig().architecture.getBitSize()),
+			_typeConfig->typeWidths(),
+			ltiFiles,
+			retdec::utils::ResultCache::getFilesStamp(ltiFiles)
+	));
+}
+
+/**
+ * Get LTI module created from the files in @a key. The files are parsed only
+ * the first time such a module is requested, all the subsequent requests
+ * (from any thread) get the same instance. A module is parsed again when any
+ * of its files changes (its stamp in @a key differs).
+ *
+ * Parsing runs outside of the cache lock, so modules for different keys can
+ * be parsed in parallel. Threads requesting a module being parsed wait for it.
+ */
+std::shared_ptr<const retdec::ctypes::Module> Lti::getLtiModule(
+		const LtiModuleKey& key)
+{
+	std::shared_ptr<LtiModuleEntry> entry;
+	{
+		std::lock_guard<std::mutex> lock(_ltiModulesMutex);
+
+		auto& cached = _ltiModules[key];
+		if (cached == nullptr)
+		{
+			cached = std::make_shared<LtiModuleEntry>();
+
+			// Modules parsed from older versions of the same files are not
+			// requested anymore.
+			for (auto it = _ltiModules.begin(); it != _ltiModules.end();)
+			{
+				if (std::get<0>(it->first) == std::get<0>(key)
+						&& std::get<1>(it->first) == std::get<1>(key)
+						&& std::get<2>(it->first) == std::get<2>(key)
+						&& std::get<3>(it->first) != std::get<3>(key))
+				{
+					it = _ltiModules.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+		entry = cached;
+	}
+
+	// If parsing throws, the next request tries it again.
+	std::call_once(entry->parsed, [&]()
+	{
+		entry->module = parseLtiModule(key);
+	});
+	return entry->module;
 }
 
-void Lti::loadLtiFile(const std::string& filePath)
+/**
+ * Parse LTI module from the files in @a key.
+ */
+std::shared_ptr<const retdec::ctypes::Module> Lti::parseLtiModule(
+		const LtiModuleKey& key)
 {
-	std::ifstream file(filePath);
-	if (file)
+	auto ltiModule = std::make_unique<retdec::ctypes::Module>(
+			std::make_shared<retdec::ctypes::Context>());
+	ctypesparser::JSONCTypesParser ltiParser(std::get<0>(key));
+
+	for (auto& filePath : std::get<2>(key))
 	{
-		std::string cc = "cdecl";
-		if (retdec::utils::containsCaseInsensitive(filePath, "win"))
+		std::ifstream file(filePath);
+		if (file)
 		{
-			cc = "stdcall";
+			std::string cc = "cdecl";
+			if (retdec::utils::containsCaseInsensitive(filePath, "win"))
+			{
+				cc = "stdcall";
+			}
+			ltiParser.parseInto(file, ltiModule, std::get<1>(key), cc);
 		}
-		_ltiParser.parseInto(file, _ltiModule, _typeConfig->typeWidths(), cc);
 	}
+
+	return std::move(ltiModule);
+}
+
+/**
+ * Drop all the cached LTI modules. Modules already used by existing Lti
+ * instances are not affected.
+ */
+void Lti::clearCache()
+{
+	std::lock_guard<std::mutex> lock(_ltiModulesMutex);
+	_ltiModules.clear();
 }
 
 bool Lti::hasLtiFunction(const std::string& name)
@@ -235,6 +317,7 @@ llvm::Type* Lti::getLlvmType(std::shared_ptr<retdec::ctypes::Type> type)
 //
 
 std::map<llvm::Module*, Lti> LtiProvider::_module2lti;
+std::mutex LtiProvider::_mutex;
 
 Lti* LtiProvider::addLti(
 	llvm::Module *m,
@@ -247,12 +330,16 @@ Lti* LtiProvider::addLti(
 		return nullptr;
 	}
 
-	auto p = _module2lti.emplace(m, Lti(m, c, typeConfig, objf));
+	Lti lti(m, c, typeConfig, objf);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto p = _module2lti.emplace(m, std::move(lti));
 	return &p.first->second;
 }
 
 Lti* LtiProvider::getLti(llvm::Module* m)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto f = _module2lti.find(m);
 	return f != _module2lti.end() ? &f->second : nullptr;
 }
@@ -265,8 +352,15 @@ bool LtiProvider::getLti(llvm::Module* m, Lti*& lti)
 
 void LtiProvider::clear()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_module2lti.clear();
 }
 
+void LtiProvider::clear(llvm::Module* m)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_module2lti.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
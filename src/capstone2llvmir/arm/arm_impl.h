@@ -123,12 +123,13 @@ class Capstone2LlvmIrTranslatorArm_impl :
 //==============================================================================
 //
 	protected:
-		static std::map<
-			std::size_t,
-			void (Capstone2LlvmIrTranslatorArm_impl::*)(
-					cs_insn* i,
-					cs_arm*,
-					llvm::IRBuilder<>&)> _i2fm;
+		using _translator_fnc = void (Capstone2LlvmIrTranslatorArm_impl::*)(
+				cs_insn* i,
+				cs_arm*,
+				llvm::IRBuilder<>&);
+		/// Capstone instruction IDs to their translation functions.
+		using _translator_table = std::array<_translator_fnc, ARM_INS_ENDING>;
+		static const _translator_table _i2fm;
 //
 //==============================================================================
 // ARM instruction translation methods.
@@ -374,13 +374,9 @@ void Capstone2LlvmIrTranslatorArm_impl::initializePseudoCallInstructionIDs()
 //==============================================================================
 //
 
-std::map<
-	std::size_t,
-	void (Capstone2LlvmIrTranslatorArm_impl::*)(
-			cs_insn* i,
-			cs_arm*,
-			llvm::IRBuilder<>&)>
+const Capstone2LlvmIrTranslatorArm_impl::_translator_table
 Capstone2LlvmIrTranslatorArm_impl::_i2fm =
+makeInsnTranslationTable<_translator_table>(
 {
 		{ARM_INS_INVALID, nullptr},
 
@@ -820,7 +816,7 @@ Capstone2LlvmIrTranslatorArm_impl::_i2fm =
 		{ARM_INS_VPOP, nullptr},
 
 		{ARM_INS_ENDING, nullptr},
-};
+});
 
 } // namespace capstone2llvmir
 } // namespace retdec
@@ -330,10 +330,9 @@ void Capstone2LlvmIrTranslatorArm64_impl::translateInstruction(
 
 	//std::cout << i->mnemonic << " " << i->op_str << std::endl;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	if (i->id < _i2fm.size() && _i2fm[i->id] != nullptr)
 	{
-		auto f = fIt->second;
+		auto f = _i2fm[i->id];
 
 		(this->*f)(i, ai, irb);
 	}
@@ -190,9 +190,9 @@ class Capstone2LlvmIrTranslatorArm64_impl :
 		/// Mapping from register to its parent register
 		std::map<uint32_t, uint32_t> _reg2parentMap;
 
-		static std::map<
-			std::size_t,
-			_translator_fnc> _i2fm;
+		/// Capstone instruction IDs to their translation functions.
+		using _translator_table = std::array<_translator_fnc, ARM64_INS_ENDING>;
+		static const _translator_table _i2fm;
 //
 //==============================================================================
 // ARM64 instruction translation methods.
@@ -1610,13 +1610,9 @@ void Capstone2LlvmIrTranslatorArm64_impl::initializeRegistersParentMap()
 //==============================================================================
 //
 
-std::map<
-	std::size_t,
-	void (Capstone2LlvmIrTranslatorArm64_impl::*)(
-			cs_insn* i,
-			cs_arm64*,
-			llvm::IRBuilder<>&)>
+const Capstone2LlvmIrTranslatorArm64_impl::_translator_table
 Capstone2LlvmIrTranslatorArm64_impl::_i2fm =
+makeInsnTranslationTable<_translator_table>(
 {
 	{ARM_INS_INVALID, nullptr},
 
@@ -2082,7 +2078,7 @@ Capstone2LlvmIrTranslatorArm64_impl::_i2fm =
 	{ARM64_INS_NGCS, &Capstone2LlvmIrTranslatorArm64_impl::translateNgc},
 
 	{ARM64_INS_ENDING, nullptr}
-};
+});
 
 } // namespace capstone2llvmir
 } // namespace retdec
@@ -58,6 +58,14 @@ void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::setGeneratePseudoAsmFunctio
 	_generatePseudoAsmFunctions = f;
 }
 
+template <typename CInsn, typename CInsnOp>
+void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::setInstructionArena(
+		std::shared_ptr<InsnArena> a)
+{
+	assert(a);
+	_insnArena = std::move(a);
+}
+
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isIgnoreUnexpectedOperands() const
 {
@@ -76,6 +84,13 @@ bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isGeneratePseudoAsmFunction
 	return _generatePseudoAsmFunctions;
 }
 
+template <typename CInsn, typename CInsnOp>
+const std::shared_ptr<InsnArena>&
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getInstructionArena() const
+{
+	return _insnArena;
+}
+
 //
 //==============================================================================
 // Mode query & modification methods - from Capstone2LlvmIrTranslator.
@@ -173,7 +188,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 	TranslationResult res;
 
 	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	cs_insn* insn = _insnArena->allocate();
 
 	uint64_t address = a;
 
@@ -211,7 +226,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 			return res;
 		}
 
-		insn = cs_malloc(_handle);
+		insn = _insnArena->allocate();
 
 		// TODO: hack, solve better.
 		disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
@@ -223,7 +238,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 		}
 	}
 
-	cs_free(insn, 1);
+	_insnArena->deallocateLast();
 
 	return res;
 }
@@ -239,11 +254,9 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 	TranslationResultOne res;
 
 	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	cs_insn* insn = _insnArena->allocate();
 
 	uint64_t address = a;
-	_branchGenerated = nullptr;
-	_inCondition = false;
 
 	// TODO: hack, solve better.
 	bool disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
@@ -256,25 +269,54 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 
 	if (disasmRes)
 	{
-		auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
-		translateInstruction(insn, irb);
-
-		res.llvmInsn = a2l;
-		res.capstoneInsn = insn;
-		res.size = insn->size;
-		res.branchCall = _branchGenerated;
-		res.inCondition = _inCondition;
-
+		res = translateDisassembled(insn, irb);
 		a = address;
 	}
 	else
 	{
-		cs_free(insn, 1);
+		_insnArena->deallocateLast();
 	}
 
 	return res;
 }
 
+template <typename CInsn, typename CInsnOp>
+typename Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::TranslationResultOne
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
+		const cs_insn& i,
+		llvm::IRBuilder<>& irb)
+{
+	// We want to keep all Capstone instructions -> alloc a new one each time.
+	return translateDisassembled(_insnArena->allocate(i), irb);
+}
+
+/**
+ * Translate the already disassembled instruction @a insn, which must be owned
+ * by @c _insnArena.
+ */
+template <typename CInsn, typename CInsnOp>
+typename Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::TranslationResultOne
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateDisassembled(
+		cs_insn* insn,
+		llvm::IRBuilder<>& irb)
+{
+	TranslationResultOne res;
+
+	_branchGenerated = nullptr;
+	_inCondition = false;
+
+	auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
+	translateInstruction(insn, irb);
+
+	res.llvmInsn = a2l;
+	res.capstoneInsn = insn;
+	res.size = insn->size;
+	res.branchCall = _branchGenerated;
+	res.inCondition = _inCondition;
+
+	return res;
+}
+
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -8,12 +8,46 @@
 #ifndef CAPSTONE2LLVMIR_CAPSTONE2LLVMIR_IMPL_H
 #define CAPSTONE2LLVMIR_CAPSTONE2LLVMIR_IMPL_H
 
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
 #include "capstone2llvmir/llvmir_utils.h"
 #include "retdec/capstone2llvmir/capstone2llvmir.h"
 
 namespace retdec {
 namespace capstone2llvmir {
 
+/**
+ * Create a table of translation functions indexed by Capstone instruction IDs
+ * from pairs <instruction ID, translation function>.
+ *
+ * Instructions not present in @a fncs are mapped to @c nullptr. If an ID is
+ * present more than once, its first function is used (the same as if the pairs
+ * were inserted into @c std::map). IDs out of the table range are ignored.
+ *
+ * Translation of an instruction is then just an array access instead of a map
+ * lookup, and the table can be created at compile time.
+ */
+template <typename Table>
+constexpr Table makeInsnTranslationTable(
+		std::initializer_list<
+				std::pair<std::size_t, typename Table::value_type>> fncs)
+{
+	Table ret{};
+	std::array<bool, std::tuple_size<Table>::value> set{};
+	for (auto& p : fncs)
+	{
+		if (p.first < ret.size() && !set[p.first])
+		{
+			ret[p.first] = p.second;
+			set[p.first] = true;
+		}
+	}
+	return ret;
+}
+
 /**
  * Private implementation class.
  *
@@ -45,10 +79,12 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 		virtual void setIgnoreUnexpectedOperands(bool f) override;
 		virtual void setIgnoreUnhandledInstructions(bool f) override;
 		virtual void setGeneratePseudoAsmFunctions(bool f) override;
+		virtual void setInstructionArena(std::shared_ptr<InsnArena> a) override;
 
 		virtual bool isIgnoreUnexpectedOperands() const override;
 		virtual bool isIgnoreUnhandledInstructions() const override;
 		virtual bool isGeneratePseudoAsmFunctions() const override;
+		virtual const std::shared_ptr<InsnArena>& getInstructionArena() const override;
 //
 //==============================================================================
 // Mode query & modification methods - from Capstone2LlvmIrTranslator.
@@ -77,6 +113,14 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) override;
+		virtual TranslationResultOne translateOne(
+				const cs_insn& insn,
+				llvm::IRBuilder<>& irb) override;
+
+	private:
+		TranslationResultOne translateDisassembled(
+				cs_insn* insn,
+				llvm::IRBuilder<>& irb);
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -663,6 +707,9 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 		/// Capstone instruction being currently translated.
 		cs_insn* _insn = nullptr;
 
+		/// Translated Capstone instructions are allocated here.
+		std::shared_ptr<InsnArena> _insnArena = std::make_shared<InsnArena>();
+
 		/// Set of Capstone instruction IDs translation of which would produce
 		/// call pseudo call.
 		std::set<unsigned int> _callInsnIds;
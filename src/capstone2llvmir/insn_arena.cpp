@@ -0,0 +1,134 @@
+/**
+ * @file src/capstone2llvmir/insn_arena.cpp
+ * @brief Storage of Capstone instructions kept after their translation.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cassert>
+
+#include "retdec/capstone2llvmir/insn_arena.h"
+
+namespace retdec {
+namespace capstone2llvmir {
+
+/**
+ * @param slabSize Number of instructions allocated at once.
+ */
+InsnArena::InsnArena(std::size_t slabSize) :
+		_slabSize(slabSize ? slabSize : 1)
+{
+
+}
+
+/**
+ * Allocate a new instruction with details. Content of the instruction is
+ * undefined, it is meant to be filled by @c cs_disasm_iter().
+ */
+cs_insn* InsnArena::allocate()
+{
+	std::size_t slabIdx = _size / _slabSize;
+	std::size_t idx = _size % _slabSize;
+	if (slabIdx == _slabs.size())
+	{
+		// Not value-initialized: disassembler overwrites everything anyway,
+		// and untouched memory of the last slab is not committed.
+		Slab s;
+		s.insns.reset(new cs_insn[_slabSize]);
+		_slabs.push_back(std::move(s));
+	}
+
+	auto& slab = _slabs[slabIdx];
+	if (slab.details == nullptr)
+	{
+		slab.details.reset(new cs_detail[_slabSize]);
+	}
+
+	cs_insn* insn = &slab.insns[idx];
+	insn->detail = &slab.details[idx];
+	++_size;
+	return insn;
+}
+
+/**
+ * Allocate a new instruction as a copy of @a insn (including its details).
+ */
+cs_insn* InsnArena::allocate(const cs_insn& insn)
+{
+	cs_insn* ret = allocate();
+	cs_detail* detail = ret->detail;
+	*ret = insn;
+	ret->detail = detail;
+	if (insn.detail)
+	{
+		*ret->detail = *insn.detail;
+	}
+	return ret;
+}
+
+/**
+ * Return the last allocated instruction back to the arena, e.g. when its
+ * disassembly failed.
+ */
+void InsnArena::deallocateLast()
+{
+	assert(_size > 0);
+	if (_size > 0)
+	{
+		--_size;
+	}
+}
+
+/**
+ * Free details of all the allocated instructions. Their @c detail members are
+ * set to @c nullptr, everything else is kept. This is useful when the details
+ * are no longer needed, because they take most of the memory.
+ */
+void InsnArena::releaseDetails()
+{
+	for (std::size_t i = 0; i < _size; ++i)
+	{
+		_slabs[i / _slabSize].insns[i % _slabSize].detail = nullptr;
+	}
+	for (auto& s : _slabs)
+	{
+		s.details.reset();
+	}
+}
+
+/**
+ * Free all the allocated instructions.
+ */
+void InsnArena::clear()
+{
+	_slabs.clear();
+	_size = 0;
+}
+
+/**
+ * @return Number of allocated instructions.
+ */
+std::size_t InsnArena::size() const
+{
+	return _size;
+}
+
+/**
+ * @return Number of bytes taken by the instructions and their details,
+ * including the yet unused part of the last slab.
+ */
+std::size_t InsnArena::getMemoryUsage() const
+{
+	std::size_t ret = 0;
+	for (auto& s : _slabs)
+	{
+		ret += _slabSize * sizeof(cs_insn);
+		if (s.details)
+		{
+			ret += _slabSize * sizeof(cs_detail);
+		}
+	}
+	return ret;
+}
+
+} // namespace capstone2llvmir
+} // namespace retdec
@@ -167,10 +167,9 @@ void Capstone2LlvmIrTranslatorMips_impl::translateInstruction(
 	cs_detail* d = i->detail;
 	cs_mips* mi = &d->mips;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	if (i->id < _i2fm.size() && _i2fm[i->id] != nullptr)
 	{
-		auto f = fIt->second;
+		auto f = _i2fm[i->id];
 		(this->*f)(i, mi, irb);
 	}
 	else
@@ -106,12 +106,13 @@ class Capstone2LlvmIrTranslatorMips_impl :
 //==============================================================================
 //
 	protected:
-		static std::map<
-			std::size_t,
-			void (Capstone2LlvmIrTranslatorMips_impl::*)(
-					cs_insn* i,
-					cs_mips*,
-					llvm::IRBuilder<>&)> _i2fm;
+		using _translator_fnc = void (Capstone2LlvmIrTranslatorMips_impl::*)(
+				cs_insn* i,
+				cs_mips*,
+				llvm::IRBuilder<>&);
+		/// Capstone instruction IDs to their translation functions.
+		using _translator_table = std::array<_translator_fnc, MIPS_INS_ENDING>;
+		static const _translator_table _i2fm;
 //
 //==============================================================================
 // MIPS instruction translation methods.
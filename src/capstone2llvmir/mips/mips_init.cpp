@@ -317,13 +317,9 @@ void Capstone2LlvmIrTranslatorMips_impl::initializePseudoCallInstructionIDs()
 //==============================================================================
 //
 
-std::map<
-	std::size_t,
-	void (Capstone2LlvmIrTranslatorMips_impl::*)(
-			cs_insn* i,
-			cs_mips*,
-			llvm::IRBuilder<>&)>
+const Capstone2LlvmIrTranslatorMips_impl::_translator_table
 Capstone2LlvmIrTranslatorMips_impl::_i2fm =
+makeInsnTranslationTable<_translator_table>(
 {
 		{MIPS_INS_INVALID, nullptr},
 
@@ -960,7 +956,7 @@ Capstone2LlvmIrTranslatorMips_impl::_i2fm =
 		{MIPS_INS_JR_HB, nullptr}, // jump register with Hazard Barrier
 
 		{MIPS_INS_ENDING, nullptr},
-};
+});
 
 } // namespace capstone2llvmir
 } // namespace retdec
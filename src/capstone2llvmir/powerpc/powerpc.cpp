@@ -106,10 +106,9 @@ void Capstone2LlvmIrTranslatorPowerpc_impl::translateInstruction(
 	cs_detail* d = i->detail;
 	cs_ppc* pi = &d->ppc;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	if (i->id < _i2fm.size() && _i2fm[i->id] != nullptr)
 	{
-		auto f = fIt->second;
+		auto f = _i2fm[i->id];
 		(this->*f)(i, pi, irb);
 	}
 	else
@@ -497,13 +497,9 @@ void Capstone2LlvmIrTranslatorPowerpc_impl::initializePseudoCallInstructionIDs()
 //==============================================================================
 //
 
-std::map<
-	std::size_t,
-	void (Capstone2LlvmIrTranslatorPowerpc_impl::*)(
-			cs_insn* i,
-			cs_ppc*,
-			llvm::IRBuilder<>&)>
+const Capstone2LlvmIrTranslatorPowerpc_impl::_translator_table
 Capstone2LlvmIrTranslatorPowerpc_impl::_i2fm =
+makeInsnTranslationTable<_translator_table>(
 {
 		{PPC_INS_INVALID, nullptr},
 
@@ -1650,7 +1646,7 @@ Capstone2LlvmIrTranslatorPowerpc_impl::_i2fm =
 		{PPC_INS_BDZFLRL, &Capstone2LlvmIrTranslatorPowerpc_impl::translateB},
 
 		{PPC_INS_BCT, nullptr},
-};
+});
 
 } // namespace capstone2llvmir
 } // namespace retdec
@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <chrono>
 #include <iomanip>
 
 #include <keystone/keystone.h>
@@ -108,6 +109,15 @@ class ProgramOptions
 				{
 					outFile = getParamOrDie(argc, argv, i);
 				}
+				else if (c == "-n")
+				{
+					_iterations = getParamOrDie(argc, argv, i);
+					if (!retdec::utils::strToNum(_iterations, iterations)
+							|| iterations == 0)
+					{
+						printHelpAndDie();
+					}
+				}
 				else if (c == "-h")
 				{
 					printHelpAndDie();
@@ -170,6 +180,7 @@ class ProgramOptions
 			Log::info() << "\t" << "b mode : " << std::hex << basicMode << " (" << _basicMode << ")" << std::endl;
 			Log::info() << "\t" << "e mode : " << std::hex << extraMode << " (" << _extraMode << ")" << std::endl;
 			Log::info() << "\t" << "out    : " << outFile << std::endl;
+			Log::info() << "\t" << "iters  : " << std::dec << iterations << std::endl;
 			Log::info() << std::endl;
 		}
 
@@ -198,7 +209,10 @@ class ProgramOptions
 				"\t          Possible values: little, big, micro, mclass, v8, v9.\n"
 				"\t          Default value: little.\n"
 				"\t-o out    Output file name where LLVM IR will be generated.\n"
-				"\t          Default value: stdout\n";
+				"\t          Default value: stdout\n"
+				"\t-n count  Translate the code count times and print the\n"
+				"\t          translation throughput (instructions per second).\n"
+				"\t          Default value: 0 (no benchmark).\n";
 
 			exit(0);
 		}
@@ -211,6 +225,7 @@ class ProgramOptions
 		cs_mode basicMode = CS_MODE_32;
 		cs_mode extraMode = CS_MODE_LITTLE_ENDIAN;
 		std::string outFile = "-"; // "-" == stdout for llvm::raw_fd_ostream.
+		unsigned iterations = 0;
 
 	private:
 		std::string _programName = "capstone2llvmir";
@@ -219,6 +234,7 @@ class ProgramOptions
 		std::string _code;
 		std::string _basicMode;
 		std::string _extraMode;
+		std::string _iterations;
 		bool _useDefaultBasicMode = true;
 };
 
@@ -379,6 +395,53 @@ void assemble(ProgramOptions& po)
 
 using namespace retdec::capstone2llvmir;
 
+/**
+ * Translate the code @c po.iterations times and print the number of translated
+ * instructions per second. Every iteration translates into its own function,
+ * which is erased afterwards together with the translated instructions, so
+ * that the module does not grow and only the translation itself is measured.
+ */
+void benchmark(
+		Capstone2LlvmIrTranslator& c2l,
+		llvm::Module& module,
+		const ProgramOptions& po)
+{
+	std::size_t insns = 0;
+	std::chrono::steady_clock::duration time{};
+	for (unsigned i = 0; i < po.iterations; ++i)
+	{
+		auto* f = llvm::Function::Create(
+				llvm::FunctionType::get(
+						llvm::Type::getVoidTy(module.getContext()),
+						false),
+				llvm::GlobalValue::ExternalLinkage,
+				"benchmark",
+				&module);
+		llvm::BasicBlock::Create(module.getContext(), "entry", f);
+		llvm::IRBuilder<> irb(&f->front());
+		irb.SetInsertPoint(irb.CreateRetVoid());
+
+		auto start = std::chrono::steady_clock::now();
+		auto res = c2l.translate(po.code.data(), po.code.size(), po.base, irb);
+		time += std::chrono::steady_clock::now() - start;
+		insns += res.count;
+
+		f->eraseFromParent();
+		c2l.getInstructionArena()->clear();
+	}
+
+	double seconds = std::chrono::duration<double>(time).count();
+	Log::info() << std::endl;
+	Log::info() << "Benchmark: " << std::dec << insns << " instructions in "
+			<< po.iterations << " iterations, " << seconds << " s";
+	if (seconds > 0.0)
+	{
+		Log::info() << ", " << static_cast<std::size_t>(insns / seconds)
+				<< " instructions/s";
+	}
+	Log::info() << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
 	ProgramOptions po(argc, argv);
@@ -412,6 +475,11 @@ int main(int argc, char *argv[])
 				po.basicMode,
 				po.extraMode);
 		c2l->translate(po.code.data(), po.code.size(), po.base, irb);
+
+		if (po.iterations)
+		{
+			benchmark(*c2l, module, po);
+		}
 	}
 	catch (const BaseError& e)
 	{
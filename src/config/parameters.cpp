@@ -39,15 +39,18 @@ const std::string JSON_outputAsmFile            = "outputAsmFile";
 const std::string JSON_outputLlFile             = "outputLlFile";
 const std::string JSON_outputConfigFile         = "outputConfigFile";
 const std::string JSON_outputUnpackedFile       = "outputUnpackedFile";
+const std::string JSON_outputProfileFile        = "outputProfileFile";
 const std::string JSON_outputFormat             = "outputFormat";
 const std::string JSON_logFile                  = "logFile";
 const std::string JSON_errFile                  = "errFile";
+const std::string JSON_cacheDirectory           = "cacheDirectory";
 
 const std::string JSON_detectStaticCode         = "detectStaticCode";
 const std::string JSON_backendDisabledOpts      = "backendDisabledOpts";
 const std::string JSON_backendEnabledOpts       = "backendEnabledOpts";
 const std::string JSON_backendCallInfoObtainer  = "backendCallInfoObtainer";
 const std::string JSON_backendVarRenamer        = "backendVarRenamer";
+const std::string JSON_backendThreads           = "backendThreads";
 const std::string JSON_backendNoOpts            = "backendNoOpts";
 const std::string JSON_backendEmitCfg           = "backendEmitCfg";
 const std::string JSON_backendEmitCg            = "backendEmitCg";
@@ -59,8 +62,11 @@ const std::string JSON_backendNoCompoundOperators = "backendNoCompoundOperators"
 const std::string JSON_backendNoSymbolicNames   = "backendNoSymbolicNames";
 
 const std::string JSON_timeout                  = "timeout";
+const std::string JSON_decoderTimeout           = "decoderTimeout";
+const std::string JSON_backendOptsTimeout       = "backendOptsTimeout";
 const std::string JSON_maxMemoryLimit           = "maxMemoryLimit";
 const std::string JSON_maxMemoryLimitHalfRam    = "maxMemoryLimitHalfRam";
+const std::string JSON_maxMemorySoftLimit       = "maxMemorySoftLimit";
 
 } // anonymous namespace
 
@@ -206,6 +212,11 @@ void Parameters::setOutputUnpackedFile(const std::string& file)
 	_outputUnpackedFile = file;
 }
 
+void Parameters::setOutputProfileFile(const std::string& file)
+{
+	_outputProfileFile = file;
+}
+
 void Parameters::setOutputFormat(const std::string& format)
 {
 	_outputFormat = format;
@@ -221,6 +232,11 @@ void Parameters::setErrFile(const std::string &file)
 	_errFile = file;
 }
 
+void Parameters::setCacheDirectory(const std::string& dir)
+{
+	_cacheDirectory = dir;
+}
+
 void Parameters::setOrdinalNumbersDirectory(const std::string& n)
 {
 	_ordinalNumbersDirectory = n;
@@ -246,11 +262,26 @@ void Parameters::setIsMaxMemoryLimitHalfRam(bool f)
 	_maxMemoryLimitHalfRam = f;
 }
 
+void Parameters::setMaxMemorySoftLimit(uint64_t limit)
+{
+	_maxMemorySoftLimit = limit;
+}
+
 void Parameters::setTimeout(uint64_t seconds)
 {
 	_timeout = seconds;
 }
 
+void Parameters::setDecoderTimeout(uint64_t seconds)
+{
+	_decoderTimeout = seconds;
+}
+
+void Parameters::setBackendOptsTimeout(uint64_t seconds)
+{
+	_backendOptsTimeout = seconds;
+}
+
 void Parameters::setEntryPoint(const retdec::common::Address& a)
 {
 	_entryPoint = a;
@@ -285,6 +316,11 @@ void Parameters::setBackendVarRenamer(const std::string& val)
 	_backendVarRenamer = val;
 }
 
+void Parameters::setBackendThreads(uint64_t n)
+{
+	_backendThreads = n;
+}
+
 void Parameters::setIsBackendNoOpts(bool b)
 {
 	_backendNoOpts = b;
@@ -380,6 +416,11 @@ const std::string& Parameters::getOutputUnpackedFile() const
 	return _outputUnpackedFile;
 }
 
+const std::string& Parameters::getOutputProfileFile() const
+{
+	return _outputProfileFile;
+}
+
 const std::string& Parameters::getOutputFormat() const
 {
 	return _outputFormat;
@@ -395,16 +436,36 @@ const std::string& Parameters::getErrFile() const
 	return _errFile;
 }
 
+const std::string& Parameters::getCacheDirectory() const
+{
+	return _cacheDirectory;
+}
+
 uint64_t Parameters::getMaxMemoryLimit() const
 {
 	return _maxMemoryLimit;
 }
 
+uint64_t Parameters::getMaxMemorySoftLimit() const
+{
+	return _maxMemorySoftLimit;
+}
+
 uint64_t Parameters::getTimeout() const
 {
 	return _timeout;
 }
 
+uint64_t Parameters::getDecoderTimeout() const
+{
+	return _decoderTimeout;
+}
+
+uint64_t Parameters::getBackendOptsTimeout() const
+{
+	return _backendOptsTimeout;
+}
+
 retdec::common::Address Parameters::getEntryPoint() const
 {
 	return _entryPoint;
@@ -440,6 +501,11 @@ const std::string& Parameters::getBackendVarRenamer() const
 	return _backendVarRenamer;
 }
 
+uint64_t Parameters::getBackendThreads() const
+{
+	return _backendThreads;
+}
+
 void fixPath(std::string& path, fs::path root)
 {
 	fs::path p(path);
@@ -496,14 +562,17 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeString(writer, JSON_outputLlFile, getOutputLlvmirFile());
 	serdes::serializeString(writer, JSON_outputConfigFile, getOutputConfigFile());
 	serdes::serializeString(writer, JSON_outputUnpackedFile, getOutputUnpackedFile());
+	serdes::serializeString(writer, JSON_outputProfileFile, getOutputProfileFile());
 	serdes::serializeString(writer, JSON_outputFormat, getOutputFormat());
 	serdes::serializeString(writer, JSON_logFile, getLogFile());
 	serdes::serializeString(writer, JSON_errFile, getErrFile());
+	serdes::serializeString(writer, JSON_cacheDirectory, getCacheDirectory());
 
 	serdes::serializeString(writer, JSON_backendDisabledOpts, getBackendDisabledOpts());
 	serdes::serializeString(writer, JSON_backendEnabledOpts, getBackendEnabledOpts());
 	serdes::serializeString(writer, JSON_backendCallInfoObtainer, getBackendCallInfoObtainer());
 	serdes::serializeString(writer, JSON_backendVarRenamer, getBackendVarRenamer());
+	serdes::serializeUint64(writer, JSON_backendThreads, getBackendThreads());
 	serdes::serializeBool(writer, JSON_backendNoOpts, isBackendNoOpts());
 	serdes::serializeBool(writer, JSON_backendEmitCfg, isBackendEmitCfg());
 	serdes::serializeBool(writer, JSON_backendEmitCg, isBackendEmitCg());
@@ -516,8 +585,11 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_backendNoSymbolicNames, isBackendNoSymbolicNames());
 
 	serdes::serializeUint64(writer, JSON_timeout, getTimeout());
+	serdes::serializeUint64(writer, JSON_decoderTimeout, getDecoderTimeout());
+	serdes::serializeUint64(writer, JSON_backendOptsTimeout, getBackendOptsTimeout());
 	serdes::serializeUint64(writer, JSON_maxMemoryLimit, getMaxMemoryLimit());
 	serdes::serializeBool(writer, JSON_maxMemoryLimitHalfRam, isMaxMemoryLimitHalfRam());
+	serdes::serializeUint64(writer, JSON_maxMemorySoftLimit, getMaxMemorySoftLimit());
 
 	serdes::serializeContainer(writer, JSON_selectedRanges, selectedRanges);
 	serdes::serializeContainer(writer, JSON_userStaticSigPaths, userStaticSignaturePaths);
@@ -564,15 +636,18 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setOutputLlvmirFile( serdes::deserializeString(val, JSON_outputLlFile) );
 	setOutputConfigFile( serdes::deserializeString(val, JSON_outputConfigFile) );
 	setOutputUnpackedFile( serdes::deserializeString(val, JSON_outputUnpackedFile) );
+	setOutputProfileFile( serdes::deserializeString(val, JSON_outputProfileFile) );
 	setOutputFormat( serdes::deserializeString(val, JSON_outputFormat) );
 	setLogFile( serdes::deserializeString(val, JSON_logFile) );
 	setErrFile( serdes::deserializeString(val, JSON_errFile) );
+	setCacheDirectory( serdes::deserializeString(val, JSON_cacheDirectory) );
 
 	setIsDetectStaticCode( serdes::deserializeBool(val, JSON_detectStaticCode, true) );
 	setBackendDisabledOpts( serdes::deserializeString(val, JSON_backendDisabledOpts) );
 	setBackendEnabledOpts( serdes::deserializeString(val, JSON_backendEnabledOpts) );
 	setBackendCallInfoObtainer( serdes::deserializeString(val, JSON_backendCallInfoObtainer, "optim") );
 	setBackendVarRenamer( serdes::deserializeString(val, JSON_backendVarRenamer, "readable") );
+	setBackendThreads( serdes::deserializeUint64(val, JSON_backendThreads, 1) );
 	setIsBackendNoOpts( serdes::deserializeBool(val, JSON_backendNoOpts, false) );
 	setIsBackendEmitCfg( serdes::deserializeBool(val, JSON_backendEmitCfg, false) );
 	setIsBackendEmitCg( serdes::deserializeBool(val, JSON_backendEmitCg, false) );
@@ -584,8 +659,11 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsBackendNoSymbolicNames( serdes::deserializeBool(val, JSON_backendNoSymbolicNames, false) );
 
 	setTimeout( serdes::deserializeUint64(val, JSON_timeout, 0) );
+	setDecoderTimeout( serdes::deserializeUint64(val, JSON_decoderTimeout, 0) );
+	setBackendOptsTimeout( serdes::deserializeUint64(val, JSON_backendOptsTimeout, 0) );
 	setMaxMemoryLimit( serdes::deserializeUint64(val, JSON_maxMemoryLimit, 0) );
 	setIsMaxMemoryLimitHalfRam( serdes::deserializeBool(val, JSON_maxMemoryLimitHalfRam, true) );
+	setMaxMemorySoftLimit( serdes::deserializeUint64(val, JSON_maxMemorySoftLimit, 0) );
 
 	serdes::deserialize(val, JSON_entryPoint, _entryPoint);
 	serdes::deserialize(val, JSON_mainAddress, _mainAddress);
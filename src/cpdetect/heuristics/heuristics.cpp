@@ -690,16 +690,15 @@ void Heuristics::getDwarfInfo()
 	std::vector<std::string> languages;
 	std::vector<std::size_t> modulesCounter;
 
-	// Open input file as buffer.
+	// Use already loaded input file content as buffer.
 	//
-	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffOrErr =
-			llvm::MemoryBuffer::getFileOrSTDIN(fileParser.getPathToFile());
-	if (buffOrErr.getError())
-	{
-		return;
-	}
-	std::unique_ptr<llvm::MemoryBuffer> bufferPtr = std::move(buffOrErr.get());
-	llvm::MemoryBufferRef buffer = *bufferPtr;
+	const auto& bytes = fileParser.getBytes();
+	std::string path = fileParser.getPathToFile();
+	llvm::MemoryBufferRef buffer(
+			llvm::StringRef(
+					reinterpret_cast<const char*>(bytes.data()),
+					bytes.size()),
+			path);
 
 	// Open buffer as a binary file.
 	//
@@ -955,7 +954,7 @@ std::string Heuristics::getUpxVersion()
 		const std::size_t versionLen = 4;
 		if (pos <= content.length() - pattern.length() - versionLen)
 		{
-			return content.substr(pos + pattern.length(), versionLen);
+			return std::string(content.substr(pos + pattern.length(), versionLen));
 		}
 	}
 
@@ -5,6 +5,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 
 #include "retdec/utils/container.h"
@@ -48,8 +49,14 @@ Search::Search(retdec::fileformat::FileFormat &fileParser)
 		, averageSlashLen(0)
 {
 	const auto &bytes = parser.getLoadedBytes();
-	bytesToHexString(bytes, nibbles);
-	bytesToString(bytes, plain);
+	plain = std::string_view(
+			reinterpret_cast<const char*>(bytes.data()),
+			bytes.size());
+	// Nibbles of other than big endian files are read directly from bytes
+	if (parser.isBigEndian())
+	{
+		bytesToHexString(bytes, nibbles);
+	}
 	fileLoaded = !bytes.empty();
 	fileSupported = parser.hexToLittle(nibbles)
 			&& parser.getNumberOfNibblesInByte();
@@ -145,6 +152,175 @@ std::size_t Search::bytesFromNibbles(std::size_t nNibbles) const
 	return parser.bytesFromNibbles(nNibbles);
 }
 
+/**
+ * Get number of nibbles in hexadecimal representation of file content
+ */
+std::size_t Search::getNibblesLength() const
+{
+	return nibbles.empty() ? 2 * plain.length() : nibbles.length();
+}
+
+/**
+ * Get nibble from hexadecimal representation of file content
+ * @param index Index of nibble
+ * @return Nibble as an uppercase hexadecimal digit
+ */
+char Search::getNibble(std::size_t index) const
+{
+	if (!nibbles.empty())
+	{
+		return nibbles[index];
+	}
+
+	const auto byte = static_cast<unsigned char>(plain[index / 2]);
+	return "0123456789ABCDEF"[index % 2 ? byte & 0x0F : byte >> 4];
+}
+
+/**
+ * Check if hexadecimal representation of file content contains @a str
+ * on nibble offset @a position
+ */
+bool Search::hasNibblesOnPosition(
+		const std::string &str,
+		std::size_t position) const
+{
+	const auto nibblesLen = getNibblesLength();
+	if (position >= nibblesLen || nibblesLen - position < str.length())
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0, e = str.length(); i < e; ++i)
+	{
+		if (getNibble(position + i) != str[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check if signature pattern @a signPattern (without slashes) is present
+ * in hexadecimal representation of file content in selected area
+ * @param signPattern Signature pattern
+ * @param startNibble Start nibble offset of area
+ * @param stopNibble End nibble offset of area (exclusive)
+ * @return @c true if pattern is present in area, @c false otherwise
+ *
+ * Wildcards @c -, @c ? and @c ; match any nibble. Pattern may start on any
+ * nibble, not only on a byte boundary.
+ */
+bool Search::findNibblesInContent(
+		const std::string &signPattern,
+		std::size_t startNibble,
+		std::size_t stopNibble) const
+{
+	const auto len = signPattern.length();
+	if (!len || startNibble >= stopNibble || stopNibble - startNibble < len)
+	{
+		return false;
+	}
+
+	// Swapped nibbles of big endian files are compared as characters
+	if (parser.isBigEndian())
+	{
+		const auto stopIterator = nibbles.begin() + stopNibble;
+		return std::search(
+				nibbles.begin() + startNibble,
+				stopIterator,
+				signPattern.begin(),
+				signPattern.end(),
+				[] (const char fileNibble, const char signatureNibble)
+				{
+					return fileNibble == signatureNibble
+							|| signatureNibble == '-'
+							|| signatureNibble == '?'
+							|| signatureNibble == ';';
+				}
+		) != stopIterator;
+	}
+
+	// Otherwise, the pattern is compiled into values and masks of bytes
+	// (for pattern starting on even and odd nibble), so that the file
+	// content is compared by bytes without its conversion to nibbles.
+	const auto *data = reinterpret_cast<const std::uint8_t*>(plain.data());
+	for (std::size_t alignment = 0; alignment < 2; ++alignment)
+	{
+		if (stopNibble < len + alignment)
+		{
+			continue;
+		}
+
+		const auto patternBytes = (alignment + len + 1) / 2;
+		std::vector<std::uint8_t> values(patternBytes), masks(patternBytes);
+		for (std::size_t i = 0; i < len; ++i)
+		{
+			const auto c = signPattern[i];
+			std::uint8_t value = 0;
+			if (c == '-' || c == '?' || c == ';')
+			{
+				continue;
+			}
+			else if (c >= '0' && c <= '9')
+			{
+				value = c - '0';
+			}
+			else if (c >= 'A' && c <= 'F')
+			{
+				value = c - 'A' + 10;
+			}
+			else
+			{
+				// Nothing else is present in nibbles of file.
+				return false;
+			}
+
+			const auto pos = alignment + i;
+			const auto shift = pos % 2 ? 0 : 4;
+			values[pos / 2] |= value << shift;
+			masks[pos / 2] |= 0x0F << shift;
+		}
+
+		// Candidates are found by a fully specified byte, if there is one.
+		const auto anchor = static_cast<std::size_t>(
+				std::find(masks.begin(), masks.end(), 0xFF) - masks.begin());
+		const auto first = startNibble > alignment
+				? (startNibble - alignment + 1) / 2
+				: 0;
+		const auto last = (stopNibble - len - alignment) / 2;
+		for (auto b = first; b <= last; ++b)
+		{
+			if (anchor < patternBytes)
+			{
+				const auto *found = static_cast<const std::uint8_t*>(
+						std::memchr(
+								data + b + anchor,
+								values[anchor],
+								last - b + 1));
+				if (!found)
+				{
+					break;
+				}
+				b = found - data - anchor;
+			}
+
+			std::size_t i = 0;
+			while (i < patternBytes && (data[b + i] & masks[i]) == values[i])
+			{
+				++i;
+			}
+			if (i == patternBytes)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 /**
  * Check if input file was successfully loaded
  * @return @c true if file was successfully loaded, @c false otherwise
@@ -166,9 +342,17 @@ bool Search::isFileSupported() const
 /**
  * Get content of file in hexadecimal string representation
  * @return Content of file in hexadecimal string representation
+ *
+ * The representation is created on the first call of this method (unless it
+ * was needed for the search itself), prefer other methods of this class.
  */
 const std::string& Search::getNibbles() const
 {
+	if (nibbles.empty() && !plain.empty())
+	{
+		bytesToHexString(parser.getLoadedBytes(), nibbles);
+	}
+
 	return nibbles;
 }
 
@@ -176,7 +360,7 @@ const std::string& Search::getNibbles() const
  * Get content of file as plain string
  * @return Content of file as plain string
  */
-const std::string& Search::getPlainString() const
+std::string_view Search::getPlainString() const
 {
 	return plain;
 }
@@ -201,9 +385,9 @@ const Search::RelativeJump* Search::getRelativeJump(
 	for (const auto &jump : jumps)
 	{
 		const auto nibblesAfter = nibblesFromBytes(jump.getBytesAfter());
-		if (!hasSubstringOnPosition(nibbles, jump.getSlash(), nibbleOffset)
+		if (!hasNibblesOnPosition(jump.getSlash(), nibbleOffset)
 				|| (nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1
-						>= nibbles.length()))
+						>= getNibblesLength()))
 		{
 			continue;
 		}
@@ -287,26 +471,13 @@ unsigned long long Search::findUnslashedSignature(
 		return 0;
 	}
 
-	const auto startIterator = nibbles.begin() + nibblesFromBytes(startOffset);
-	const auto stopIndex = nibblesFromBytes(stopOffset) + 1;
-	const auto stopIterator = stopIndex < nibbles.size()
-			? nibbles.begin() + stopIndex
-			: nibbles.end();
-	const auto it = std::search(
-			startIterator,
-			stopIterator,
-			signPattern.begin(),
-			signPattern.end(),
-			[] (const char fileNibble, const char signatureNibble)
-			{
-				return fileNibble == signatureNibble
-						|| signatureNibble == '-'
-						|| signatureNibble == '?'
-						|| signatureNibble == ';';
-			}
-	);
-
-	return (it != stopIterator) ? countImpNibbles(signPattern) : 0;
+	const auto stopIndex = std::min(
+			nibblesFromBytes(stopOffset) + 1,
+			getNibblesLength());
+	return findNibblesInContent(
+			signPattern,
+			nibblesFromBytes(startOffset),
+			stopIndex) ? countImpNibbles(signPattern) : 0;
 }
 
 /**
@@ -363,7 +534,7 @@ unsigned long long Search::exactComparison(
 {
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNibblesLength()
 			;
 			fileIndex < fileLen
 			;
@@ -398,7 +569,7 @@ unsigned long long Search::exactComparison(
 					+ moveSize
 					- 1;
 		}
-		else if (signPattern[sigIndex] != nibbles[fileIndex]
+		else if (signPattern[sigIndex] != getNibble(fileIndex)
 				&& signPattern[sigIndex] != '-'
 				&& signPattern[sigIndex] != '?')
 		{
@@ -430,7 +601,7 @@ bool Search::countSimilarity(
 
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNibblesLength()
 			;
 			fileIndex < fileLen
 			;
@@ -475,7 +646,7 @@ bool Search::countSimilarity(
 			}
 			continue;
 		}
-		else if (signPattern[sigIndex] == nibbles[fileIndex])
+		else if (signPattern[sigIndex] == getNibble(fileIndex))
 		{
 			++result.same;
 		}
@@ -551,7 +722,7 @@ bool Search::areaSimilarity(
  */
 bool Search::hasString(const std::string &str) const
 {
-	return contains(plain, str);
+	return plain.find(str) != std::string_view::npos;
 }
 
 /**
@@ -563,7 +734,9 @@ bool Search::hasString(const std::string &str) const
  */
 bool Search::hasString(const std::string &str, std::size_t fileOffset) const
 {
-	return hasSubstringOnPosition(plain, str, fileOffset);
+	return fileOffset < plain.length()
+			&& plain.length() - fileOffset >= str.length()
+			&& plain.compare(fileOffset, str.length(), str) == 0;
 }
 
 /**
@@ -579,7 +752,15 @@ bool Search::hasString(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	return hasSubstringInArea(plain, str, startOffset, stopOffset);
+	if (startOffset > stopOffset)
+	{
+		return false;
+	}
+
+	const auto stopIndex = std::min(stopOffset + 1, plain.length());
+	return startOffset < stopIndex
+			&& plain.substr(startOffset, stopIndex - startOffset).find(str)
+					!= std::string_view::npos;
 }
 
 /**
@@ -641,7 +822,7 @@ bool Search::createSignature(
 
 	for (std::size_t i = 0,
 			fileIndex = nibblesFromBytes(fileOffset),
-			fileLen = nibbles.length(),
+			fileLen = getNibblesLength(),
 			nibbleSize = nibblesFromBytes(size)
 			;
 			fileIndex < fileLen && i < nibbleSize
@@ -664,7 +845,7 @@ bool Search::createSignature(
 		}
 		else
 		{
-			pattern += nibbles[fileIndex];
+			pattern += getNibble(fileIndex);
 		}
 	}
 
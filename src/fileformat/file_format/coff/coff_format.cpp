@@ -283,6 +283,7 @@ void CoffFormat::initStructures()
 	{
 		fileFormat = Format::COFF;
 		loadSections();
+		indexSectionsAndSegments();
 		loadSymbols();
 		loadRelocations();
 		computeSectionTableHashes();
@@ -1122,7 +1122,10 @@ ElfFormat::ElfFormat(const std::uint8_t *data, std::size_t size, LoadFlags loadF
 void ElfFormat::initStructures()
 {
 	elfClass = ELFCLASSNONE;
-	if(!(stateIsValid = reader.load(fileStream)))
+	// Contents of sections and segments refer to the already loaded bytes
+	// instead of being copied by the reader
+	const auto *fileData = reinterpret_cast<const char*>(bytes.data());
+	if(!(stateIsValid = reader.load(fileStream, fileData, bytes.size())))
 	{
 		return;
 	}
@@ -1130,6 +1133,7 @@ void ElfFormat::initStructures()
 	elfClass = reader.get_class();
 	loadSections();
 	loadSegments();
+	indexSectionsAndSegments();
 	loadDynamicSegmentSection();
 
 	computeSectionTableHashes();
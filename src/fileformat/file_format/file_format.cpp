@@ -10,7 +10,10 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <limits>
+#include <set>
 #include <sstream>
+#include <tuple>
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/file_io.h"
@@ -21,7 +24,7 @@
 #include "retdec/fileformat/utils/byte_array_buffer.h"
 #include "retdec/fileformat/file_format/intel_hex/intel_hex_format.h"
 #include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
-#include "retdec/fileformat/types/strings/character_iterator.h"
+#include "retdec/fileformat/types/strings/string_scanner.h"
 #include "retdec/fileformat/utils/conversions.h"
 #include "retdec/fileformat/utils/crypto.h"
 #include "retdec/fileformat/utils/file_io.h"
@@ -111,6 +114,114 @@ bool isAddressFromRegion(const SecSeg *actualRegion, const SecSeg *newRegion, st
 	return false;
 }
 
+/**
+ * Build index of disjoint ranges of offsets or addresses. Every range is
+ * assigned to the region which the linear scan with @c isOffsetFromRegion()
+ * or @c isAddressFromRegion() selects: the region with the highest start
+ * among the regions containing the range, the smaller one if they start at
+ * the same place, and the first one in @a regions if they are the same.
+ * @param index Into this parameter is stored the built index
+ * @param regions Sections or segments
+ * @param getRange Function which stores start and size of region into its
+ *    second and third argument, or returns @c false if region is not to be indexed
+ */
+template <typename Entry, typename Region, typename GetRange>
+void buildRegionIndex(std::vector<Entry> &index, const std::vector<Region*> &regions, GetRange getRange)
+{
+	// (start, size, position in regions)
+	using Candidate = std::tuple<std::uint64_t, std::uint64_t, std::size_t>;
+	auto isPreferred = [](const Candidate &a, const Candidate &b)
+	{
+		if(std::get<0>(a) != std::get<0>(b))
+		{
+			return std::get<0>(a) > std::get<0>(b);
+		}
+
+		return std::tie(std::get<1>(a), std::get<2>(a)) < std::tie(std::get<1>(b), std::get<2>(b));
+	};
+
+	// (offset or address, is start, candidate)
+	std::vector<std::tuple<std::uint64_t, bool, Candidate>> bounds;
+	bounds.reserve(2 * regions.size());
+	for(std::size_t i = 0; i < regions.size(); ++i)
+	{
+		std::uint64_t start = 0, size = 0;
+		if(!getRange(regions[i], start, size))
+		{
+			continue;
+		}
+
+		// Region which overflows the address space is cut at its end
+		const auto end = start + std::min(size, std::numeric_limits<std::uint64_t>::max() - start);
+		if(start == end)
+		{
+			continue;
+		}
+
+		bounds.emplace_back(start, true, Candidate(start, size, i));
+		bounds.emplace_back(end, false, Candidate(start, size, i));
+	}
+	std::sort(bounds.begin(), bounds.end());
+
+	index.clear();
+	std::set<Candidate, decltype(isPreferred)> active(isPreferred);
+	for(std::size_t i = 0; i < bounds.size(); )
+	{
+		const auto position = std::get<0>(bounds[i]);
+		for(; i < bounds.size() && std::get<0>(bounds[i]) == position; ++i)
+		{
+			if(std::get<1>(bounds[i]))
+			{
+				active.insert(std::get<2>(bounds[i]));
+			}
+			else
+			{
+				active.erase(std::get<2>(bounds[i]));
+			}
+		}
+
+		if(active.empty() || i == bounds.size())
+		{
+			continue;
+		}
+
+		const SecSeg *region = regions[std::get<2>(*active.begin())];
+		const auto nextPosition = std::get<0>(bounds[i]);
+		if(!index.empty() && index.back().end == position && index.back().region == region)
+		{
+			index.back().end = nextPosition;
+		}
+		else
+		{
+			index.push_back({position, nextPosition, region});
+		}
+	}
+}
+
+/**
+ * Find region which contains @a position in index built by @c buildRegionIndex()
+ * @param index Index of regions
+ * @param position Offset or address
+ * @return Pointer to the region or @c nullptr if no region contains @a position
+ */
+template <typename Entry>
+const SecSeg* findInRegionIndex(const std::vector<Entry> &index, std::uint64_t position)
+{
+	auto itr = std::upper_bound(index.begin(), index.end(), position,
+		[](std::uint64_t pos, const Entry &entry)
+		{
+			return pos < entry.start;
+		}
+	);
+	if(itr == index.begin())
+	{
+		return nullptr;
+	}
+
+	--itr;
+	return position < itr->end ? itr->region : nullptr;
+}
+
 } // anonymous namespace
 
 /**
@@ -123,6 +234,7 @@ FileFormat::FileFormat(const std::string & pathToFile, LoadFlags loadFlags) :
 		auxIStream(&auxBuff),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
+		hasRegionIndex(false),
 		filePath(pathToFile),
 		fileStream(auxFStream),
 		_ldrErrInfo()
@@ -142,6 +254,7 @@ FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		auxIStream(&auxBuff),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
+		hasRegionIndex(false),
 		fileStream(inputStream),
 		_ldrErrInfo()
 {
@@ -160,6 +273,7 @@ FileFormat::FileFormat(const std::uint8_t *data, std::size_t size, LoadFlags loa
 		auxIStream(&auxBuff),
 		loadedBytes(&bytes),
 		loadFlags(loadFlags),
+		hasRegionIndex(false),
 		fileStream(auxIStream),
 		_ldrErrInfo()
 {
@@ -199,9 +313,7 @@ void FileFormat::init()
 	}
 	else
 	{
-		crc32 = retdec::fileformat::getCrc32(bytes.data(), bytes.size());
-		md5 = retdec::fileformat::getMd5(bytes.data(), bytes.size());
-		sha256 = retdec::fileformat::getSha256(bytes.data(), bytes.size());
+		retdec::fileformat::getCrc32Md5Sha256(bytes.data(), bytes.size(), crc32, md5, sha256);
 	}
 	initStream();
 }
@@ -263,6 +375,11 @@ void FileFormat::clear()
 
 	sections.clear();
 	segments.clear();
+	hasRegionIndex = false;
+	sectionOffsetIndex.clear();
+	segmentOffsetIndex.clear();
+	sectionAddressIndex.clear();
+	segmentAddressIndex.clear();
 	symbolTables.clear();
 	relocationTables.clear();
 	dynamicTables.clear();
@@ -316,12 +433,40 @@ void FileFormat::computeSectionTableHashes()
 
 	if(!data.empty())
 	{
-		sectionCrc32 = retdec::fileformat::getCrc32(data.data(), data.size());
-		sectionMd5 = retdec::fileformat::getMd5(data.data(), data.size());
-		sectionSha256 = retdec::fileformat::getSha256(data.data(), data.size());
+		retdec::fileformat::getCrc32Md5Sha256(data.data(), data.size(), sectionCrc32, sectionMd5, sectionSha256);
 	}
 }
 
+/**
+ * Build indexes of sections and segments by offsets and addresses, so that
+ * they are found in logarithmic time instead of going through all of them.
+ * This method must be called after sections and segments are loaded and
+ * whenever their offsets, addresses or sizes change. Until it is called,
+ * sections and segments are searched linearly.
+ */
+void FileFormat::indexSectionsAndSegments()
+{
+	const auto getOffsetRange = [](const SecSeg *region, std::uint64_t &start, std::uint64_t &size)
+	{
+		start = region->getOffset();
+		size = region->getSizeInFile();
+		return true;
+	};
+	const auto getAddressRange = [](const SecSeg *region, std::uint64_t &start, std::uint64_t &size)
+	{
+		unsigned long long sizeInMemory = 0;
+		start = region->getAddress();
+		size = region->getSizeInMemory(sizeInMemory) ? sizeInMemory : region->getSizeInFile();
+		return region->getMemory();
+	};
+
+	buildRegionIndex(sectionOffsetIndex, sections, getOffsetRange);
+	buildRegionIndex(segmentOffsetIndex, segments, getOffsetRange);
+	buildRegionIndex(sectionAddressIndex, sections, getAddressRange);
+	buildRegionIndex(segmentAddressIndex, segments, getAddressRange);
+	hasRegionIndex = true;
+}
+
 /**
  * Set pointer to loaded serialized bytes of input file. In binary file formats
  * (e.g. ELF, PE, COFF) it is not necessary to call this method. In text file
@@ -377,22 +522,6 @@ void FileFormat::loadStrings()
 	if (!(getLoadFlags() & LoadFlags::DETECT_STRINGS))
 		return;
 
-	loadStrings(StringType::Ascii, 1);
-	loadStrings(StringType::Wide, 2);
-
-	// Sort and remove duplicates
-	std::sort(strings.begin(), strings.end());
-	auto endItr = std::unique(strings.begin(), strings.end());
-	strings.erase(endItr, strings.end());
-}
-
-/**
- * Load strings of specified type and with specified character size.
- * @param type Type of the strings.
- * @param charSize Character size.
- */
-void FileFormat::loadStrings(StringType type, std::size_t charSize)
-{
 	if (!sections.empty())
 	{
 		for (const auto* sec : sections)
@@ -400,7 +529,7 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!sec->isSomeData() && !sec->isDebug())
 				continue;
 
-			loadStrings(type, charSize, sec);
+			loadStrings(sec);
 		}
 	}
 	else
@@ -410,32 +539,29 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!seg->isSomeData() && !seg->isDebug())
 				continue;
 
-			loadStrings(type, charSize, seg);
+			loadStrings(seg);
 		}
 	}
+
+	// Sort and remove duplicates
+	std::sort(strings.begin(), strings.end());
+	auto endItr = std::unique(strings.begin(), strings.end());
+	strings.erase(endItr, strings.end());
 }
 
-void FileFormat::loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg)
+/**
+ * Load ASCII and wide strings from section or segment.
+ * @param secSeg Section or segment.
+ */
+void FileFormat::loadStrings(const SecSeg* secSeg)
 {
-	CharacterEndianness endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	const auto bytes = secSeg->getBytes();
+	const auto* data = reinterpret_cast<const std::uint8_t*>(bytes.data());
+	const bool bigEndian = !isLittleEndian();
 
-	for (auto begin = secSeg->getBytes().begin(), end = secSeg->getBytes().end(), itr = begin; itr != end;)
+	for (const auto& range : findStrings(data, bytes.size(), DefaultMinStringLength, bigEndian))
 	{
-		if (makeCharacterIterator(itr, begin, end, charSize).pointsToValidCharacter(endian))
-		{
-			auto stringBeginItr = makeCharacterIterator(itr, begin, end, charSize);
-			auto stringDataEndItr = makeCharacterIterator(end, begin, end, charSize);
-			auto stringEndItr = stringBeginItr + 1;
-			while (stringEndItr != stringDataEndItr && stringEndItr.pointsToValidCharacter(endian))
-				++stringEndItr;
-
-			if (static_cast<std::size_t>(stringEndItr - stringBeginItr) >= DefaultMinStringLength)
-				strings.emplace_back(type, secSeg->getOffset() + (itr - begin), secSeg->getName(), std::string{stringBeginItr, stringEndItr});
-
-			itr = stringEndItr.getUnderlyingIterator();
-		}
-		else
-			++itr;
+		strings.emplace_back(range.type, secSeg->getOffset() + range.offset, secSeg->getName(), getStringContent(data, range, bigEndian));
 	}
 }
 
@@ -504,6 +630,11 @@ LoadFlags FileFormat::getLoadFlags() const
  */
 const Section* FileFormat::getSectionFromOffset(unsigned long long offset) const
 {
+	if(hasRegionIndex)
+	{
+		return static_cast<const Section*>(findInRegionIndex(sectionOffsetIndex, offset));
+	}
+
 	const Section *actSec = nullptr;
 
 	for(const auto *item : sections)
@@ -525,6 +656,11 @@ const Section* FileFormat::getSectionFromOffset(unsigned long long offset) const
  */
 const Segment* FileFormat::getSegmentFromOffset(unsigned long long offset) const
 {
+	if(hasRegionIndex)
+	{
+		return static_cast<const Segment*>(findInRegionIndex(segmentOffsetIndex, offset));
+	}
+
 	const Segment *actSeg = nullptr;
 
 	for(const auto *item : segments)
@@ -586,6 +722,11 @@ bool FileFormat::haveDataOnOffset(unsigned long long offset) const
  */
 const Section* FileFormat::getSectionFromAddress(unsigned long long address) const
 {
+	if(hasRegionIndex)
+	{
+		return static_cast<const Section*>(findInRegionIndex(sectionAddressIndex, address));
+	}
+
 	const Section *actSec = nullptr;
 
 	for(const auto *item : sections)
@@ -607,6 +748,11 @@ const Section* FileFormat::getSectionFromAddress(unsigned long long address) con
  */
 const Segment* FileFormat::getSegmentFromAddress(unsigned long long address) const
 {
+	if(hasRegionIndex)
+	{
+		return static_cast<const Segment*>(findInRegionIndex(segmentAddressIndex, address));
+	}
+
 	const Segment *actSeg = nullptr;
 
 	for(const auto *item : segments)
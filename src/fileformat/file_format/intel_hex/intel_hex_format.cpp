@@ -56,6 +56,7 @@ void IntelHexFormat::initStructures()
 	{
 		fileFormat = Format::INTEL_HEX;
 		initializeSections();
+		indexSectionsAndSegments();
 		computeSectionTableHashes();
 		loadStrings();
 	}
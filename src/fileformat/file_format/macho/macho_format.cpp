@@ -273,6 +273,7 @@ void MachOFormat::initStructures()
 		}
 		fileFormat = Format::MACHO;
 		loadCommands();
+		indexSectionsAndSegments();
 		loadStrings();
 		loadImpHash();
 		loadExpHash();
@@ -630,6 +630,7 @@ void PeFormat::initStructures(const std::string & dllListFile)
 		fileFormat = Format::PE;
 		loadRichHeader();
 		loadSections();
+		indexSectionsAndSegments();
 		loadSymbols();
 		loadImports();
 		loadExports();
@@ -845,9 +846,8 @@ void PeFormat::loadRichHeader()
 	auto decrypted_bytes = header.getDecryptedHeaderBytes();
 	richHeader->setBytes(decrypted_bytes);
 
-	auto crc32 = retdec::fileformat::getCrc32(decrypted_bytes.data(), decrypted_bytes.size());
-	auto md5 = retdec::fileformat::getMd5(decrypted_bytes.data(), decrypted_bytes.size());
-	auto sha256 = retdec::fileformat::getSha256(decrypted_bytes.data(), decrypted_bytes.size());
+	std::string crc32, md5, sha256;
+	retdec::fileformat::getCrc32Md5Sha256(decrypted_bytes.data(), decrypted_bytes.size(), crc32, md5, sha256);
 
 	richHeader->setCrc32(crc32);
 	richHeader->setMd5(md5);
@@ -2382,6 +2382,9 @@ void PeFormat::parseMetadataStream(std::uint64_t baseAddress, std::uint64_t offs
 		currentAddress += 4;
 	}
 
+	// All the tables are stored one after another, so they are decoded from the same loaded data
+	MetadataTableReader reader(this, currentAddress);
+
 	for (std::size_t i = 0; i < 64; ++i)
 	{
 		auto table = metadataStream->getMetadataTable(static_cast<MetadataTableType>(i));
@@ -2393,133 +2396,133 @@ void PeFormat::parseMetadataStream(std::uint64_t baseAddress, std::uint64_t offs
 		switch (table->getType())
 		{
 			case MetadataTableType::Module:
-				parseMetadataTable<DotnetModule>(table, currentAddress);
+				parseMetadataTable<DotnetModule>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::TypeRef:
-				parseMetadataTable<TypeRef>(table, currentAddress);
+				parseMetadataTable<TypeRef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::TypeDef:
-				parseMetadataTable<TypeDef>(table, currentAddress);
+				parseMetadataTable<TypeDef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::FieldPtr:
-				parseMetadataTable<FieldPtr>(table, currentAddress);
+				parseMetadataTable<FieldPtr>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Field:
-				parseMetadataTable<Field>(table, currentAddress);
+				parseMetadataTable<Field>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::MethodPtr:
-				parseMetadataTable<MethodPtr>(table, currentAddress);
+				parseMetadataTable<MethodPtr>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::MethodDef:
-				parseMetadataTable<MethodDef>(table, currentAddress);
+				parseMetadataTable<MethodDef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ParamPtr:
-				parseMetadataTable<ParamPtr>(table, currentAddress);
+				parseMetadataTable<ParamPtr>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Param:
-				parseMetadataTable<Param>(table, currentAddress);
+				parseMetadataTable<Param>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::InterfaceImpl:
-				parseMetadataTable<InterfaceImpl>(table, currentAddress);
+				parseMetadataTable<InterfaceImpl>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::MemberRef:
-				parseMetadataTable<MemberRef>(table, currentAddress);
+				parseMetadataTable<MemberRef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Constant:
-				parseMetadataTable<Constant>(table, currentAddress);
+				parseMetadataTable<Constant>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::CustomAttribute:
-				parseMetadataTable<CustomAttribute>(table, currentAddress);
+				parseMetadataTable<CustomAttribute>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::FieldMarshal:
-				parseMetadataTable<FieldMarshal>(table, currentAddress);
+				parseMetadataTable<FieldMarshal>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::DeclSecurity:
-				parseMetadataTable<DeclSecurity>(table, currentAddress);
+				parseMetadataTable<DeclSecurity>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ClassLayout:
-				parseMetadataTable<ClassLayout>(table, currentAddress);
+				parseMetadataTable<ClassLayout>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::FieldLayout:
-				parseMetadataTable<FieldLayout>(table, currentAddress);
+				parseMetadataTable<FieldLayout>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::StandAloneSig:
-				parseMetadataTable<StandAloneSig>(table, currentAddress);
+				parseMetadataTable<StandAloneSig>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::EventMap:
-				parseMetadataTable<EventMap>(table, currentAddress);
+				parseMetadataTable<EventMap>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Event:
-				parseMetadataTable<Event>(table, currentAddress);
+				parseMetadataTable<Event>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::PropertyMap:
-				parseMetadataTable<PropertyMap>(table, currentAddress);
+				parseMetadataTable<PropertyMap>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::PropertyPtr:
-				parseMetadataTable<PropertyPtr>(table, currentAddress);
+				parseMetadataTable<PropertyPtr>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Property:
-				parseMetadataTable<Property>(table, currentAddress);
+				parseMetadataTable<Property>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::MethodSemantics:
-				parseMetadataTable<MethodSemantics>(table, currentAddress);
+				parseMetadataTable<MethodSemantics>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::MethodImpl:
-				parseMetadataTable<MethodImpl>(table, currentAddress);
+				parseMetadataTable<MethodImpl>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ModuleRef:
-				parseMetadataTable<ModuleRef>(table, currentAddress);
+				parseMetadataTable<ModuleRef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::TypeSpec:
-				parseMetadataTable<TypeSpec>(table, currentAddress);
+				parseMetadataTable<TypeSpec>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ImplMap:
-				parseMetadataTable<ImplMap>(table, currentAddress);
+				parseMetadataTable<ImplMap>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::FieldRVA:
-				parseMetadataTable<FieldRVA>(table, currentAddress);
+				parseMetadataTable<FieldRVA>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ENCLog:
-				parseMetadataTable<ENCLog>(table, currentAddress);
+				parseMetadataTable<ENCLog>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ENCMap:
-				parseMetadataTable<ENCMap>(table, currentAddress);
+				parseMetadataTable<ENCMap>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::Assembly:
-				parseMetadataTable<Assembly>(table, currentAddress);
+				parseMetadataTable<Assembly>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::AssemblyProcessor:
-				parseMetadataTable<AssemblyProcessor>(table, currentAddress);
+				parseMetadataTable<AssemblyProcessor>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::AssemblyOS:
-				parseMetadataTable<AssemblyOS>(table, currentAddress);
+				parseMetadataTable<AssemblyOS>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::AssemblyRef:
-				parseMetadataTable<AssemblyRef>(table, currentAddress);
+				parseMetadataTable<AssemblyRef>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::AssemblyRefProcessor:
-				parseMetadataTable<AssemblyRefProcessor>(table, currentAddress);
+				parseMetadataTable<AssemblyRefProcessor>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::AssemblyRefOS:
-				parseMetadataTable<AssemblyRefOS>(table, currentAddress);
+				parseMetadataTable<AssemblyRefOS>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::File:
-				parseMetadataTable<File>(table, currentAddress);
+				parseMetadataTable<File>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ExportedType:
-				parseMetadataTable<ExportedType>(table, currentAddress);
+				parseMetadataTable<ExportedType>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::ManifestResource:
-				parseMetadataTable<ManifestResource>(table, currentAddress);
+				parseMetadataTable<ManifestResource>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::NestedClass:
-				parseMetadataTable<NestedClass>(table, currentAddress);
+				parseMetadataTable<NestedClass>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::GenericParam:
-				parseMetadataTable<GenericParam>(table, currentAddress);
+				parseMetadataTable<GenericParam>(table, reader, currentAddress);
 				break;
 			case MetadataTableType::GenericParamContstraint:
-				parseMetadataTable<GenericParamContstraint>(table, currentAddress);
+				parseMetadataTable<GenericParamContstraint>(table, reader, currentAddress);
 				break;
 			default:
 				break;
@@ -2597,10 +2600,11 @@ void PeFormat::parseUserStringStream(std::uint64_t/* baseAddress*/, std::uint64_
 /**
  * Parses single metadata table from metadata stream.
  * @param table Table where to insert data.
+ * @param reader Reader of metadata tables.
  * @param address Address of table data.
  */
 template <typename T>
-void PeFormat::parseMetadataTable(BaseMetadataTable* table, std::uint64_t& address)
+void PeFormat::parseMetadataTable(BaseMetadataTable* table, MetadataTableReader& reader, std::uint64_t& address)
 {
 	auto specTable = static_cast<MetadataTable<T>*>(table);
 	for (std::size_t i = 0; i < table->getSize(); ++i)
@@ -2608,7 +2612,7 @@ void PeFormat::parseMetadataTable(BaseMetadataTable* table, std::uint64_t& addre
 		try
 		{
 			T row;
-			row.load(this, metadataStream.get(), address);
+			row.load(reader, metadataStream.get(), address);
 			specTable->addRow(std::move(row));
 		}
 		catch (const InvalidDotnetRecordError&)
@@ -2748,21 +2752,38 @@ void PeFormat::detectTypeLibId()
 }
 
 /**
- * Detects and reconstructs .NET types such as classes, methods, fields, properties etc.
+ * Detects .NET types. Classes, methods, fields, properties etc. are reconstructed
+ * only when they are requested for the first time.
  */
 void PeFormat::detectDotnetTypes()
 {
-	DotnetTypeReconstructor reconstructor(metadataStream.get(), stringStream.get(), blobStream.get());
-
+	std::lock_guard<std::mutex> lock(dotnetTypesMutex);
 	definedClasses.clear();
 	importedClasses.clear();
+	dotnetTypesReconstructed = false;
+
+	computeTypeRefHashes();
+}
+
+/**
+ * Reconstructs .NET types such as classes, methods, fields, properties etc.
+ * if they were not reconstructed yet. Safe to call from several threads.
+ */
+void PeFormat::reconstructDotnetTypes() const
+{
+	std::lock_guard<std::mutex> lock(dotnetTypesMutex);
+	if (dotnetTypesReconstructed)
+	{
+		return;
+	}
+
+	dotnetTypesReconstructed = true;
+	DotnetTypeReconstructor reconstructor(metadataStream.get(), stringStream.get(), blobStream.get());
 	if (reconstructor.reconstruct())
 	{
 		definedClasses = reconstructor.getDefinedClasses();
 		importedClasses = reconstructor.getReferencedClasses();
 	}
-
-	computeTypeRefHashes();
 }
 
 /**
@@ -2957,9 +2978,7 @@ void PeFormat::computeTypeRefHashes()
 		}
 	}
 
-	typeRefHashCrc32 = retdec::fileformat::getCrc32(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashMd5 = retdec::fileformat::getMd5(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashSha256 = retdec::fileformat::getSha256(typeRefHashBytes.data(), typeRefHashBytes.size());
+	retdec::fileformat::getCrc32Md5Sha256(typeRefHashBytes.data(), typeRefHashBytes.size(), typeRefHashCrc32, typeRefHashMd5, typeRefHashSha256);
 }
 
 retdec::utils::Endianness PeFormat::getEndianness() const
@@ -3705,11 +3724,13 @@ const std::string& PeFormat::getTypeLibId() const
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getDefinedDotnetClasses() const
 {
+	reconstructDotnetTypes();
 	return definedClasses;
 }
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getImportedDotnetClasses() const
 {
+	reconstructDotnetTypes();
 	return importedClasses;
 }
 
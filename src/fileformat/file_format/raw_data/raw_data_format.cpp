@@ -68,6 +68,7 @@ void RawDataFormat::initStructures()
 	section->setSizeInMemory(bytes.size());
 	section->load(this);
 	sections.push_back(section);
+	indexSectionsAndSegments();
 	computeSectionTableHashes();
 	loadStrings();
 }
@@ -267,6 +268,7 @@ void RawDataFormat::setEntryPoint(retdec::common::Address entryPoint)
 void RawDataFormat::setBaseAddress(retdec::common::Address baseAddress)
 {
 	section->setAddress(baseAddress);
+	indexSectionsAndSegments();
 }
 
 /**
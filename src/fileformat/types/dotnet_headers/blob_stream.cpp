@@ -16,11 +16,13 @@ BlobStream::BlobStream(std::vector<std::uint8_t> data, std::uint64_t streamOffse
 }
 
 /**
- * Returns the element at the specified offset in the blob.
+ * Finds the element at the specified offset in the blob.
  * @param offset Offset of the element.
- * @return Element data if it exists, otherwise empty sequence.
+ * @param [out] dataOffset Offset of the element data.
+ * @param [out] dataSize Size of the element data.
+ * @return @c true if the element exists, otherwise @c false.
  */
-std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
+bool BlobStream::findElement(std::size_t offset, std::size_t& dataOffset, std::size_t& dataSize) const
 {
 	// Adapted from YARA
 	// https://github.com/VirusTotal/yara/blob/v4.1.2/libyara/modules/dotnet/dotnet.c#L130
@@ -28,7 +30,7 @@ std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
 	const unsigned char* ptr = data.data() + offset;
 	if (offset >= data.size())
 	{
-		return {};
+		return false;
 	}
 	// ECMA 335 II.24.2.4
 	/* Blob starts with their length in big-endian order 
@@ -39,10 +41,6 @@ std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
 	{
 		len = *ptr;
 		offset += 1;
-		if (offset + len <= data.size())
-		{
-			return { data.begin() + offset, data.begin() + offset + len };
-		}
 	}
 	// If first 2 bits are 10, length is stored in 2 bytes
 	else if ((*ptr & 0xC0) == 0x80)
@@ -54,10 +52,6 @@ std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
 			len = ((*ptr & 0x3F) << 8) | *(ptr + 1);
 			offset += 2;
 		}
-		if (offset + len <= data.size())
-		{
-			return { data.begin() + offset, data.begin() + offset + len };
-		}
 	}
 	// If first 3 bits are 110, length is stored in 4 bytes
 	else if ((*ptr & 0xE0) == 0xC0)
@@ -72,13 +66,54 @@ std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
 					*(ptr + 3);
 			offset += 4;
 		}
-		if (offset + len <= data.size())
-		{
-			return { data.begin() + offset, data.begin() + offset + len };
-		}
+	}
+	else
+	{
+		return false;
+	}
+
+	if (offset + len > data.size())
+	{
+		return false;
+	}
+
+	dataOffset = offset;
+	dataSize = len;
+	return true;
+}
+
+/**
+ * Returns the element at the specified offset in the blob.
+ * @param offset Offset of the element.
+ * @return Element data if it exists, otherwise empty sequence.
+ */
+std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
+{
+	std::size_t dataOffset = 0, dataSize = 0;
+	if (!findElement(offset, dataOffset, dataSize))
+	{
+		return {};
 	}
 
-	return {};
+	return { data.begin() + dataOffset, data.begin() + dataOffset + dataSize };
 }
+
+/**
+ * Returns reader of the signature at the specified offset in the blob.
+ * The signature is not copied out of the blob.
+ * @param offset Offset of the signature.
+ * @return Reader of the signature if it exists, otherwise empty reader.
+ */
+SignatureReader BlobStream::getSignature(std::size_t offset) const
+{
+	std::size_t dataOffset = 0, dataSize = 0;
+	if (!findElement(offset, dataOffset, dataSize))
+	{
+		return {};
+	}
+
+	return { data.data() + dataOffset, dataSize };
+}
+
 } // namespace fileformat
 } // namespace retdec
@@ -9,11 +9,55 @@
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Constructor.
+ * @param file File with metadata.
+ * @param address Address of metadata tables.
+ */
+MetadataTableReader::MetadataTableReader(const FileFormat* file, std::uint64_t address) : file(file)
+{
+	if (auto secSeg = file->getSectionOrSegmentFromAddress(address))
+	{
+		viewAddress = address;
+		view = secSeg->getBytes(address - secSeg->getAddress());
+	}
+}
+
+/**
+ * Reads little endian unsigned integer.
+ * @param address Address of integer.
+ * @param size Size of integer in bytes.
+ * @param [out] result Read integer.
+ * @return @c true if integer was read, otherwise @c false.
+ */
+bool MetadataTableReader::readUInt(std::uint64_t address, std::uint32_t size, std::uint64_t& result) const
+{
+	if (address < viewAddress || address - viewAddress > view.size() || view.size() - (address - viewAddress) < size)
+		return file->getXByte(address, size, result, retdec::utils::Endianness::LITTLE);
+
+	const auto* bytes = view.bytes_begin() + (address - viewAddress);
+	result = 0;
+	for (std::uint32_t i = 0; i < size; ++i)
+		result |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+
+	return true;
+}
+
+/**
+ * Returns cached size of indexes of the given type.
+ * @param indexType Type of index.
+ * @return Reference to size of index which is @c 0 if not computed yet.
+ */
+std::uint32_t& MetadataTableReader::getCachedIndexSize(std::type_index indexType)
+{
+	return indexSizes[indexType];
+}
+
 template <>
-std::uint8_t BaseRecord::loadUInt<std::uint8_t>(const FileFormat* file, std::uint64_t& address)
+std::uint8_t BaseRecord::loadUInt<std::uint8_t>(MetadataTableReader& reader, std::uint64_t& address)
 {
 	std::uint64_t val;
-	if (!file->get1Byte(address, val))
+	if (!reader.readUInt(address, 1, val))
 		throw InvalidDotnetRecordError();
 
 	address += 1;
@@ -21,10 +65,10 @@ std::uint8_t BaseRecord::loadUInt<std::uint8_t>(const FileFormat* file, std::uin
 }
 
 template <>
-std::uint16_t BaseRecord::loadUInt<std::uint16_t>(const FileFormat* file, std::uint64_t& address)
+std::uint16_t BaseRecord::loadUInt<std::uint16_t>(MetadataTableReader& reader, std::uint64_t& address)
 {
 	std::uint64_t val;
-	if (!file->get2Byte(address, val))
+	if (!reader.readUInt(address, 2, val))
 		throw InvalidDotnetRecordError();
 
 	address += 2;
@@ -32,10 +76,10 @@ std::uint16_t BaseRecord::loadUInt<std::uint16_t>(const FileFormat* file, std::u
 }
 
 template <>
-std::uint32_t BaseRecord::loadUInt<std::uint32_t>(const FileFormat* file, std::uint64_t& address)
+std::uint32_t BaseRecord::loadUInt<std::uint32_t>(MetadataTableReader& reader, std::uint64_t& address)
 {
 	std::uint64_t val;
-	if (!file->get4Byte(address, val))
+	if (!reader.readUInt(address, 4, val))
 		throw InvalidDotnetRecordError();
 
 	address += 4;
@@ -0,0 +1,175 @@
+/**
+ * @file src/fileformat/types/dotnet_headers/signature_reader.cpp
+ * @brief Class for reading .NET signatures.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/fileformat/types/dotnet_headers/signature_reader.h"
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Constructor.
+ * @param data Signature data.
+ * @param size Size of signature data.
+ */
+SignatureReader::SignatureReader(const std::uint8_t *data, std::size_t size) : data(data), size(size)
+{
+}
+
+/**
+ * Checks whether all bytes of the signature were read.
+ * @return @c true if there are no more bytes to read, otherwise @c false.
+ */
+bool SignatureReader::isEmpty() const
+{
+	return position >= size;
+}
+
+/**
+ * Returns the number of bytes which were not read yet.
+ * @return Number of remaining bytes.
+ */
+std::size_t SignatureReader::getRemainingSize() const
+{
+	return size - position;
+}
+
+/**
+ * Returns the next byte without reading it. Reader must not be empty.
+ * @return Next byte.
+ */
+std::uint8_t SignatureReader::peekByte() const
+{
+	return data[position];
+}
+
+/**
+ * Skips the given number of bytes.
+ * @param count Number of bytes to skip.
+ * @return @c true if there were enough bytes, otherwise @c false and nothing is skipped.
+ */
+bool SignatureReader::skip(std::size_t count)
+{
+	if (count > getRemainingSize())
+		return false;
+
+	position += count;
+	return true;
+}
+
+/**
+ * Reads a single byte.
+ * @param [out] result Read byte.
+ * @return @c true if byte was read, otherwise @c false.
+ */
+bool SignatureReader::readByte(std::uint8_t &result)
+{
+	if (isEmpty())
+		return false;
+
+	result = data[position++];
+	return true;
+}
+
+/**
+ * Reads compressed unsigned integer (ECMA-335 II.23.2).
+ * @param [out] result Decoded unsigned integer.
+ * @return @c true if integer was read, otherwise @c false and nothing is read.
+ */
+bool SignatureReader::readUnsigned(std::uint64_t &result)
+{
+	if (isEmpty())
+		return false;
+
+	const auto *bytes = data + position;
+
+	// If highest bit not set, it is 1-byte number
+	if ((bytes[0] & 0x80) == 0)
+	{
+		result = bytes[0];
+		position += 1;
+	}
+	// If highest bit set and second highest not set, it is 2-byte number
+	else if ((bytes[0] & 0xC0) == 0x80)
+	{
+		if (getRemainingSize() < 2)
+			return false;
+
+		result = ((static_cast<std::uint64_t>(bytes[0]) & 0x3F) << 8)
+			| bytes[1];
+		position += 2;
+	}
+	// If highest bit and second highest are set and third bit is not set, it is 4-byte number
+	else if ((bytes[0] & 0xE0) == 0xC0)
+	{
+		if (getRemainingSize() < 4)
+			return false;
+
+		result = ((static_cast<std::uint64_t>(bytes[0]) & 0x1F) << 24)
+			| (static_cast<std::uint64_t>(bytes[1]) << 16)
+			| (static_cast<std::uint64_t>(bytes[2]) << 8)
+			| bytes[3];
+		position += 4;
+	}
+	else
+		return false;
+
+	return true;
+}
+
+/**
+ * Reads compressed signed integer (ECMA-335 II.23.2).
+ * @param [out] result Decoded signed integer.
+ * @return @c true if integer was read, otherwise @c false and nothing is read.
+ */
+bool SignatureReader::readSigned(std::int64_t &result)
+{
+	if (isEmpty())
+		return false;
+
+	const auto *bytes = data + position;
+
+	// If highest bit not set, it is 1-byte number
+	if ((bytes[0] & 0x80) == 0)
+	{
+		std::int8_t result8 = (bytes[0] & 0x01 ? 0x80 : 0x00)
+			| static_cast<std::uint64_t>(bytes[0]);
+		result = result8 >> 1;
+		position += 1;
+	}
+	// If highest bit set and second highest not set, it is 2-byte number
+	else if ((bytes[0] & 0xC0) == 0x80)
+	{
+		if (getRemainingSize() < 2)
+			return false;
+
+		std::int16_t result16 = (bytes[1] & 0x01 ? 0xC000 : 0x0000)
+			| ((static_cast<std::uint64_t>(bytes[0]) & 0x1F) << 8)
+			| static_cast<std::uint64_t>(bytes[1]);
+		result = result16 >> 1;
+		position += 2;
+	}
+	// If highest bit and second highest are set and third bit is not set, it is 4-byte number
+	else if ((bytes[0] & 0xE0) == 0xC0)
+	{
+		if (getRemainingSize() < 4)
+			return false;
+
+		std::int32_t result32 = (bytes[3] & 0x01 ? 0xE0000000 : 0x00000000)
+			| ((static_cast<std::uint64_t>(bytes[0]) & 0x0F) << 24)
+			| (static_cast<std::uint64_t>(bytes[1]) << 16)
+			| (static_cast<std::uint64_t>(bytes[2]) << 8)
+			| static_cast<std::uint64_t>(bytes[3]);
+		result = result32 >> 1;
+		position += 4;
+	}
+	else
+		return false;
+
+	return true;
+}
+
+} // namespace fileformat
+} // namespace retdec
@@ -25,110 +25,6 @@ const std::uint8_t PropertySignature = 0x08; ///< Property signature.
 const std::uint8_t HasThis           = 0x20; ///< Flag indicating whether the method/property is static or not (has this).
 const std::uint8_t Generic           = 0x10; ///< Flag indicating whether the method is generic or not.
 
-/**
- * Decodes unsigned integer out of the signature.
- * @param data Signature data.
- * @param [out] bytesRead Amount of bytes read out of signature.
- * @return Decoded unsigned integer.
- */
-std::uint64_t decodeUnsigned(const std::vector<std::uint8_t>& data, std::uint64_t& bytesRead)
-{
-	std::uint64_t result = 0;
-	bytesRead = 0;
-
-	if (data.empty())
-		return result;
-
-	// If highest bit not set, it is 1-byte number
-	if ((data[0] & 0x80) == 0)
-	{
-		if (data.size() < 1)
-			return result;
-
-		result = data[0];
-		bytesRead = 1;
-	}
-	// If highest bit set and second highest not set, it is 2-byte number
-	else if ((data[0] & 0xC0) == 0x80)
-	{
-		if (data.size() < 2)
-			return result;
-
-		result = ((static_cast<std::uint64_t>(data[0]) & 0x3F) << 8)
-			| data[1];
-		bytesRead = 2;
-	}
-	// If highest bit and second highest are set and third bit is not set, it is 4-byte number
-	else if ((data[0] & 0xE0) == 0xC0)
-	{
-		if (data.size() < 4)
-			return result;
-
-		result = ((static_cast<std::uint64_t>(data[0]) & 0x1F) << 24)
-			| (static_cast<std::uint64_t>(data[1]) << 16)
-			| (static_cast<std::uint64_t>(data[2]) << 8)
-			| data[3];
-		bytesRead = 4;
-	}
-
-	return result;
-}
-
-/**
- * Decodes signed integer out of the signature.
- * @param data Signature data.
- * @param [out] bytesRead Amount of bytes read out of signature.
- * @return Decoded signed integer.
- */
-std::int64_t decodeSigned(const std::vector<std::uint8_t>& data, std::uint64_t& bytesRead)
-{
-	std::int64_t result = 0;
-	bytesRead = 0;
-
-	if (data.empty())
-		return result;
-
-	// If highest bit not set, it is 1-byte number
-	if ((data[0] & 0x80) == 0)
-	{
-		if (data.size() < 1)
-			return result;
-
-		std::int8_t result8 = (data[0] & 0x01 ? 0x80 : 0x00)
-			| static_cast<std::uint64_t>(data[0]);
-		result = result8 >> 1;
-		bytesRead = 1;
-	}
-	// If highest bit set and second highest not set, it is 2-byte number
-	else if ((data[0] & 0xC0) == 0x80)
-	{
-		if (data.size() < 2)
-			return result;
-
-		std::int16_t result16 = (data[1] & 0x01 ? 0xC000 : 0x0000)
-			| ((static_cast<std::uint64_t>(data[0]) & 0x1F) << 8)
-			| static_cast<std::uint64_t>(data[1]);
-		result = result16 >> 1;
-		bytesRead = 2;
-	}
-	// If highest bit and second highest are set and third bit is not set, it is 4-byte number
-	else if ((data[0] & 0xE0) == 0xC0)
-	{
-		if (data.size() < 4)
-			return result;
-
-		std::int32_t result32 = (data[3] & 0x01 ? 0xE0000000 : 0x00000000)
-			| ((static_cast<std::uint64_t>(data[0]) & 0x0F) << 24)
-			| (static_cast<std::uint64_t>(data[1]) << 16)
-			| (static_cast<std::uint64_t>(data[2]) << 8)
-			| static_cast<std::uint64_t>(data[3]);
-		result = result32 >> 1;
-		bytesRead = 4;
-	}
-
-	return result;
-}
-
 /**
  * Extracts the classes from the class table.
  * @param classTable Class table.
@@ -725,7 +621,7 @@ bool DotnetTypeReconstructor::reconstructBaseTypes()
 			if (typeSpec == nullptr)
 				continue;
 
-			auto signature = blobStream->getElement(typeSpec->signature.getIndex());
+			auto signature = blobStream->getSignature(typeSpec->signature.getIndex());
 			baseType = dataTypeFromSignature(signature, classType.get(), nullptr);
 			if (baseType == nullptr)
 				continue;
@@ -780,7 +676,7 @@ bool DotnetTypeReconstructor::reconstructBaseTypes()
 			if (typeSpec == nullptr)
 				continue;
 
-			auto signature = blobStream->getElement(typeSpec->signature.getIndex());
+			auto signature = blobStream->getSignature(typeSpec->signature.getIndex());
 			baseType = dataTypeFromSignature(signature, itr->second.get(), nullptr);
 			if (baseType == nullptr)
 				continue;
@@ -903,11 +799,11 @@ std::unique_ptr<DotnetField> DotnetTypeReconstructor::createField(const Field* f
 		return nullptr;
 
 	fieldName = retdec::utils::replaceNonprintableChars(fieldName);
-	auto signature = blobStream->getElement(field->signature.getIndex());
+	auto signature = blobStream->getSignature(field->signature.getIndex());
 
-	if (signature.empty() || signature[0] != FieldSignature)
+	std::uint8_t callingConvention;
+	if (!signature.readByte(callingConvention) || callingConvention != FieldSignature)
 		return nullptr;
-	signature.erase(signature.begin(), signature.begin() + 1);
 
 	auto type = dataTypeFromSignature(signature, ownerClass, nullptr);
 	if (type == nullptr)
@@ -936,14 +832,14 @@ std::unique_ptr<DotnetProperty> DotnetTypeReconstructor::createProperty(const Pr
 		return nullptr;
 
 	propertyName = retdec::utils::replaceNonprintableChars(propertyName);
-	auto signature = blobStream->getElement(property->type.getIndex());
+	auto signature = blobStream->getSignature(property->type.getIndex());
 
-	if (signature.size() < 2 || (signature[0] & ~HasThis) != PropertySignature)
+	if (signature.getRemainingSize() < 2 || (signature.peekByte() & ~HasThis) != PropertySignature)
 		return nullptr;
-	bool hasThis = signature[0] & HasThis;
-	// Delete two bytes because the first is 0x08 (or 0x28 if HASTHIS is set) and the other one is number of parameters
+	bool hasThis = signature.peekByte() & HasThis;
+	// Skip two bytes because the first is 0x08 (or 0x28 if HASTHIS is set) and the other one is number of parameters
 	// This seems like a weird thing, because I don't think that C# allows any parameters in getters/setters and therefore this will always be 0
-	signature.erase(signature.begin(), signature.begin() + 2);
+	signature.skip(2);
 
 	auto type = dataTypeFromSignature(signature, ownerClass, nullptr);
 	if (type == nullptr)
@@ -971,35 +867,25 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
 		return nullptr;
 
 	methodName = retdec::utils::replaceNonprintableChars(methodName);
-	auto signature = blobStream->getElement(methodDef->signature.getIndex());
+	auto signature = blobStream->getSignature(methodDef->signature.getIndex());
 
-	if (methodName.empty() || signature.empty())
+	std::uint8_t callingConvention;
+	if (methodName.empty() || !signature.readByte(callingConvention))
 		return nullptr;
 
 	// If method contains generic paramters, we need to read the number of these generic paramters
-	if (signature[0] & Generic)
+	if (callingConvention & Generic)
 	{
-		signature.erase(signature.begin(), signature.begin() + 1);
-
 		// We ignore this value just because we have this information already from the class name in format 'ClassName`N'
-		std::uint64_t bytesRead = 0;
-		decodeUnsigned(signature, bytesRead);
-		if (bytesRead == 0)
+		std::uint64_t genericCount;
+		if (!signature.readUnsigned(genericCount))
 			return nullptr;
-
-		signature.erase(signature.begin(), signature.begin() + bytesRead);
-	}
-	else
-	{
-		signature.erase(signature.begin(), signature.begin() + 1);
 	}
 
 	// It is followed by number of parameters
-	std::uint64_t bytesRead = 0;
-	std::uint64_t paramsCount = decodeUnsigned(signature, bytesRead);
-	if (bytesRead == 0)
+	std::uint64_t paramsCount;
+	if (!signature.readUnsigned(paramsCount))
 		return nullptr;
-	signature.erase(signature.begin(), signature.begin() + bytesRead);
 
 	auto newMethod = std::make_unique<DotnetMethod>();
 	newMethod->setRawRecord(methodDef);
@@ -1026,12 +912,12 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
  * @param startIdx Index of the first Param record of the method
  * @param ownerClass Owning class.
  * @param ownerMethod Owning method.
- * @param signature Signature with data types. Is destroyed in the meantime.
+ * @param signature Signature with data types. It is read in the meantime.
  * @return New method parameter or @c nullptr in case of failure.
  */
 std::unique_ptr<DotnetParameter> DotnetTypeReconstructor::createMethodParameter(
 		std::size_t paramIdx, std::size_t startIdx, const DotnetClass* ownerClass,
-		const DotnetMethod* ownerMethod, std::vector<std::uint8_t>& signature)
+		const DotnetMethod* ownerMethod, SignatureReader& signature)
 {
 	std::string paramName;
 
@@ -1072,19 +958,18 @@ std::unique_ptr<DotnetParameter> DotnetTypeReconstructor::createMethodParameter(
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(std::vector<std::uint8_t>& data)
+std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(SignatureReader& data)
 {
-	std::uint64_t bytesRead;
-	TypeDefOrRef typeRef;
-	typeRef.setIndex(decodeUnsigned(data, bytesRead));
-	if (bytesRead == 0)
+	std::uint64_t index;
+	if (!data.readUnsigned(index))
 		return nullptr;
 
+	TypeDefOrRef typeRef;
+	typeRef.setIndex(index);
 	auto classRef = selectClass(typeRef);
 	if (classRef == nullptr)
 		return nullptr;
 
-	data.erase(data.begin(), data.begin() + bytesRead);
 	return std::make_unique<T>(classRef);
 }
 
@@ -1096,7 +981,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(st
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
 	if (type == nullptr)
@@ -1112,22 +997,20 @@ std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(std::ve
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T, typename U>
-std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(std::vector<std::uint8_t>& data, const U* owner)
+std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(SignatureReader& data, const U* owner)
 {
 	if (owner == nullptr)
 		return nullptr;
 
 	// Index of generic parameter
-	std::uint64_t bytesRead = 0;
-	std::uint64_t index = decodeUnsigned(data, bytesRead);
-	if (bytesRead == 0)
+	std::uint64_t index;
+	if (!data.readUnsigned(index))
 		return nullptr;
 
 	const auto& genericParams = owner->getGenericParameters();
 	if (index >= genericParams.size())
 		return nullptr;
 
-	data.erase(data.begin(), data.begin() + bytesRead);
 	return std::make_unique<T>(&genericParams[index]);
 }
 
@@ -1138,9 +1021,9 @@ std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(std::vector<s
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGenericInstantiation(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGenericInstantiation(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
-	if (data.empty())
+	if (data.isEmpty())
 		return nullptr;
 
 	// Instantiated type
@@ -1148,12 +1031,10 @@ std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGeneri
 	if (type == nullptr)
 		return nullptr;
 
-	if (data.empty())
-		return nullptr;
-
 	// Number of instantiated generic parameters
-	auto genericCount = data[0];
-	data.erase(data.begin(), data.begin() + 1);
+	std::uint8_t genericCount;
+	if (!data.readByte(genericCount))
+		return nullptr;
 
 	// Generic parameters used for instantiation
 	std::vector<std::unique_ptr<DotnetDataTypeBase>> genericTypes;
@@ -1176,7 +1057,7 @@ std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGeneri
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	// First comes data type representing elements in array
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
@@ -1184,11 +1065,9 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 		return nullptr;
 
 	// Rank of an array comes then, this means how many dimensions our array has
-	std::uint64_t bytesRead = 0;
-	std::uint64_t rank = decodeUnsigned(data, bytesRead);
-	if (bytesRead == 0)
+	std::uint64_t rank;
+	if (!data.readUnsigned(rank))
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
 
 	// Rank must be non-zero number
 	if (rank == 0)
@@ -1197,34 +1076,28 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 
 	// Some dimensions can have limited size by declaration
 	// Size 0 means not specified
-	std::uint64_t numOfSizes = decodeUnsigned(data, bytesRead);
-	if (bytesRead == 0 || numOfSizes > rank)
+	std::uint64_t numOfSizes;
+	if (!data.readUnsigned(numOfSizes) || numOfSizes > rank)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
 
 	// Now get all those sizes
 	for (std::uint64_t i = 0; i < numOfSizes; ++i)
 	{
-		dimensions[i].second = decodeSigned(data, bytesRead);
-		if (bytesRead == 0)
+		if (!data.readSigned(dimensions[i].second))
 			return nullptr;
-		data.erase(data.begin(), data.begin() + bytesRead);
 	}
 
 	// And some dimensions can also be limited by special lower bound
-	std::size_t numOfLowBounds = decodeUnsigned(data, bytesRead);
-	if (bytesRead == 0 || numOfLowBounds > rank)
+	std::uint64_t numOfLowBounds;
+	if (!data.readUnsigned(numOfLowBounds) || numOfLowBounds > rank)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
 
 	// Make sure we don't get out of bounds with dimensions
-	numOfLowBounds = std::min(dimensions.size(), numOfLowBounds);
+	numOfLowBounds = std::min<std::uint64_t>(dimensions.size(), numOfLowBounds);
 	for (std::uint64_t i = 0; i < numOfLowBounds; ++i)
 	{
-		dimensions[i].first = decodeSigned(data, bytesRead);
-		if (bytesRead == 0)
+		if (!data.readSigned(dimensions[i].first))
 			return nullptr;
-		data.erase(data.begin(), data.begin() + bytesRead);
 
 		// Adjust higher bound according to lower bound
 		dimensions[i].second += dimensions[i].first;
@@ -1241,22 +1114,21 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createModifier(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<T> DotnetTypeReconstructor::createModifier(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	// These modifiers are used to somehow specify data type using some data type
 	// The only usage we know about right know is 'volatile' keyword
 
 	// First read reference to type used for modifier
-	std::uint64_t bytesRead;
-	TypeDefOrRef typeRef;
-	typeRef.setIndex(decodeUnsigned(data, bytesRead));
-	if (bytesRead == 0)
+	std::uint64_t index;
+	if (!data.readUnsigned(index))
 		return nullptr;
 
+	TypeDefOrRef typeRef;
+	typeRef.setIndex(index);
 	auto modifier = selectClass(typeRef);
 	if (modifier == nullptr)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
 
 	// Go further in signature because we only have modifier, we need to obtain type that is modified
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
@@ -1273,20 +1145,16 @@ std::unique_ptr<T> DotnetTypeReconstructor::createModifier(std::vector<std::uint
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(SignatureReader& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
-	if (data.empty())
+	// Skip first byte, what does it even mean?
+	if (!data.skip(1))
 		return nullptr;
 
-	// Delete first byte, what does it even mean?
-	data.erase(data.begin(), data.begin() + 1);
-
 	// Read number of parameters
-	std::uint64_t bytesRead = 0;
-	std::uint64_t paramsCount = decodeUnsigned(data, bytesRead);
-	if (bytesRead == 0)
+	std::uint64_t paramsCount;
+	if (!data.readUnsigned(paramsCount))
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
 
 	auto returnType = dataTypeFromSignature(data, ownerClass, ownerMethod);
 	if (returnType == nullptr)
@@ -1306,20 +1174,20 @@ std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(std::v
 }
 
 /**
- * Creates data type from signature. Signature is destroyed in the meantime.
+ * Creates data type from signature. Signature is read in the meantime.
  * @param signature Signature data.
  * @param ownerClass Owning class.
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeBase> DotnetTypeReconstructor::dataTypeFromSignature(std::vector<std::uint8_t>& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeBase> DotnetTypeReconstructor::dataTypeFromSignature(SignatureReader& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
-	if (signature.empty())
+	std::uint8_t elementType;
+	if (!signature.readByte(elementType))
 		return nullptr;
 
 	std::unique_ptr<DotnetDataTypeBase> result;
-	auto type = static_cast<ElementType>(signature[0]);
-	signature.erase(signature.begin(), signature.begin() + 1);
+	auto type = static_cast<ElementType>(elementType);
 
 	switch (type)
 	{
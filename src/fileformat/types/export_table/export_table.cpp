@@ -67,15 +67,21 @@ const Export* ExportTable::getExport(std::size_t exportIndex) const
  */
 const Export* ExportTable::getExport(const std::string &name) const
 {
-	for(const auto &e : exports)
-	{
-		if(e.getName() == name)
-		{
-			return &e;
-		}
-	}
+	buildIndexes();
+	auto it = exportsByName.find(name);
+	return it != exportsByName.end() ? &exports[it->second] : nullptr;
+}
 
-	return nullptr;
+/**
+ * Get export by ordinal number
+ * @param ordinalNumber Ordinal number of the export to get
+ * @return Pointer to export with the specified ordinal number or @c nullptr if such export not found
+ */
+const Export* ExportTable::getExportByOrdinal(std::uint64_t ordinalNumber) const
+{
+	buildIndexes();
+	auto it = exportsByOrdinal.find(ordinalNumber);
+	return it != exportsByOrdinal.end() ? &exports[it->second] : nullptr;
 }
 
 /**
@@ -85,15 +91,57 @@ const Export* ExportTable::getExport(const std::string &name) const
  */
 const Export* ExportTable::getExportOnAddress(unsigned long long address) const
 {
-	for(const auto &e : exports)
+	buildIndexes();
+	auto it = exportsByAddress.find(address);
+	return it != exportsByAddress.end() ? &exports[it->second] : nullptr;
+}
+
+/**
+ * Add export to lookup indexes, unless there already is export with the same key
+ * @param exportIndex Index of the export (indexed from 0)
+ */
+void ExportTable::indexExport(std::size_t exportIndex) const
+{
+	const auto &exp = exports[exportIndex];
+	exportsByName.emplace(exp.getName(), exportIndex);
+	exportsByAddress.emplace(exp.getAddress(), exportIndex);
+
+	std::uint64_t ordinalNumber;
+	if(exp.getOrdinalNumber(ordinalNumber))
 	{
-		if(e.getAddress() == address)
-		{
-			return &e;
-		}
+		exportsByOrdinal.emplace(ordinalNumber, exportIndex);
+	}
+}
+
+/**
+ * Build lookup indexes of exports if they are not built yet
+ *
+ * Indexes are built on the first lookup and then kept up to date by @c addExport().
+ */
+void ExportTable::buildIndexes() const
+{
+	if(indexesValid.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(indexesMutex);
+	if(indexesValid.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	exportsByName.clear();
+	exportsByAddress.clear();
+	exportsByOrdinal.clear();
+	exportsByName.reserve(exports.size());
+	exportsByAddress.reserve(exports.size());
+	for(std::size_t i = 0, e = exports.size(); i < e; ++i)
+	{
+		indexExport(i);
 	}
 
-	return nullptr;
+	indexesValid.store(true, std::memory_order_release);
 }
 
 /**
@@ -163,9 +211,7 @@ void ExportTable::computeHashes()
 		}
 	}
 
-	expHashCrc32 = getCrc32(expHashBytes.data(), expHashBytes.size());
-	expHashMd5 = getMd5(expHashBytes.data(), expHashBytes.size());
-	expHashSha256 = getSha256(expHashBytes.data(), expHashBytes.size());
+	getCrc32Md5Sha256(expHashBytes.data(), expHashBytes.size(), expHashCrc32, expHashMd5, expHashSha256);
 }
 
 /**
@@ -174,6 +220,7 @@ void ExportTable::computeHashes()
 void ExportTable::clear()
 {
 	exports.clear();
+	indexesValid.store(false, std::memory_order_release);
 }
 
 /**
@@ -183,6 +230,12 @@ void ExportTable::clear()
 void ExportTable::addExport(Export &newExport)
 {
 	exports.push_back(newExport);
+
+	std::lock_guard<std::mutex> lock(indexesMutex);
+	if(indexesValid.load(std::memory_order_relaxed))
+	{
+		indexExport(exports.size() - 1);
+	}
 }
 
 /**
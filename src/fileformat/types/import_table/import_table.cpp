@@ -165,11 +165,31 @@ const Import* ImportTable::getImport(std::size_t importIndex) const
  */
 const Import* ImportTable::getImport(const std::string &name) const
 {
-	for(const auto &i : imports)
+	buildIndexes();
+	auto it = importsByName.find(name);
+	return it != importsByName.end() ? imports[it->second].get() : nullptr;
+}
+
+/**
+ * Get import by ordinal number
+ * @param libraryName Name of the library the import is imported from
+ * @param ordinalNumber Ordinal number of the import
+ * @return Pointer to import with the specified ordinal number or @c nullptr if such import not found
+ */
+const Import* ImportTable::getImport(const std::string &libraryName, std::uint64_t ordinalNumber) const
+{
+	buildIndexes();
+	for(std::size_t i = 0, e = getNumberOfLibraries(); i < e; ++i)
 	{
-		if(i->getName() == name)
+		if(libraries[i] != libraryName)
+		{
+			continue;
+		}
+
+		auto it = importsByOrdinal.find({i, ordinalNumber});
+		if(it != importsByOrdinal.end())
 		{
-			return i.get();
+			return imports[it->second].get();
 		}
 	}
 
@@ -183,15 +203,58 @@ const Import* ImportTable::getImport(const std::string &name) const
  */
 const Import* ImportTable::getImportOnAddress(unsigned long long address) const
 {
-	for(const auto &i : imports)
+	buildIndexes();
+	auto it = importsByAddress.find(address);
+	return it != importsByAddress.end() ? imports[it->second].get() : nullptr;
+}
+
+/**
+ * Add import to lookup indexes, unless there already is import with the same key
+ * @param importIndex Index of the import (indexed from 0)
+ */
+void ImportTable::indexImport(std::size_t importIndex) const
+{
+	const auto &imp = imports[importIndex];
+	importsByName.emplace(imp->getName(), importIndex);
+	importsByAddress.emplace(imp->getAddress(), importIndex);
+
+	std::uint64_t ordinalNumber;
+	if(imp->getOrdinalNumber(ordinalNumber))
 	{
-		if(i->getAddress() == address)
-		{
-			return i.get();
-		}
+		importsByOrdinal.emplace(std::make_pair(imp->getLibraryIndex(), ordinalNumber), importIndex);
 	}
+}
 
-	return nullptr;
+/**
+ * Build lookup indexes of imports if they are not built yet
+ *
+ * Indexes are built on the first lookup, so tables which are never searched
+ * do not pay for them. Once built, they are kept up to date by @c addImport().
+ */
+void ImportTable::buildIndexes() const
+{
+	if(indexesValid.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(indexesMutex);
+	if(indexesValid.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	importsByName.clear();
+	importsByAddress.clear();
+	importsByOrdinal.clear();
+	importsByName.reserve(imports.size());
+	importsByAddress.reserve(imports.size());
+	for(std::size_t i = 0, e = imports.size(); i < e; ++i)
+	{
+		indexImport(i);
+	}
+
+	indexesValid.store(true, std::memory_order_release);
 }
 
 /**
@@ -286,9 +349,7 @@ void ImportTable::computeHashes()
 		const int show_version = 1;
 		impHashTlsh = toLower(tlsh.getHash(show_version));
 
-		impHashCrc32 = getCrc32(data, impHashBytes.size());
-		impHashMd5 = getMd5(data, impHashBytes.size());
-		impHashSha256 = getSha256(data, impHashBytes.size());
+		getCrc32Md5Sha256(data, impHashBytes.size(), impHashCrc32, impHashMd5, impHashSha256);
 	}
 }
 
@@ -299,6 +360,7 @@ void ImportTable::clear()
 {
 	libraries.clear();
 	imports.clear();
+	indexesValid.store(false, std::memory_order_release);
 	impHashCrc32.clear();
 	impHashMd5.clear();
 	impHashSha256.clear();
@@ -325,6 +387,12 @@ void ImportTable::addLibrary(std::string name, bool isMissingDependency)
 void ImportTable::addImport(std::unique_ptr<Import>&& import)
 {
 	imports.push_back(std::move(import));
+
+	std::lock_guard<std::mutex> lock(indexesMutex);
+	if(indexesValid.load(std::memory_order_relaxed))
+	{
+		indexImport(imports.size() - 1);
+	}
 }
 
 /**
@@ -512,9 +512,7 @@ void ResourceTable::computeIconHashes()
 		return;
 	}
 
-	iconHashCrc32 = getCrc32(iconHashBytes.data(), iconHashBytes.size());
-	iconHashMd5 = getMd5(iconHashBytes.data(), iconHashBytes.size());
-	iconHashSha256 = getSha256(iconHashBytes.data(), iconHashBytes.size());
+	getCrc32Md5Sha256(iconHashBytes.data(), iconHashBytes.size(), iconHashCrc32, iconHashMd5, iconHashSha256);
 	iconPerceptualAvgHash = computePerceptualAvgHash(*priorIcon);
 }
 
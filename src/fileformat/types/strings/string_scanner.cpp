@@ -0,0 +1,305 @@
+/**
+ * @file src/fileformat/types/strings/string_scanner.cpp
+ * @brief Detection of strings in raw data.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <thread>
+
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+namespace retdec {
+namespace fileformat {
+
+namespace
+{
+
+/// Number of bytes classified at once, one bit of a mask per byte.
+const std::size_t BLOCK_SIZE = 64;
+
+/// Data at least this large are split into chunks scanned in parallel.
+const std::size_t PARALLEL_SCAN_MIN_SIZE = 0x400000;
+
+/// Minimal size of a chunk scanned by one thread.
+const std::size_t PARALLEL_SCAN_MIN_CHUNK_SIZE = 0x100000;
+
+/// Start of a run which is not being tracked.
+const std::size_t NO_RUN = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Is @a c a printable character? These are the same characters as the ones
+ * accepted by @c std::isprint() in the "C" locale.
+ */
+bool isPrintable(std::uint8_t c)
+{
+	return c >= 0x20 && c < 0x7f;
+}
+
+/**
+ * Index of the lowest set bit of @a x, which must not be zero.
+ */
+unsigned countTrailingZeros(std::uint64_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#else
+	static const unsigned index[64] = {
+		 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+		62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+		63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+		46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+	};
+	return index[((x & (~x + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+#endif
+}
+
+/**
+ * Does an ASCII character start at @a pos?
+ */
+bool isAsciiChar(const std::uint8_t *data, std::size_t size, std::size_t pos)
+{
+	return pos < size && isPrintable(data[pos]);
+}
+
+/**
+ * Does a wide character start at @a pos? Its printable byte is the first
+ * one in little endian and the second one in big endian, the other byte is
+ * zero.
+ */
+bool isWideChar(const std::uint8_t *data, std::size_t size, std::size_t pos,
+		bool bigEndian)
+{
+	if (pos + 1 >= size)
+		return false;
+
+	return bigEndian
+		? data[pos] == 0 && isPrintable(data[pos + 1])
+		: isPrintable(data[pos]) && data[pos + 1] == 0;
+}
+
+/**
+ * Computes the masks of characters starting in the block at @a base. Bit @c i
+ * of @a ascii (@a wide) is set if an ASCII (wide) character starts at byte
+ * <tt>base + i</tt>. Bytes behind the end of the data are not characters.
+ *
+ * The loop has no branches, so the compiler is free to vectorize it.
+ */
+void getCharacterMasks(const std::uint8_t *data, std::size_t size,
+		std::size_t base, bool bigEndian, std::uint64_t &ascii, std::uint64_t &wide)
+{
+	std::uint64_t printable = 0;
+	std::uint64_t zero = 0;
+	if (base < size)
+	{
+		const auto *block = data + base;
+		const auto blockSize = std::min(BLOCK_SIZE, size - base);
+		for (std::size_t i = 0; i < blockSize; ++i)
+		{
+			printable |= static_cast<std::uint64_t>(isPrintable(block[i])) << i;
+			zero |= static_cast<std::uint64_t>(block[i] == 0) << i;
+		}
+	}
+
+	// The second byte of the last wide character is in the next block.
+	std::uint64_t nextPrintable = 0;
+	std::uint64_t nextZero = 0;
+	if (base + BLOCK_SIZE < size)
+	{
+		nextPrintable = isPrintable(data[base + BLOCK_SIZE]);
+		nextZero = data[base + BLOCK_SIZE] == 0;
+	}
+
+	ascii = printable;
+	wide = bigEndian
+		? zero & ((printable >> 1) | (nextPrintable << (BLOCK_SIZE - 1)))
+		: printable & ((zero >> 1) | (nextZero << (BLOCK_SIZE - 1)));
+}
+
+/**
+ * Finds runs of characters of one type in consecutive blocks and reports
+ * the ones which are long enough as strings.
+ *
+ * Wide characters may start at even as well as odd bytes, so their runs
+ * are tracked for each parity separately.
+ */
+class RunTracker
+{
+	public:
+		RunTracker(StringType type, std::size_t charSize, std::size_t minLength,
+				std::vector<StringRange> &ranges)
+			: type(type), charSize(charSize), minLength(minLength), ranges(ranges) {}
+
+		/**
+		 * Sets whether the bytes just before the first block start characters.
+		 * Their bits are at the top of @a valid, as if they were in a block
+		 * preceding the first one.
+		 */
+		void setPreviousBlock(std::uint64_t valid)
+		{
+			prevValid = valid;
+		}
+
+		/**
+		 * Processes the mask of characters of the block at @a base. Only
+		 * runs starting at bits set in @a startMask are reported.
+		 */
+		void processBlock(std::uint64_t valid, std::size_t base, std::uint64_t startMask)
+		{
+			auto previous = (valid << charSize) | (prevValid >> (BLOCK_SIZE - charSize));
+			auto starts = valid & ~previous & startMask;
+			auto ends = ~valid & previous;
+			prevValid = valid;
+
+			for (auto events = starts | ends; events; events &= events - 1)
+			{
+				auto bit = countTrailingZeros(events);
+				auto &start = runStart[bit % charSize];
+				if (starts & (std::uint64_t(1) << bit))
+				{
+					start = base + bit;
+				}
+				else if (start != NO_RUN)
+				{
+					auto length = (base + bit - start) / charSize;
+					if (length >= minLength)
+						ranges.push_back({type, start, length});
+					start = NO_RUN;
+				}
+			}
+		}
+
+		/**
+		 * Is there a run which has not ended yet?
+		 */
+		bool hasOpenRun() const
+		{
+			return runStart[0] != NO_RUN || runStart[1] != NO_RUN;
+		}
+
+	private:
+		StringType type;
+		std::size_t charSize;
+		std::size_t minLength;
+		std::vector<StringRange> &ranges;
+		std::uint64_t prevValid = 0;
+		std::size_t runStart[2] = {NO_RUN, NO_RUN};
+};
+
+/**
+ * Finds strings starting in <tt>[from, to)</tt>. The strings may end behind
+ * @a to; the ones starting before @a from are left for the preceding chunk.
+ */
+void scanChunk(const std::uint8_t *data, std::size_t size, std::size_t from,
+		std::size_t to, std::size_t minLength, bool bigEndian,
+		std::vector<StringRange> &ranges)
+{
+	RunTracker ascii(StringType::Ascii, 1, minLength, ranges);
+	RunTracker wide(StringType::Wide, 2, minLength, ranges);
+
+	const auto topBit = std::uint64_t(1) << (BLOCK_SIZE - 1);
+	if (from >= 1)
+	{
+		ascii.setPreviousBlock(isAsciiChar(data, size, from - 1) ? topBit : 0);
+		wide.setPreviousBlock((isWideChar(data, size, from - 1, bigEndian) ? topBit : 0)
+			| (from >= 2 && isWideChar(data, size, from - 2, bigEndian) ? topBit >> 1 : 0));
+	}
+
+	// Blocks behind the end of the data have no characters, so the loop ends
+	// at the latest one block behind the end, when all the runs are closed.
+	for (auto base = from; base < to || ascii.hasOpenRun() || wide.hasOpenRun(); base += BLOCK_SIZE)
+	{
+		std::uint64_t asciiMask, wideMask;
+		getCharacterMasks(data, size, base, bigEndian, asciiMask, wideMask);
+
+		std::uint64_t startMask = 0;
+		if (base < to)
+		{
+			startMask = to - base >= BLOCK_SIZE
+				? ~std::uint64_t(0)
+				: (std::uint64_t(1) << (to - base)) - 1;
+		}
+
+		ascii.processBlock(asciiMask, base, startMask);
+		wide.processBlock(wideMask, base, startMask);
+	}
+}
+
+} // anonymous namespace
+
+/**
+ * Find ASCII and wide strings in @a data in a single pass.
+ * @param data Data to search in.
+ * @param size Size of @a data.
+ * @param minLength Minimal number of characters of a string.
+ * @param bigEndian Are the wide characters big endian?
+ * @return Found strings, ordered by offset for each type.
+ *
+ * String is a maximal run of printable characters. Wide characters have
+ * two bytes, one of them printable and the other one zero.
+ *
+ * Bytes are classified in blocks of 64, and runs are found by bit operations
+ * over the masks of the blocks. Large data are split into chunks scanned in
+ * parallel.
+ */
+std::vector<StringRange> findStrings(const std::uint8_t *data, std::size_t size,
+		std::size_t minLength, bool bigEndian)
+{
+	std::vector<StringRange> ranges;
+
+	const std::size_t numOfThreads = std::thread::hardware_concurrency();
+	if (size < PARALLEL_SCAN_MIN_SIZE || numOfThreads < 2)
+	{
+		scanChunk(data, size, 0, size, minLength, bigEndian, ranges);
+		return ranges;
+	}
+
+	const auto numOfChunks = std::min(numOfThreads, size / PARALLEL_SCAN_MIN_CHUNK_SIZE);
+	const auto chunkSize = (size + numOfChunks - 1) / numOfChunks;
+	std::vector<std::future<std::vector<StringRange>>> chunks;
+	for (std::size_t from = 0; from < size; from += chunkSize)
+	{
+		const auto to = std::min(size, from + chunkSize);
+		chunks.push_back(std::async(std::launch::async, [=]() {
+			std::vector<StringRange> chunkRanges;
+			scanChunk(data, size, from, to, minLength, bigEndian, chunkRanges);
+			return chunkRanges;
+		}));
+	}
+
+	for (auto &chunk : chunks)
+	{
+		auto chunkRanges = chunk.get();
+		ranges.insert(ranges.end(), chunkRanges.begin(), chunkRanges.end());
+	}
+	return ranges;
+}
+
+/**
+ * Get content of a string found by @c findStrings().
+ * @param data Data in which the string was found.
+ * @param range Position of the string.
+ * @param bigEndian Are the wide characters big endian?
+ * @return Printable characters of the string.
+ */
+std::string getStringContent(const std::uint8_t *data, const StringRange &range,
+		bool bigEndian)
+{
+	const auto *first = data + range.offset;
+	if (range.type == StringType::Ascii)
+		return std::string(first, first + range.length);
+
+	if (bigEndian)
+		++first;
+
+	std::string content;
+	content.reserve(range.length);
+	for (std::size_t i = 0; i < range.length; ++i)
+		content.push_back(static_cast<char>(first[2 * i]));
+	return content;
+}
+
+} // namespace fileformat
+} // namespace retdec
@@ -4,8 +4,11 @@
  * @copyright (c) 2020 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include <openssl/md5.h>
@@ -18,6 +21,18 @@
 namespace retdec {
 namespace fileformat {
 
+namespace
+{
+
+/// Size of blocks in which data are passed to all the digests in one pass.
+/// Block is small enough to stay in CPU cache until all digests are updated.
+const std::uint64_t HASH_BLOCK_SIZE = 0x10000;
+
+/// Data at least this large are hashed by each digest in its own thread.
+const std::uint64_t PARALLEL_HASH_MIN_SIZE = 0x800000;
+
+} // anonymous namespace
+
 /**
  * @brief Count CRC32 of @a data.
  * @param[in] data Input data.
@@ -78,5 +93,55 @@ std::string getSha256(const unsigned char *data, std::uint64_t length)
 	return sha;
 }
 
+/**
+ * @brief Count CRC32, MD5 and SHA256 of @a data.
+ * @param[in] data Input data.
+ * @param[in] length Length of input data.
+ * @param[out] crc32 CRC32 of input data.
+ * @param[out] md5 MD5 of input data.
+ * @param[out] sha256 SHA256 of input data.
+ *
+ * Small data are read only once, all digests are updated block by block.
+ * Large data are hashed by all digests at the same time in separate threads.
+ * The result is the same as from getCrc32(), getMd5() and getSha256().
+ */
+void getCrc32Md5Sha256(const unsigned char *data, std::uint64_t length,
+		std::string &crc32, std::string &md5, std::string &sha256)
+{
+	if (length >= PARALLEL_HASH_MIN_SIZE
+			&& std::thread::hardware_concurrency() > 1)
+	{
+		auto md5Future = std::async(std::launch::async, getMd5, data, length);
+		auto sha256Future = std::async(std::launch::async, getSha256, data, length);
+		crc32 = getCrc32(data, length);
+		md5 = md5Future.get();
+		sha256 = sha256Future.get();
+		return;
+	}
+
+	retdec::utils::CRC32 crc;
+	MD5_CTX md5Ctx;
+	SHA256_CTX sha256Ctx;
+	MD5_Init(&md5Ctx);
+	SHA256_Init(&sha256Ctx);
+
+	for (std::uint64_t offset = 0; offset < length; offset += HASH_BLOCK_SIZE)
+	{
+		auto blockSize = std::min(HASH_BLOCK_SIZE, length - offset);
+		crc.add(data + offset, blockSize);
+		MD5_Update(&md5Ctx, data + offset, blockSize);
+		SHA256_Update(&sha256Ctx, data + offset, blockSize);
+	}
+
+	unsigned char md5Digest[MD5_DIGEST_LENGTH];
+	unsigned char sha256Digest[SHA256_DIGEST_LENGTH];
+	MD5_Final(md5Digest, &md5Ctx);
+	SHA256_Final(sha256Digest, &sha256Ctx);
+
+	crc32 = crc.getHash();
+	retdec::utils::bytesToHexString(md5Digest, MD5_DIGEST_LENGTH, md5, 0, 0, false);
+	retdec::utils::bytesToHexString(sha256Digest, SHA256_DIGEST_LENGTH, sha256, 0, 0, false);
+}
+
 } // namespace fileformat
 } // namespace retdec
@@ -49,6 +49,31 @@ void serializeString(
 			serializeIfValueEmpty);
 }
 
+/**
+ * Remove line breaks and indentation from pretty printed JSON.
+ * All control characters in JSON strings are escaped, so every line break
+ * in @a json was inserted by the writer.
+ */
+std::string removeFormatting(const std::string& json)
+{
+	std::string result;
+	result.reserve(json.size());
+	bool lineStart = false;
+	for (char c : json)
+	{
+		if (c == '\n')
+		{
+			lineStart = true;
+		}
+		else if (!lineStart || (c != ' ' && c != '\t'))
+		{
+			result.push_back(c);
+			lineStart = false;
+		}
+	}
+	return result;
+}
+
 /**
  * Present information from simple getter
  * @param getter Instance of SimpleGetter class
@@ -1299,6 +1324,18 @@ void presentPeTimestamps(JsonPresentation::Writer& writer, FileInformation& file
 }
 
 bool JsonPresentation::present()
+{
+	Log::info() << getJsonString() << std::endl;
+	return true;
+}
+
+/**
+ * Get all presented information as JSON.
+ * @param singleLine Print the whole JSON on a single line (e.g. as one
+ *    record of newline delimited JSON).
+ * @return Presented information
+ */
+std::string JsonPresentation::getJsonString(bool singleLine)
 {
 	rapidjson::StringBuffer sb;
 	Writer writer(sb);
@@ -1374,9 +1411,44 @@ bool JsonPresentation::present()
 	presentIterativeSubtitle(writer, StringsJsonGetter(fileinfo));
 
 	writer.EndObject();
-	Log::info() << sb.GetString() << std::endl;
 
-	return true;
+	return singleLine ? removeFormatting(sb.GetString()) : sb.GetString();
+}
+
+/**
+ * Replace path to the input file in JSON produced by @c getJsonString().
+ * This allows to reuse the JSON for files with the same content.
+ * @param json JSON produced by @c getJsonString()
+ * @param pathToFile New path to the input file
+ * @param singleLine Print the whole JSON on a single line
+ * @return JSON with the new path or empty string if @a json is not valid
+ */
+std::string JsonPresentation::replaceInputFile(
+		const std::string &json,
+		const std::string &pathToFile,
+		bool singleLine)
+{
+	rapidjson::Document root;
+	if(root.Parse(json).HasParseError() || !root.IsObject())
+	{
+		return std::string();
+	}
+
+	const auto path = utils::replaceNonprintableChars(pathToFile);
+	auto it = root.FindMember("inputFile");
+	if(it != root.MemberEnd())
+	{
+		it->value.SetString(path, root.GetAllocator());
+	}
+
+	rapidjson::StringBuffer sb;
+	rapidjson::PrettyWriter<
+			rapidjson::StringBuffer,
+			rapidjson::UTF8<>,
+			rapidjson::ASCII<>> writer(sb);
+	root.Accept(writer);
+
+	return singleLine ? removeFormatting(sb.GetString()) : sb.GetString();
 }
 
 } // namespace fileinfo
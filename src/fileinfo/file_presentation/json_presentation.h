@@ -7,6 +7,7 @@
 #ifndef FILEINFO_FILE_PRESENTATION_JSON_PRESENTATION_H
 #define FILEINFO_FILE_PRESENTATION_JSON_PRESENTATION_H
 
+#include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/encodings.h>
@@ -66,6 +67,12 @@ class JsonPresentation : public FilePresentation
 		JsonPresentation(FileInformation &fileinfo_, bool verbose_);
 
 		virtual bool present() override;
+		std::string getJsonString(bool singleLine = false);
+
+		static std::string replaceInputFile(
+				const std::string &json,
+				const std::string &pathToFile,
+				bool singleLine = false);
 };
 
 } // namespace fileinfo
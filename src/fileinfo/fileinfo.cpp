@@ -4,7 +4,17 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <regex>
+#include <sstream>
+#include <system_error>
+#include <thread>
 
 #include <rapidjson/document.h>
 #include <llvm/Support/ErrorHandling.h>
@@ -12,15 +22,18 @@
 #include "retdec/utils/binary_path.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/result_cache.h"
 #include "retdec/utils/io/log.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/version.h"
 #include "retdec/ar-extractor/detection.h"
 #include "retdec/cpdetect/errors.h"
 #include "retdec/cpdetect/settings.h"
+#include "retdec/fileformat/utils/crypto.h"
 #include "retdec/fileformat/utils/format_detection.h"
 #include "retdec/fileformat/utils/other.h"
 #include "retdec/serdes/std.h"
+#include "retdec/yaracpp/yara_detector.h"
 #include "fileinfo/file_detector/detector_factory.h"
 #include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_presentation/config_presentation.h"
@@ -76,6 +89,12 @@ struct ProgParams
 	std::size_t epBytesCount = EP_BYTES_SIZE;
 	/// load flags for `fileformat`
 	LoadFlags loadFlags = LoadFlags::NONE;
+	/// directory or file with list of files to process in the batch mode
+	std::string batchInput;
+	/// number of files processed in parallel in the batch mode
+	std::size_t batchWorkers = 0;
+	/// directory with cached results, empty if results are not cached
+	std::string cacheDirectory;
 
 	friend std::ostream& operator<<(std::ostream& os, const ProgParams& pp);
 };
@@ -96,6 +115,9 @@ std::ostream& operator<<(std::ostream& os, const ProgParams& pp)
 	os << "max half memory    : " << pp.maxMemoryHalfRAM << "\n";
 	os << "ep bytes count     : " << pp.epBytesCount << "\n";
 	os << "load flags         : " << pp.loadFlags << "\n";
+	os << "batch input        : " << pp.batchInput << "\n";
+	os << "batch workers      : " << pp.batchWorkers << "\n";
+	os << "cache directory    : " << pp.cacheDirectory << "\n";
 
 	os << "yara malware rules : " << "\n";
 	for (auto& r : pp.yaraMalwarePaths)
@@ -153,7 +175,8 @@ void printHelp()
 				<< "For compiler detection, program looks in the input file for YARA patterns.\n"
 				<< "According to them, it determines compiler or packer used for file creation.\n"
 				<< "Supported file formats are: " + joinStrings(getSupportedFileFormats()) + ".\n\n"
-				<< "Usage: fileinfo [options] file\n\n"
+				<< "Usage: fileinfo [options] file\n"
+				<< "       fileinfo [options] --batch=dirOrList\n\n"
 				<< "Options list:\n"
 				<< "    --help, -h            Display this help.\n"
 				<< "    --version             Display program's version.\n"
@@ -222,7 +245,29 @@ void printHelp()
 				<< "\n"
 				<< "Options for specifying list of available DLLs:\n"
 				<< "    --dlls=filename\n"
-				<< "                          Load the list of present DLLs from the file.\n";
+				<< "                          Load the list of present DLLs from the file.\n"
+				<< "\n"
+				<< "Options for processing many files at once:\n"
+				<< "    --batch=dirOrList\n"
+				<< "                          Process all files in the directory (recursively) or\n"
+				<< "                          all files from the list (one path per line) instead\n"
+				<< "                          of a single file. Output is always in JSON format,\n"
+				<< "                          one record per line, in the order of completion.\n"
+				<< "                          Errors are reported in the records of the files,\n"
+				<< "                          the exit code is non-zero if any of them failed.\n"
+				<< "                          Option \"--config\" cannot be used.\n"
+				<< "    --batch-workers=N\n"
+				<< "                          Number of files processed in parallel in the batch\n"
+				<< "                          mode (0 means number of CPU cores, default).\n"
+				<< "\n"
+				<< "Options for caching of results:\n"
+				<< "    --cache-dir=dir\n"
+				<< "                          Cache JSON output in the directory, keyed by SHA256\n"
+				<< "                          of the file content and by the options. Files with\n"
+				<< "                          cached output are not analyzed again. Plain text\n"
+				<< "                          output and option \"--config\" are not cached.\n"
+				<< "                          Compiled YARA rules are cached in its subdirectory\n"
+				<< "                          \"yara-rules\" instead of the per-user cache directory.\n";
 }
 
 std::string getParamOrDie(const std::vector<std::string> &argv, std::size_t &i)
@@ -514,7 +559,7 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 	std::set<std::string> withArgs = {
 			"malware", "m", "crypto", "C", "other", "o", "config",
 			"fileinfo-config", "c", "no-hashes", "max-memory", "ep-bytes",
-			"dlls"
+			"dlls", "batch", "batch-workers", "cache-dir"
 	};
 	for (int i = 1; i < argc; ++i)
 	{
@@ -687,6 +732,20 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 
 			params.dllListFile = dllListFile;
 		}
+		else if (c == "--batch")
+		{
+			params.batchInput = getParamOrDie(argv, i);
+		}
+		else if (c == "--batch-workers")
+		{
+			auto batchWorkersString = getParamOrDie(argv, i);
+			if (!strToNum(batchWorkersString, params.batchWorkers))
+				return false;
+		}
+		else if (c == "--cache-dir")
+		{
+			params.cacheDirectory = getParamOrDie(argv, i);
+		}
 		else if (params.filePath.empty())
 		{
 			params.filePath = argv[i];
@@ -697,6 +756,11 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 		}
 	}
 
+	if(!params.batchInput.empty())
+	{
+		return params.filePath.empty() && !params.generateConfigFile;
+	}
+
 	if(params.filePath.empty())
 	{
 		return false;
@@ -723,6 +787,405 @@ void limitMaximalMemoryIfRequested(const ProgParams& params)
 	}
 }
 
+/**
+ * Detect all information about the input file.
+ * @param params Program parameters
+ * @param config Configuration file to use or @c nullptr
+ * @param searchPar Parameters for detection of used compiler
+ * @param fileinfo Information about the file, path to the file and its
+ *    format must be already set
+ * @return Detector of the file, it must exist as long as @a fileinfo is used
+ */
+std::unique_ptr<FileDetector> analyzeFile(
+		const ProgParams& params,
+		retdec::config::Config* config,
+		DetectParams& searchPar,
+		FileInformation& fileinfo)
+{
+	const auto fileFormat = fileinfo.getFileFormatEnum();
+	const auto filePath = fileinfo.getPathToFile();
+	if(fileFormat == Format::UNDETECTABLE)
+	{
+		fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
+		return nullptr;
+	}
+
+	std::unique_ptr<FileDetector> fileDetector(createFileDetector(filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags));
+	if(fileDetector)
+	{
+		if(!fileDetector->getFileParser()->isInValidState())
+		{
+			// Check if Mach-O is archive.
+			if (fileFormat == Format::MACHO)
+			{
+				auto machoDetecor = static_cast<MachODetector*>(fileDetector.get());
+				if (machoDetecor->isMachoUniversalArchive())
+				{
+					fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
+					return fileDetector;
+				}
+			}
+
+			fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			return fileDetector;
+		}
+
+		if(config)
+		{
+			fileDetector->setConfigFile(*config);
+		}
+		fileDetector->getAllInformation();
+	}
+	else
+	{
+		if(isArchive(filePath))
+		{
+			fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
+		}
+		else
+		{
+			fileinfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
+		}
+	}
+	PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, fileinfo);
+	patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
+	patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
+	patternDetector.addFilePaths("other", params.yaraOtherPaths);
+	patternDetector.analyze();
+
+	return fileDetector;
+}
+
+/**
+ * Get the key of cached results: SHA256 of the file content and SHA256 of
+ * fileinfo version, of the options the results depend on, and of stamps
+ * (size and modification time) of the used signature files.
+ * @param params Program parameters
+ * @param filePath Path to the file
+ * @return Key or empty string if the file can not be read
+ */
+std::string getCacheKey(const ProgParams& params, const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if(!file)
+	{
+		return std::string();
+	}
+	const std::string content(
+			(std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+
+	std::ostringstream options;
+	options << version::getVersionStringLong() << "\n";
+	options << params.searchMode << "\n";
+	options << params.internalDatabase << " " << params.externalDatabase << "\n";
+	options << params.epBytesCount << " " << params.loadFlags << "\n";
+	options << params.dllListFile << "\n";
+	for(const auto* paths : {&params.yaraMalwarePaths, &params.yaraCryptoPaths, &params.yaraOtherPaths})
+	{
+		for(const auto& path : *paths)
+		{
+			options << path << "\t";
+		}
+		options << "\n";
+	}
+
+	// Results depend also on the content of the used rules and lists, which
+	// may change without changing their paths.
+	std::vector<std::string> usedFiles;
+	for(const auto* paths : {&params.yaraMalwarePaths, &params.yaraCryptoPaths, &params.yaraOtherPaths})
+	{
+		usedFiles.insert(usedFiles.end(), paths->begin(), paths->end());
+	}
+	if(!params.dllListFile.empty())
+	{
+		usedFiles.push_back(params.dllListFile);
+	}
+	if(params.internalDatabase)
+	{
+		usedFiles.push_back((getThisBinaryDirectoryPath() / YARA_RULES_PATH).string());
+	}
+	if(params.externalDatabase)
+	{
+		std::error_code ec;
+		std::vector<std::string> externalFiles;
+		for(fs::directory_iterator it(".", ec), end; !ec && it != end; it.increment(ec))
+		{
+			const auto path = it->path().string();
+			if(fs::is_regular_file(it->path(), ec) && endsWith(path, EXTERNAL_DATABASE_SUFFIXES))
+			{
+				externalFiles.push_back(path);
+			}
+		}
+		std::sort(externalFiles.begin(), externalFiles.end());
+		usedFiles.insert(usedFiles.end(), externalFiles.begin(), externalFiles.end());
+	}
+	options << ResultCache::getFilesStamp(usedFiles);
+	const auto optionsString = options.str();
+
+	return getSha256(reinterpret_cast<const unsigned char*>(content.data()), content.size())
+		+ "-" + getSha256(reinterpret_cast<const unsigned char*>(optionsString.data()), optionsString.size());
+}
+
+/**
+ * Detect all information about the input file and present it as JSON.
+ * If the result cache is enabled, the JSON is loaded from the cache if
+ * possible, and stored in the cache otherwise.
+ * @param params Program parameters
+ * @param config Configuration file to use or @c nullptr
+ * @param searchPar Parameters for detection of used compiler
+ * @param fileinfo Information about the file, path to the file and its
+ *    format must be already set
+ * @param singleLine Print the whole JSON on a single line
+ * @return Information about the file as JSON
+ */
+std::string getJsonInformation(
+		const ProgParams& params,
+		retdec::config::Config* config,
+		DetectParams& searchPar,
+		FileInformation& fileinfo,
+		bool singleLine)
+{
+	const std::string jsonArtifact = "fileinfo.json";
+	const std::string verboseJsonArtifact = "fileinfo-verbose.json";
+	const std::string statusArtifact = "status";
+
+	ResultCache cache(params.cacheDirectory);
+	const auto cacheKey = cache.isEnabled()
+			? getCacheKey(params, fileinfo.getPathToFile())
+			: std::string();
+
+	ResultCache::Artifacts artifacts;
+	if(!cacheKey.empty() && cache.load(cacheKey, artifacts))
+	{
+		const auto& json = artifacts[params.verbose ? verboseJsonArtifact : jsonArtifact];
+		int status = 0;
+		auto output = JsonPresentation::replaceInputFile(json, fileinfo.getPathToFile(), singleLine);
+		if(!output.empty() && strToNum(artifacts[statusArtifact], status))
+		{
+			fileinfo.setStatus(static_cast<ReturnCode>(status));
+			return output;
+		}
+	}
+
+	const auto fileDetector = analyzeFile(params, config, searchPar, fileinfo);
+	auto output = JsonPresentation(fileinfo, params.verbose).getJsonString(singleLine);
+	if(!cacheKey.empty())
+	{
+		cache.store(cacheKey, {
+				{jsonArtifact, JsonPresentation(fileinfo, false).getJsonString()},
+				{verboseJsonArtifact, JsonPresentation(fileinfo, true).getJsonString()},
+				{statusArtifact, std::to_string(static_cast<int>(fileinfo.getStatus()))}
+		});
+	}
+	return output;
+}
+
+/**
+ * Get a single-line JSON record about a file whose analysis failed
+ * @param pathToFile Path to the file
+ * @param message Description of the failure
+ * @return JSON record with the path and the error message
+ */
+std::string getJsonError(const std::string& pathToFile, const std::string& message)
+{
+	FileInformation fileinfo;
+	fileinfo.setPathToFile(pathToFile);
+	fileinfo.setStatus(ReturnCode::FILE_PROBLEM);
+	fileinfo.messages.push_back("Error: " + message);
+	return JsonPresentation(fileinfo, false).getJsonString(true);
+}
+
+/**
+ * Process all files from the batch input in a pool of worker threads and
+ * print information about each of them as one line of JSON.
+ * @param params Program parameters
+ * @return Program status, @c ReturnCode::FILE_PROBLEM if a fatal error
+ *    occurred for at least one of the files
+ *
+ * The input is either a directory, whose regular files are processed
+ * recursively, or a file with one path per line. Configuration and YARA
+ * rules are loaded only once and shared by all files. A failure on one file
+ * does not stop the processing of the others, its record then contains the
+ * error.
+ */
+ReturnCode runBatch(const ProgParams& params)
+{
+	std::unique_ptr<fs::recursive_directory_iterator> dirIt;
+	std::ifstream listFile;
+	std::error_code ec;
+	if(fs::is_directory(params.batchInput, ec))
+	{
+		dirIt = std::make_unique<fs::recursive_directory_iterator>(
+				params.batchInput,
+				fs::directory_options::skip_permission_denied,
+				ec);
+	}
+	else
+	{
+		listFile.open(params.batchInput);
+	}
+	if(ec || (!dirIt && !listFile))
+	{
+		Log::error() << Log::Error << "Failed to read batch input \""
+				<< params.batchInput << "\"!\n";
+		return ReturnCode::FILE_PROBLEM;
+	}
+
+	std::size_t workers = params.batchWorkers;
+	if(workers == 0)
+	{
+		workers = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Paths are read ahead of the workers only up to this limit, so a huge
+	// input does not have to be held in memory.
+	const std::size_t maxQueuedFiles = 4 * workers;
+	std::queue<std::string> files;
+	bool inputEnd = false;
+	std::mutex filesMutex;
+	std::condition_variable filesCv;
+	std::condition_variable queueCv;
+	std::mutex outMutex;
+	std::atomic<bool> failed(false);
+
+	auto worker = [&]()
+	{
+		while(true)
+		{
+			std::string filePath;
+			{
+				std::unique_lock<std::mutex> lock(filesMutex);
+				filesCv.wait(lock, [&]() { return inputEnd || !files.empty(); });
+				if(files.empty())
+				{
+					return;
+				}
+				filePath = std::move(files.front());
+				files.pop();
+			}
+			queueCv.notify_one();
+
+			std::string record;
+			ReturnCode status = ReturnCode::OK;
+			try
+			{
+				retdec::config::Config config;
+				DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
+				FileInformation fileinfo;
+				fileinfo.setPathToFile(filePath);
+				fileinfo.setFileFormatEnum(detectFileFormat(filePath));
+				record = getJsonInformation(params, &config, searchPar, fileinfo, true);
+				status = fileinfo.getStatus();
+			}
+			catch(const std::exception& e)
+			{
+				record = getJsonError(filePath, e.what());
+				status = ReturnCode::FILE_PROBLEM;
+			}
+			catch(...)
+			{
+				record = getJsonError(filePath, "Unknown error.");
+				status = ReturnCode::FILE_PROBLEM;
+			}
+
+			if(isFatalError(status))
+			{
+				failed = true;
+			}
+
+			std::lock_guard<std::mutex> lock(outMutex);
+			Log::info() << record << std::endl;
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for(std::size_t i = 0; i < workers; ++i)
+	{
+		try
+		{
+			pool.emplace_back(worker);
+		}
+		catch(const std::system_error&)
+		{
+			// Files are processed by the workers that could be started.
+			break;
+		}
+	}
+	if(pool.empty())
+	{
+		Log::error() << Log::Error << "Failed to start batch workers!\n";
+		return ReturnCode::FILE_PROBLEM;
+	}
+
+	auto addFile = [&](std::string filePath)
+	{
+		{
+			std::unique_lock<std::mutex> lock(filesMutex);
+			queueCv.wait(lock, [&]() { return files.size() < maxQueuedFiles; });
+			files.push(std::move(filePath));
+		}
+		filesCv.notify_one();
+	};
+
+	// Workers must be joined whatever happens to the input, so nothing may
+	// escape from reading it.
+	try
+	{
+		if(dirIt)
+		{
+			const fs::recursive_directory_iterator end;
+			for(auto& it = *dirIt; !ec && it != end; it.increment(ec))
+			{
+				std::error_code fileEc;
+				if(it->is_regular_file(fileEc))
+				{
+					addFile(it->path().string());
+				}
+			}
+			if(ec)
+			{
+				Log::error() << Log::Error << "Failed to read batch input \""
+						<< params.batchInput << "\": " << ec.message() << "\n";
+				failed = true;
+			}
+		}
+		else
+		{
+			std::string line;
+			while(std::getline(listFile, line))
+			{
+				if(!line.empty() && line.back() == '\r')
+				{
+					line.pop_back();
+				}
+				if(!line.empty())
+				{
+					addFile(line);
+				}
+			}
+		}
+	}
+	catch(const std::exception& e)
+	{
+		Log::error() << Log::Error << "Failed to read batch input \""
+				<< params.batchInput << "\": " << e.what() << "\n";
+		failed = true;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(filesMutex);
+		inputEnd = true;
+	}
+	filesCv.notify_all();
+	for(auto& t : pool)
+	{
+		t.join();
+	}
+
+	return failed ? ReturnCode::FILE_PROBLEM : ReturnCode::OK;
+}
+
 } // anonymous namespace
 
 /**
@@ -750,6 +1213,16 @@ int main(int argc, char* argv[])
 
 	limitMaximalMemoryIfRequested(params);
 
+	if(!params.cacheDirectory.empty())
+	{
+		retdec::yaracpp::YaraDetector::setRulesCacheDirectory((fs::path(params.cacheDirectory) / "yara-rules").string());
+	}
+
+	if(!params.batchInput.empty())
+	{
+		return static_cast<int>(runBatch(params));
+	}
+
 	bool useConfig = true;
 	retdec::config::Config config;
 	if(params.generateConfigFile && !params.configFile.empty())
@@ -769,76 +1242,28 @@ int main(int argc, char* argv[])
 	}
 
 	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
-	const auto fileFormat = detectFileFormat(params.filePath, useConfig && config.fileFormat.isRaw());
 	FileInformation fileinfo;
-	FileDetector *fileDetector = nullptr;
 	fileinfo.setPathToFile(params.filePath);
-	fileinfo.setFileFormatEnum(fileFormat);
+	fileinfo.setFileFormatEnum(detectFileFormat(params.filePath, useConfig && config.fileFormat.isRaw()));
 	ErrorHandlerInfo hInfo { &params, &fileinfo };
 	llvm::install_fatal_error_handler(fatalErrorHandler, &hInfo);
-	switch(fileFormat)
-	{
-		case Format::UNDETECTABLE:
-		{
-			fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
-			break;
-		}
-		default:
-		{
-			fileDetector = createFileDetector(params.filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags);
-			if(fileDetector)
-			{
-				if(!fileDetector->getFileParser()->isInValidState())
-				{
-					// Check if Mach-O is archive.
-					if (fileFormat == Format::MACHO)
-					{
-						auto machoDetecor = static_cast<MachODetector*>(fileDetector);
-						if (machoDetecor->isMachoUniversalArchive())
-						{
-							fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
-							break;
-						}
-					}
-
-					fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
-					break;
-				}
-
-				if(useConfig)
-				{
-					fileDetector->setConfigFile(config);
-				}
-				fileDetector->getAllInformation();
-			}
-			else
-			{
-				if(isArchive(params.filePath))
-				{
-					fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
-				}
-				else
-				{
-					fileinfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
-				}
-			}
-			PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, fileinfo);
-			patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
-			patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
-			patternDetector.addFilePaths("other", params.yaraOtherPaths);
-			patternDetector.analyze();
-		}
-	}
+	std::unique_ptr<FileDetector> fileDetector;
 
 	// print results on standard output
 	if(params.plainText)
 	{
+		fileDetector = analyzeFile(params, useConfig ? &config : nullptr, searchPar, fileinfo);
 		PlainPresentation(fileinfo, params.verbose, params.explanatory).present();
 	}
-	else
+	else if(params.generateConfigFile)
 	{
+		fileDetector = analyzeFile(params, useConfig ? &config : nullptr, searchPar, fileinfo);
 		JsonPresentation(fileinfo, params.verbose).present();
 	}
+	else
+	{
+		Log::info() << getJsonInformation(params, useConfig ? &config : nullptr, searchPar, fileinfo, false) << std::endl;
+	}
 
 	// generate configuration file
 	auto res = fileinfo.getStatus();
@@ -852,6 +1277,5 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	delete fileDetector;
 	return isFatalError(res) ? static_cast<int>(res) : static_cast<int>(ReturnCode::OK);
 }
@@ -345,7 +345,14 @@ void PatternDetector::analyze()
 			yara.addRuleFile(item);
 		}
 
-		yara.analyze(fileinfo.getPathToFile());
+		if(fileParser)
+		{
+			yara.analyze(fileParser->getBytes());
+		}
+		else
+		{
+			yara.analyze(fileinfo.getPathToFile());
+		}
 
 		for(const auto &rule : yara.getDetectedRules())
 		{
@@ -125,6 +125,77 @@ ShPtr<DefUseChains> DefUseAnalysis::getDefUseChains(
 	return ducs;
 }
 
+/**
+* @brief Updates the given def-use chains after statements of their function
+*        have been changed.
+*
+* @param[in,out] ducs Def-use chains to be updated.
+* @param[in] vars Variables whose definitions or uses have been changed,
+*                 removed, or added since @a ducs were computed.
+*
+* Only the chains of variables from @a vars are recomputed, the other chains
+* are kept. Since the data-flow equations are independent for every variable,
+* the result is the same as if the chains were computed from scratch by
+* getDefUseChains(). The @c gen, @c kill, @c in, and @c out sets of @a ducs
+* are cleared.
+*
+* @par Preconditions
+*  - @a ducs is non-null
+*  - @c ducs->cfg corresponds to the current code of @c ducs->func
+*  - @a vars contains all variables that were used or defined in the changed
+*    or removed statements before the change, and all variables that are used
+*    or defined in the changed or added statements after the change
+*/
+void DefUseAnalysis::updateDefUseChains(ShPtr<DefUseChains> ducs,
+		const VarSet &vars) {
+	PRECONDITION_NON_NULL(ducs);
+
+	// Compute the data-flow information just for the given variables.
+	auto varsDucs = std::make_shared<DefUseChains>();
+	varsDucs->func = ducs->func;
+	varsDucs->cfg = ducs->cfg;
+	varsDucs->shouldBeIncluded = [&](auto var) {
+		return hasItem(vars, var) && ducs->shouldBeIncluded(var);
+	};
+	computeGenAndKill(varsDucs);
+	computeInAndOut(varsDucs);
+
+	// Keep the chains of the other variables.
+	std::map<DefUseChains::StmtVarPair, StmtSet> keptChains;
+	for (auto &chain : ducs->du) {
+		if (!hasItem(vars, chain.first.second)) {
+			keptChains.emplace(chain.first, std::move(chain.second));
+		}
+	}
+
+	// Rebuild the chains in the same order as computeDefUseChains() does to
+	// keep the result deterministic.
+	ducs->du.clear();
+	for (auto i = ducs->cfg->node_begin(), e = ducs->cfg->node_end();
+			i != e; ++i) {
+		for (auto j = (*i)->stmt_begin(), f = (*i)->stmt_end(); j != f; ++j) {
+			const auto &defVar = getDefVarInStmt(*j);
+			if (!defVar) {
+				continue;
+			}
+
+			if (hasItem(vars, defVar)) {
+				computeDefUseChainForStmt(varsDucs, *i, j, defVar);
+				ducs->du.push_back(std::move(varsDucs->du.back()));
+				varsDucs->du.pop_back();
+			} else {
+				DefUseChains::StmtVarPair def(*j, defVar);
+				ducs->du.emplace_back(def, std::move(keptChains[def]));
+			}
+		}
+	}
+
+	ducs->gen.clear();
+	ducs->kill.clear();
+	ducs->in.clear();
+	ducs->out.clear();
+}
+
 /**
 * @brief Creates a new analysis.
 *
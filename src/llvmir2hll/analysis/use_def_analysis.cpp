@@ -12,6 +12,9 @@
 #include "retdec/llvmir2hll/ir/statement.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/utils/container.h"
+
+using retdec::utils::hasItem;
 
 namespace retdec {
 namespace llvmir2hll {
@@ -66,6 +69,48 @@ ShPtr<UseDefChains> UseDefAnalysis::getUseDefChains(
 	return udcs;
 }
 
+/**
+* @brief Updates the given use-def chains after def-use chains of some
+*        variables have been updated.
+*
+* @param[in,out] udcs Use-def chains to be updated.
+* @param[in] ducs Updated def-use chains.
+* @param[in] vars Variables whose def-use chains have been updated (see
+*                 DefUseAnalysis::updateDefUseChains()).
+*
+* Only the chains of variables from @a vars are recomputed, the other chains
+* are kept.
+*
+* @par Preconditions
+*  - @a udcs and @a ducs are non-null
+*/
+void UseDefAnalysis::updateUseDefChains(ShPtr<UseDefChains> udcs,
+		ShPtr<DefUseChains> ducs, const VarSet &vars) {
+	PRECONDITION_NON_NULL(udcs);
+	PRECONDITION_NON_NULL(ducs);
+
+	// The chains are ordered by variables first, so the chains of a single
+	// variable form a contiguous range.
+	for (const auto &var : vars) {
+		auto i = udcs->ud.lower_bound(
+			UseDefChains::VarStmtPair(var, ShPtr<Statement>()));
+		while (i != udcs->ud.end() && i->first.first == var) {
+			i = udcs->ud.erase(i);
+		}
+	}
+
+	for (const auto &chain : ducs->du) {
+		if (!hasItem(vars, chain.first.second)) {
+			continue;
+		}
+
+		for (const auto &use : chain.second) {
+			UseDefChains::VarStmtPair varStmtPair(chain.first.second, use);
+			udcs->ud[varStmtPair].insert(chain.first.first);
+		}
+	}
+}
+
 /**
 * @brief Creates a new analysis.
 *
@@ -4,6 +4,8 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <mutex>
+
 #include "retdec/llvmir2hll/ir/float_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
 #include "retdec/llvmir2hll/support/visitor.h"
@@ -11,6 +13,13 @@
 namespace retdec {
 namespace llvmir2hll {
 
+namespace {
+
+/// Guards the cache of created types.
+std::mutex createdTypesMutex;
+
+} // anonymous namespace
+
 /**
 * @brief Constructs a new float type.
 *
@@ -46,6 +55,7 @@ unsigned FloatType::getSize() const {
 * @return Returns true if exists type, else false.
 */
 bool FloatType::existsFloatTypeWith(unsigned size) const {
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
 	return createdTypes.find(size) != createdTypes.end();
 }
 
@@ -55,6 +65,7 @@ bool FloatType::existsFloatTypeWith(unsigned size) const {
 * @return Returns true if exists float type, else false.
 */
 bool FloatType::existsFloatType() const {
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
 	if (createdTypes.empty()) {
 		return false;
 	}
@@ -72,6 +83,7 @@ ShPtr<FloatType> FloatType::create(unsigned size) {
 	// To reduce the amount of created types, we use a set of already created
 	// float types of the given size. If the wanted type has already been
 	// created, reuse it.
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
 	auto it = createdTypes.find(size);
 	if (it != createdTypes.end()) {
 		return it->second;
@@ -4,6 +4,8 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <mutex>
+
 #include "retdec/llvmir2hll/ir/int_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
 #include "retdec/llvmir2hll/support/visitor.h"
@@ -11,6 +13,13 @@
 namespace retdec {
 namespace llvmir2hll {
 
+namespace {
+
+/// Guards the cache of created types.
+std::mutex createdTypesMutex;
+
+} // anonymous namespace
+
 /**
 * @brief Constructs a new integer type.
 *
@@ -79,6 +88,7 @@ ShPtr<IntType> IntType::create(unsigned size, bool isSigned) {
 	PRECONDITION(size > 0, "invalid size " << size);
 
 	// There are two maps, one for signed integers and one for unsigned integers.
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
 	if (isSigned) {
 		// To reduce the amount of created types, we use a set of already created
 		// integer types of the given size. If the wanted type has already been
@@ -5,11 +5,13 @@
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
 #include "retdec/utils/io/log.h"
+#include "retdec/utils/parallel.h"
 
 using namespace llvm;
 using namespace retdec::utils::io;
 using retdec::llvmir2hll::ShPtr;
 using retdec::utils::hasItem;
+using retdec::utils::isMemorySoftLimitExceeded;
 using retdec::utils::joinStrings;
 using retdec::utils::limitSystemMemory;
 using retdec::utils::limitSystemMemoryToHalfOfTotalSystemMemory;
@@ -140,6 +142,17 @@ void LlvmIr2Hll::setOutputString(std::string* outString)
 	}
 }
 
+void LlvmIr2Hll::setPassProfiler(retdec::utils::PassProfiler* profiler)
+{
+	passProfiler = profiler;
+}
+
+void LlvmIr2Hll::setCancellationToken(
+		const retdec::utils::CancellationToken* token)
+{
+	cancellation = token;
+}
+
 void LlvmIr2Hll::getAnalysisUsage(llvm::AnalysisUsage &au) const
 {
 	au.addRequired<llvm::LoopInfoWrapperPass>();
@@ -592,18 +605,35 @@ void LlvmIr2Hll::initAliasAnalysis()
 
 /**
 * @brief Runs the optimizations over the resulting module.
+*
+* The optimizations stop when the decompilation is cancelled or when their
+* time budget from the config runs out.
 */
 void LlvmIr2Hll::runOptimizations()
 {
+	retdec::utils::CancellationToken optsCancellation(cancellation);
+	if (auto t = globalConfig->parameters.getBackendOptsTimeout())
+	{
+		optsCancellation.setTimeout(std::chrono::seconds(t));
+	}
+
 	ShPtr<llvmir2hll::OptimizerManager> optManager(
 			new llvmir2hll::OptimizerManager(
 					parseListOfOpts(globalConfig->parameters.getBackendEnabledOpts()),
 					parseListOfOpts(globalConfig->parameters.getBackendDisabledOpts()),
 					hllWriter,
-					llvmir2hll::ValueAnalysis::create(aliasAnalysis, true),
+					// Caching is memory expensive, so do not use it when we
+					// are already short of memory.
+					llvmir2hll::ValueAnalysis::create(
+							aliasAnalysis,
+							!isMemorySoftLimitExceeded()
+					),
 					cio,
 					arithmExprEvaluator,
-					Debug
+					Debug,
+					getNumOfBackendThreads(),
+					passProfiler,
+					&optsCancellation
 			)
 	);
 	optManager->optimize(resModule);
@@ -843,6 +873,17 @@ retdec::llvmir2hll::StringSet LlvmIr2Hll::parseListOfOpts(
 	return llvmir2hll::StringSet(parsedOpts.begin(), parsedOpts.end());
 }
 
+/**
+* @brief Returns the number of threads to be used to optimize functions.
+*
+* Zero in the configuration means to use all CPU cores.
+*/
+unsigned LlvmIr2Hll::getNumOfBackendThreads() const
+{
+	return static_cast<unsigned>(retdec::utils::getNumberOfThreads(
+		globalConfig->parameters.getBackendThreads()));
+}
+
 /**
 * @brief Returns the IDs of pattern finders to be run.
 */
@@ -8,6 +8,7 @@
 #include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/optimizer/func_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/utils/parallel.h"
 
 namespace retdec {
 namespace llvmir2hll {
@@ -25,10 +26,68 @@ FuncOptimizer::FuncOptimizer(ShPtr<Module> module):
 		PRECONDITION_NON_NULL(module);
 	}
 
+/**
+* @brief Returns @c true if several instances of the optimizer may optimize
+*        functions of the module in parallel, @c false otherwise.
+*
+* This holds when optimizing a function neither reads nor modifies other
+* functions or shared analyses and when the optimizer does not keep any state
+* between functions. By default, it returns @c false.
+*/
+bool FuncOptimizer::canBeRunInParallel() const {
+	return false;
+}
+
+/**
+* @brief Optimizes all functions in the module by the given optimizers, each
+*        of them running in its own thread.
+*
+* @param[in] optimizers Instances of the same optimizer for the same module.
+*
+* The threads take functions one by one in the order they appear in the module
+* until all functions are optimized. Since the functions are optimized
+* independently, the result does not depend on which thread optimized which
+* function. The optimizers are initialized before and finalized after that in
+* the calling thread.
+*
+* If an optimizer throws an exception, no more functions are optimized and the
+* exception is rethrown after all threads finish. Similarly, no more functions
+* are optimized once an optimizer gets cancelled.
+*
+* @par Preconditions
+*  - @a optimizers is non-empty
+*  - canBeRunInParallel() returns @c true for all @a optimizers
+*/
+void FuncOptimizer::optimizeInParallel(
+		const std::vector<ShPtr<FuncOptimizer>> &optimizers) {
+	PRECONDITION(!optimizers.empty(), "no optimizers given");
+
+	const FuncVector funcs(optimizers.front()->module->func_begin(),
+		optimizers.front()->module->func_end());
+
+	for (auto &optimizer : optimizers) {
+		optimizer->doInitialization();
+	}
+	retdec::utils::parallelFor(funcs.size(), optimizers.size(),
+		[&](std::size_t func, std::size_t thread) {
+			auto &optimizer = optimizers[thread];
+			if (optimizer->isCancelled()) {
+				return false;
+			}
+			optimizer->runOnFunction(funcs[func]);
+			return true;
+		});
+	for (auto &optimizer : optimizers) {
+		optimizer->doFinalization();
+	}
+}
+
 /**
 * @brief Performs the optimization on all functions in the module.
 *
-* This function calls runOnFunction() for each function in the module.
+* This function calls runOnFunction() for each function in the module. When
+* the optimization gets cancelled, the remaining functions are left as they
+* are.
 *
 * Only redefine if you want to prescribe the order in which functions are
 * optimized; otherwise, just override runOnFunction().
@@ -36,6 +95,9 @@ FuncOptimizer::FuncOptimizer(ShPtr<Module> module):
 void FuncOptimizer::doOptimization() {
 	// For each function in the module...
 	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
+		if (isCancelled()) {
+			return;
+		}
 		runOnFunction(*i);
 	}
 }
@@ -20,7 +20,7 @@ namespace llvmir2hll {
 *  - @a module is non-null
 */
 Optimizer::Optimizer(ShPtr<Module> module):
-	OrderedAllVisitor(), module(module) {
+	OrderedAllVisitor(), module(module), cancellation(nullptr) {
 		PRECONDITION_NON_NULL(module);
 	}
 
@@ -43,6 +43,35 @@ ShPtr<Module> Optimizer::optimize() {
 	return module;
 }
 
+/**
+* @brief Returns the module that is being optimized.
+*/
+ShPtr<Module> Optimizer::getModule() const {
+	return module;
+}
+
+/**
+* @brief Sets the token whose cancellation stops the optimization.
+*
+* @param[in] token The token (may be null).
+*
+* Optimizations are not needed for a correct output, so a cancelled
+* optimization stops as soon as the module is left in a consistent state,
+* e.g. before optimizing the next function.
+*/
+void Optimizer::setCancellationToken(
+		const retdec::utils::CancellationToken *token) {
+	cancellation = token;
+}
+
+/**
+* @brief Returns @c true if the optimization has been cancelled, @c false
+*        otherwise.
+*/
+bool Optimizer::isCancelled() const {
+	return cancellation && cancellation->isCancelled();
+}
+
 /**
 * @brief Performs pre-optimization matters.
 *
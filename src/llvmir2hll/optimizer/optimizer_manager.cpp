@@ -4,13 +4,18 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
+#include <type_traits>
 
 #include "retdec/llvmir2hll/analysis/value_analysis.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_builder.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/obtainer/call_info_obtainer.h"
+#include "retdec/llvmir2hll/optimizer/func_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/bit_op_to_log_op_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/bit_shift_optimizer.h"
@@ -45,7 +50,9 @@
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_ufor_loop_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_while_cond_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/statements_counter.h"
 #include "retdec/utils/container.h"
+#include "retdec/utils/memory.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 #include "retdec/utils/io/log.h"
@@ -54,6 +61,7 @@ using namespace retdec::utils::io;
 using namespace std::string_literals;
 
 using retdec::utils::hasItem;
+using retdec::utils::isMemorySoftLimitExceeded;
 using retdec::utils::startsWith;
 
 namespace retdec {
@@ -83,6 +91,22 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 	return result;
 }
 
+/**
+* @brief Returns the size of @a m for profiling purposes.
+*
+* There are no basic blocks in the backend IR, so only functions and
+* statements (as instructions) are counted.
+*/
+retdec::utils::IrSize getIrSize(ShPtr<Module> m) {
+	retdec::utils::IrSize size;
+	for (auto i = m->func_definition_begin(), e = m->func_definition_end();
+			i != e; ++i) {
+		++size.functions;
+		size.instructions += StatementsCounter::count((*i)->getBody());
+	}
+	return size;
+}
+
 } // anonymous namespace
 
 /**
@@ -97,6 +121,11 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @param[in] cio Call info obtainer.
 * @param[in] arithmExprEvaluator Used evaluator of arithmetical expressions.
 * @param[in] enableDebug Enables emission of debug messages.
+* @param[in] numOfThreads Maximal number of threads optimizing functions in
+*                         parallel.
+* @param[in] profiler If non-null, every run optimization is profiled by it.
+* @param[in] cancellation If non-null and cancelled, the remaining
+*                         optimizations are skipped.
 *
 * To perform the actual optimizations, call optimize(). To get a list of
 * available optimizations and their names, see our wiki.
@@ -110,19 +139,32 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @a hllWriter, @a va, and @a cio are needed in some optimizations, so they
 * have to be provided.
 *
+* If @a numOfThreads is greater than one, function optimizers which support it
+* (see FuncOptimizer::canBeRunInParallel()) optimize several functions at
+* once. Every optimization is still run over the whole module before the next
+* one starts, so the result is the same as when run in a single thread.
+*
+* Optimizations only make the emitted code nicer, so when @a cancellation gets
+* cancelled, the module is left as it is and the code is emitted without the
+* remaining optimizations. The running optimization is not interrupted.
+*
 * @par Preconditions
 *  - @a hllWriter, @a va, @a cio, and @a arithmExprEvaluator are non-null
 */
 OptimizerManager::OptimizerManager(const StringSet &enabledOpts,
 	const StringSet &disabledOpts, ShPtr<HLLWriter> hllWriter,
 	ShPtr<ValueAnalysis> va, ShPtr<CallInfoObtainer> cio,
-	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug):
+	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug,
+	unsigned numOfThreads, retdec::utils::PassProfiler *profiler,
+	const retdec::utils::CancellationToken *cancellation):
 		enabledOpts(trimOptimizerSuffix(enabledOpts)),
 		disabledOpts(trimOptimizerSuffix(disabledOpts)),
 		hllWriter(hllWriter), va(va), cio(cio),
 		arithmExprEvaluator(arithmExprEvaluator),
-		enableDebug(enableDebug),
-		recoverFromOutOfMemory(true), backendRunOpts() {
+		enableDebug(enableDebug), numOfThreads(numOfThreads),
+		profiler(profiler), cancellation(cancellation),
+		cancellationReported(false), recoverFromOutOfMemory(true),
+		backendRunOpts() {
 			PRECONDITION_NON_NULL(hllWriter);
 			PRECONDITION_NON_NULL(va);
 			PRECONDITION_NON_NULL(cio);
@@ -270,15 +312,28 @@ bool OptimizerManager::optShouldBeRun(const std::string &optId) const {
 
 /**
 * @brief Runs the given optimizer provided that it should be run.
+*
+* If @a parallelOptimizers is non-empty, they are used to optimize functions
+* in parallel instead of running @a optimizer alone.
 */
-void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer) {
+void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer,
+		const std::vector<ShPtr<FuncOptimizer>> &parallelOptimizers) {
 	const std::string OPT_ID = optimizer->getId();
-	if (!optShouldBeRun(OPT_ID)) {
+	if (!optShouldBeRun(OPT_ID) || isCancelled()) {
 		return;
 	}
 
 	printOptimization(OPT_ID);
 
+	if (isMemorySoftLimitExceeded()) {
+		saveMemory();
+	}
+
+	if (profiler) {
+		profiler->startPass("llvmir2hll", OPT_ID,
+			getIrSize(optimizer->getModule()));
+	}
+
 	if (recoverFromOutOfMemory) {
 		// Some optimizations, most notable CopyPropagation, may run out of
 		// memory on huge inputs. We try to recover from such situations by
@@ -287,19 +342,44 @@ void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimi
 		// memory requirements of the optimizations, or to generate smaller
 		// code in the first place.
 		try {
-			optimizer->optimize();
+			runOptimizer(optimizer, parallelOptimizers);
 		} catch (const std::bad_alloc &) {
 			Log::error() << Log::Warning << "out of memory; trying to recover" << std::endl;
+			saveMemory();
 			std::this_thread::sleep_for(std::chrono::seconds(1));
 		}
 	} else {
 		// Just run the optimizer and let std::bad_alloc propagate.
-		optimizer->optimize();
+		runOptimizer(optimizer, parallelOptimizers);
+	}
+
+	if (profiler) {
+		profiler->endPass(getIrSize(optimizer->getModule()));
 	}
 
 	backendRunOpts.insert(OPT_ID);
 }
 
+/**
+* @brief Runs the given optimizer, in parallel by @a parallelOptimizers if
+*        there are any.
+*/
+void OptimizerManager::runOptimizer(ShPtr<Optimizer> optimizer,
+		const std::vector<ShPtr<FuncOptimizer>> &parallelOptimizers) {
+	// Long optimizations (e.g. CopyPropagation) check the cancellation also
+	// between functions, not only before they start.
+	optimizer->setCancellationToken(cancellation);
+	for (auto &parallelOptimizer : parallelOptimizers) {
+		parallelOptimizer->setCancellationToken(cancellation);
+	}
+
+	if (parallelOptimizers.empty()) {
+		optimizer->optimize();
+	} else {
+		FuncOptimizer::optimizeInParallel(parallelOptimizers);
+	}
+}
+
 /**
 * @brief Prints debug information about the currently run optimization with @a
 *        optId.
@@ -312,9 +392,47 @@ void OptimizerManager::printOptimization(const std::string &optId) const {
 	}
 }
 
+/**
+* @brief Lowers memory requirements of the subsequent optimizations.
+*
+* The cache of the value analysis is dropped and the analysis stops caching.
+* The optimizations then run slower, but they produce the same results.
+*/
+void OptimizerManager::saveMemory() {
+	if (!va->isCachingEnabled()) {
+		return;
+	}
+
+	Log::error() << Log::Warning << "memory soft limit exceeded; "
+		"disabling caching of the value analysis" << std::endl;
+	va->clearCache();
+	va->disableCaching();
+}
+
+/**
+* @brief Returns @c true if the optimizations have been cancelled, @c false
+*        otherwise.
+*
+* The cancellation is reported only once.
+*/
+bool OptimizerManager::isCancelled() {
+	if (!cancellation || !cancellation->isCancelled()) {
+		return false;
+	}
+
+	if (!cancellationReported) {
+		Log::error() << Log::Warning << "optimizations cancelled; "
+			"skipping the remaining ones" << std::endl;
+		cancellationReported = true;
+	}
+	return true;
+}
+
 /**
 * @brief Returns @c true if a second pass of CopyPropagation should be run,
 *        @c false otherwise.
+*
+* The second pass is not run when the memory soft limit has been exceeded.
 */
 bool OptimizerManager::shouldSecondCopyPropagationBeRun() const {
 	// TODO What if the name of the optimization changes? Should this ID be
@@ -327,7 +445,14 @@ bool OptimizerManager::shouldSecondCopyPropagationBeRun() const {
 		// It is disabled.
 		return false;
 	}
-	//  (2) if CopyPropagation was run, then check that at least one different
+	//  (2) there is enough memory (it is the most memory-hungry optimization
+	//      and the second pass is only a matter of readability);
+	if (isMemorySoftLimitExceeded()) {
+		Log::error() << Log::Warning << "memory soft limit exceeded; "
+			"skipping the second pass of " << COPY_PROP_ID << std::endl;
+		return false;
+	}
+	//  (3) if CopyPropagation was run, then check that at least one different
 	//      optimization was run.
 	if (hasItem(backendRunOpts, COPY_PROP_ID)) {
 		return backendRunOpts.size() > 1;
@@ -348,12 +473,28 @@ bool OptimizerManager::shouldSecondCopyPropagationBeRun() const {
 * is non-empty and it doesn't contain the optimization, it is also not run.
 *
 * If @c enableDebug is @c true, debug messages are emitted.
+*
+* Function optimizers that support it are run by up to @c numOfThreads
+* instances in parallel.
 */
 template<typename Optimization, typename... Args>
 void OptimizerManager::run(ShPtr<Module> m, Args &&... args) {
-	auto optimizer = std::make_shared<Optimization>(m,
-		std::forward<Args>(args)...);
-	runOptimizerProvidedItShouldBeRun(optimizer);
+	auto optimizer = std::make_shared<Optimization>(m, args...);
+
+	std::vector<ShPtr<FuncOptimizer>> parallelOptimizers;
+	if constexpr (std::is_base_of_v<FuncOptimizer, Optimization>) {
+		auto numOfInstances = std::min<std::size_t>(numOfThreads,
+			m->getNumOfFuncDefinitions());
+		if (numOfInstances > 1 && optimizer->canBeRunInParallel()) {
+			parallelOptimizers.push_back(optimizer);
+			while (parallelOptimizers.size() < numOfInstances) {
+				parallelOptimizers.push_back(
+					std::make_shared<Optimization>(m, args...));
+			}
+		}
+	}
+
+	runOptimizerProvidedItShouldBeRun(optimizer, parallelOptimizers);
 }
 
 } // namespace llvmir2hll
@@ -210,7 +210,7 @@ CopyPropagationOptimizer::CopyPropagationOptimizer(ShPtr<Module> module,
 		va(va), cio(cio), vuv(), dua(), uda(),
 		ducs(), udcs(), globalVars(module->getGlobalVars()),
 		toEntirelyRemoveStmts(), toRemoveStmtsPreserveCalls(), modifiedStmts(),
-		codeChanged(false) {
+		changedVars(), codeChanged(false) {
 			PRECONDITION_NON_NULL(module);
 			PRECONDITION_NON_NULL(va);
 			PRECONDITION_NON_NULL(cio);
@@ -231,17 +231,21 @@ void CopyPropagationOptimizer::doOptimization() {
 
 void CopyPropagationOptimizer::runOnFunction(ShPtr<Function> func) {
 	auto currCFG = cfgBuilder->getCFG(func);
-
-	// Keep optimizing until there are no changes.
+	ducs = dua->getDefUseChains(
+		func,
+		currCFG,
+		[this](auto var) {
+			return this->shouldBeIncludedInDefUseChains(var);
+		}
+	);
+	udcs = uda->getUseDefChains(func, ducs);
+
+	// Keep optimizing until there are no changes. After every round, only the
+	// chains of variables used or defined in the modified statements are
+	// updated; computing all the chains from scratch would be too slow on
+	// large functions. Every round leaves the function in a consistent state,
+	// so a cancelled optimization may stop after any of them.
 	do {
-		ducs = dua->getDefUseChains(
-			func,
-			currCFG,
-			[this](auto var) {
-				return this->shouldBeIncludedInDefUseChains(var);
-			}
-		);
-		udcs = uda->getUseDefChains(func, ducs);
 		codeChanged = false;
 
 		def2uses.clear();
@@ -252,7 +256,12 @@ void CopyPropagationOptimizer::runOnFunction(ShPtr<Function> func) {
 		}
 
 		performOptimization();
-	} while (codeChanged);
+
+		if (codeChanged) {
+			dua->updateDefUseChains(ducs, changedVars);
+			uda->updateUseDefChains(udcs, ducs, changedVars);
+		}
+	} while (codeChanged && !isCancelled());
 }
 
 /**
@@ -319,6 +328,10 @@ void CopyPropagationOptimizer::performOptimization() {
 		codeChanged |= _codeChanged;
 	}
 
+	// Compute the variables whose chains have to be updated. This has to be
+	// done before the modified statements are removed.
+	computeChangedVars();
+
 	// Remove statements that are to be removed and update the CFG.
 	// We have to iterate over ordered statements to make the optimization
 	// deterministic.
@@ -328,6 +341,9 @@ void CopyPropagationOptimizer::performOptimization() {
 		// removeVarDefOrAssignStatement() and use it when updating the CFG.
 		const auto &newStmts = removeVarDefOrAssignStatement(stmt, ducs->func);
 		ducs->cfg->replaceStmt(stmt, newStmts);
+		for (const auto &newStmt : newStmts) {
+			addVarsInStmtToChangedVars(newStmt);
+		}
 	}
 	for (const auto &stmt : ordered(toEntirelyRemoveStmts)) {
 		Statement::removeStatementButKeepDebugComment(stmt);
@@ -335,6 +351,56 @@ void CopyPropagationOptimizer::performOptimization() {
 	}
 }
 
+/**
+* @brief Computes the variables whose def-use and use-def chains may have been
+*        changed by modifying the statements in @c modifiedStmts.
+*
+* The result is stored into @c changedVars. These are the variables that the
+* modified statements defined or used before they were modified (obtained
+* from the current chains) and the variables they define or use now.
+*/
+void CopyPropagationOptimizer::computeChangedVars() {
+	changedVars.clear();
+
+	// Variables defined in the modified statements.
+	for (const auto &stmt : modifiedStmts) {
+		for (auto i = def2uses.lower_bound(
+					DefUseChains::StmtVarPair(stmt, ShPtr<Variable>())),
+				e = def2uses.end(); i != e && i->first.first == stmt; ++i) {
+			changedVars.insert(i->first.second);
+		}
+	}
+
+	// Variables used in the modified statements.
+	for (const auto &ud : udcs->ud) {
+		if (hasItem(modifiedStmts, ud.first.second)) {
+			changedVars.insert(ud.first.first);
+		}
+	}
+
+	// Variables defined or used in the modified statements after the
+	// modification. Removed statements do not define or use anything.
+	for (const auto &stmt : modifiedStmts) {
+		if (!hasItem(toEntirelyRemoveStmts, stmt) &&
+				!hasItem(toRemoveStmtsPreserveCalls, stmt)) {
+			addVarsInStmtToChangedVars(stmt);
+		}
+	}
+}
+
+/**
+* @brief Adds the variables that @a stmt directly defines or uses into
+*        @c changedVars.
+*/
+void CopyPropagationOptimizer::addVarsInStmtToChangedVars(
+		ShPtr<Statement> stmt) {
+	const auto &stmtData = va->getValueData(stmt);
+	const auto &readVars = stmtData->getDirReadVars();
+	changedVars.insert(readVars.begin(), readVars.end());
+	const auto &writtenVars = stmtData->getDirWrittenVars();
+	changedVars.insert(writtenVars.begin(), writtenVars.end());
+}
+
 /**
 * @brief Returns @c true if @a stmt or any its uses in @a uses has been
 *        modified, @c false otherwise.
@@ -562,6 +562,9 @@ void ElfImage::fixBssSegments()
 			bssSegment->resize(nextSegment->getAddress() - bssSegment->getAddress());
 		}
 	}
+
+	// Resized segments cover different addresses now
+	invalidateSegmentIndex();
 }
 
 void ElfImage::applyRelocations()
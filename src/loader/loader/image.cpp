@@ -4,8 +4,11 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
+#include <set>
+#include <tuple>
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
@@ -18,7 +21,8 @@ namespace retdec {
 namespace loader {
 
 Image::Image(const std::shared_ptr<retdec::fileformat::FileFormat>& fileFormat) : _fileFormat(fileFormat), _segments(),
-	_baseAddress(0), _namelessSegNameGen("seg", '0', 4), _statusMessage()
+	_baseAddress(0), _namelessSegNameGen("seg", '0', 4), _statusMessage(),
+	_segmentIndex(), _segmentIndexLastHit(0), _segmentIndexValid(false), _segmentIndexMutex()
 {
 }
 
@@ -443,6 +447,7 @@ Segment* Image::insertSegment(std::unique_ptr<Segment> segment)
 	// Now give segment name
 	Segment* retSegment = _segments.back().get();
 	nameSegment(retSegment);
+	invalidateSegmentIndex();
 	return retSegment;
 }
 
@@ -453,6 +458,7 @@ void Image::removeSegment(Segment* segment)
 		if (itr->get() == segment)
 		{
 			_segments.erase(itr);
+			invalidateSegmentIndex();
 			return;
 		}
 	}
@@ -472,6 +478,66 @@ void Image::sortSegments()
 			{
 				return seg1->getAddress() < seg2->getAddress();
 			});
+	invalidateSegmentIndex();
+}
+
+/**
+ * Marks the address-to-segment index as outdated. It is rebuilt on the next lookup.
+ * Subclasses have to call this whenever they change the address range of any segment
+ * already inserted into the image (e.g. by resizing or shrinking it).
+ */
+void Image::invalidateSegmentIndex()
+{
+	_segmentIndexValid.store(false, std::memory_order_release);
+}
+
+/**
+ * Builds the sorted index of disjoint address ranges used by address-to-segment lookups.
+ * Segments may overlap, so every range is assigned to the segment which comes first in
+ * @c getSegments() among all segments covering it. This way the index gives the same answers
+ * as the linear scan over all segments.
+ */
+void Image::_buildSegmentIndex() const
+{
+	// (address, is start, position in _segments)
+	std::vector<std::tuple<std::uint64_t, bool, std::size_t>> bounds;
+	bounds.reserve(2 * _segments.size());
+	for (std::size_t i = 0; i < _segments.size(); ++i)
+	{
+		auto start = _segments[i]->getAddress();
+		auto end = _segments[i]->getEndAddress();
+		// Segment which wraps around the address space contains no address at all
+		if (start >= end)
+			continue;
+
+		bounds.emplace_back(start, true, i);
+		bounds.emplace_back(end, false, i);
+	}
+	std::sort(bounds.begin(), bounds.end());
+
+	_segmentIndex.clear();
+	std::set<std::size_t> active;
+	for (std::size_t i = 0; i < bounds.size(); )
+	{
+		auto address = std::get<0>(bounds[i]);
+		for (; i < bounds.size() && std::get<0>(bounds[i]) == address; ++i)
+		{
+			if (std::get<1>(bounds[i]))
+				active.insert(std::get<2>(bounds[i]));
+			else
+				active.erase(std::get<2>(bounds[i]));
+		}
+
+		if (active.empty() || i == bounds.size())
+			continue;
+
+		const Segment* segment = _segments[*active.begin()].get();
+		auto nextAddress = std::get<0>(bounds[i]);
+		if (!_segmentIndex.empty() && _segmentIndex.back().end == address && _segmentIndex.back().segment == segment)
+			_segmentIndex.back().end = nextAddress;
+		else
+			_segmentIndex.push_back({address, nextAddress, segment});
+	}
 }
 
 const Segment* Image::_getSegment(std::size_t index) const
@@ -506,13 +572,39 @@ const Segment* Image::_getSegmentWithIndex(std::size_t index) const
 
 const Segment* Image::_getSegmentFromAddress(std::uint64_t address) const
 {
-	for (const auto& segment : getSegments())
+	if (!_segmentIndexValid.load(std::memory_order_acquire))
 	{
-		if (segment->containsAddress(address))
-			return segment.get();
+		std::lock_guard<std::mutex> lock(_segmentIndexMutex);
+		if (!_segmentIndexValid.load(std::memory_order_relaxed))
+		{
+			_buildSegmentIndex();
+			_segmentIndexValid.store(true, std::memory_order_release);
+		}
 	}
 
-	return nullptr;
+	// Lookups tend to hit the same segment repeatedly, try the last hit first
+	auto lastHit = _segmentIndexLastHit.load(std::memory_order_relaxed);
+	if (lastHit < _segmentIndex.size()
+			&& _segmentIndex[lastHit].start <= address && address < _segmentIndex[lastHit].end)
+	{
+		return _segmentIndex[lastHit].segment;
+	}
+
+	// Find the last range which starts at or before the address
+	auto itr = std::upper_bound(_segmentIndex.begin(), _segmentIndex.end(), address,
+			[](std::uint64_t addr, const SegmentIndexEntry& entry)
+			{
+				return addr < entry.start;
+			});
+	if (itr == _segmentIndex.begin())
+		return nullptr;
+
+	--itr;
+	if (address >= itr->end)
+		return nullptr;
+
+	_segmentIndexLastHit.store(itr - _segmentIndex.begin(), std::memory_order_relaxed);
+	return itr->segment;
 }
 
 } // namespace loader
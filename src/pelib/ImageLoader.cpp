@@ -222,9 +222,9 @@ std::uint32_t PeLib::ImageLoader::stringLength(
 					std::uint32_t rvaEndPage = (pageIndex + 1) * PELIB_PAGE_SIZE;
 
 					// If zero page, means this is a zeroed page. This is the end of the string.
-					if(page.buffer.empty())
+					if(page.data() == nullptr)
 						break;
-					dataBegin = dataPtr = page.buffer.data() + (rva & (PELIB_PAGE_SIZE - 1));
+					dataBegin = dataPtr = page.data() + (rva & (PELIB_PAGE_SIZE - 1));
 
 					// Perhaps the last page loaded?
 					if(rvaEndPage > rvaEnd)
@@ -407,12 +407,12 @@ std::uint32_t PeLib::ImageLoader::dumpImage(const char * fileName)
 	{
 		// Allocate one page filled with zeros
 		std::uint8_t zeroPage[PELIB_PAGE_SIZE] = {0};
-		char * dataToWrite;
+		const char * dataToWrite;
 
 		// Write each page to the file
 		for(auto & page : pages)
 		{
-			dataToWrite = (char *)(page.buffer.size() ? page.buffer.data() : zeroPage);
+			dataToWrite = (const char *)(page.data() ? page.data() : zeroPage);
 			fs.write(dataToWrite, PELIB_PAGE_SIZE);
 			bytesWritten += PELIB_PAGE_SIZE;
 		}
@@ -982,7 +982,6 @@ int PeLib::ImageLoader::Load(
 	std::streamoff fileOffset,
 	bool loadHeadersOnly)
 {
-	ByteBuffer fileData;
 	std::streampos fileSize;
 	std::size_t fileSize2;
 	int fileError;
@@ -1011,9 +1010,10 @@ int PeLib::ImageLoader::Load(
 
 	// Resize the vector so it can hold entire file. Note that this can
 	// potentially allocate a very large memory block, so we need to handle that carefully
+	// The data are kept in the loader, because the mapped pages refer to them
 	try
 	{
-		fileData.resize(fileSize2);
+		streamFileData.resize(fileSize2);
 	}
 	catch(const std::bad_alloc&)
 	{
@@ -1025,14 +1025,20 @@ int PeLib::ImageLoader::Load(
 	// can fail on low memory. When that happens, fs.read will read less than
 	// required. We need to verify the number of bytes read and return the apropriate error code.
 	fs.seekg(fileOffset);
-	fs.read(reinterpret_cast<char*>(fileData.data()), fileSize2);
+	fs.read(reinterpret_cast<char*>(streamFileData.data()), fileSize2);
 	if(fs.gcount() < (fileSize - fileOffset))
 	{
+		ByteBuffer().swap(streamFileData);
 		return ERROR_NOT_ENOUGH_SPACE;
 	}
 
 	// Call the Load interface on char buffer
-	return Load(fileData, loadHeadersOnly);
+	fileError = Load(streamFileData, loadHeadersOnly);
+
+	// Headers are captured by value, nothing refers to the file data
+	if(loadHeadersOnly)
+		ByteBuffer().swap(streamFileData);
+	return fileError;
 }
 
 int PeLib::ImageLoader::Load(
@@ -1158,9 +1164,9 @@ void PeLib::ImageLoader::readFromPage(
 	std::size_t bytesInPage)
 {
 	// Is it a page with actual data?
-	if(page.buffer.size())
+	if(page.data() != nullptr)
 	{
-		memcpy(buffer, page.buffer.data() + offsetInPage, bytesInPage);
+		memcpy(buffer, page.data() + offsetInPage, bytesInPage);
 	}
 	else
 	{
@@ -2548,8 +2554,12 @@ std::uint32_t PeLib::ImageLoader::captureImageSection(
 					if((rawDataPtr + bytesToCopy) > rawDataEnd)
 						bytesToCopy = (rawDataEnd - rawDataPtr);
 
-					// Initialize the page with valid data
-					filePage.setValidPage(rawDataPtr, bytesToCopy);
+					// Initialize the page with valid data. Full pages are not copied,
+					// they refer to the file data instead.
+					if(bytesToCopy == PELIB_PAGE_SIZE)
+						filePage.setFileBackedPage(rawDataPtr);
+					else
+						filePage.setValidPage(rawDataPtr, bytesToCopy);
 				}
 				else
 				{
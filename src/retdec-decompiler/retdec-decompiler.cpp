@@ -4,9 +4,15 @@
  * @copyright (c) 2020 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <condition_variable>
 #include <fstream>
 #include <future>
 #include <chrono>
+#include <mutex>
+#include <queue>
 #include <thread>
 
 #include <llvm/ADT/Triple.h>
@@ -39,13 +45,16 @@
 #include "retdec/ar-extractor/archive_wrapper.h"
 #include "retdec/ar-extractor/detection.h"
 #include "retdec/config/config.h"
+#include "retdec/fileformat/format_factory.h"
 #include "retdec/retdec/retdec.h"
 #include "retdec/macho-extractor/break_fat.h"
 #include "retdec/unpackertool/unpackertool.h"
 #include "retdec/utils/binary_path.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/filesystem.h"
 #include "retdec/utils/io/log.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/version.h"
 
@@ -54,6 +63,11 @@ using namespace retdec::utils::io;
 const int EXIT_TIMEOUT = 137;
 const int EXIT_BAD_ALLOC = 135;
 
+/// Time given to the decompilation to stop by itself after its timeout
+/// expires (the passes that produce the output are not cancelled) before the
+/// process is terminated.
+const std::chrono::seconds TIMEOUT_GRACE_PERIOD(30);
+
 //
 //==============================================================================
 // Program options
@@ -74,15 +88,28 @@ class ProgramOptions
 		std::string arName;
 		std::optional<uint64_t> arIdx;
 
+		bool profile = false;
+		std::string profilePath;
+
 		bool cleanup = false;
 		std::set<std::string> toClean;
 
+		bool server = false;
+		unsigned serverWorkers = 0;
+		/// Options of a single job in the server mode -> do not exit
+		/// the whole process on errors, do not touch the global logging.
+		bool serverJob = false;
+
 	public:
 		ProgramOptions(
 				int argc,
 				char *argv[],
 				retdec::config::Config& c,
 				retdec::config::Parameters& p);
+		ProgramOptions(
+				const std::list<std::string>& args,
+				retdec::config::Config& c,
+				retdec::config::Parameters& p);
 
 		void load();
 
@@ -119,6 +146,17 @@ ProgramOptions::ProgramOptions(
 	}
 }
 
+ProgramOptions::ProgramOptions(
+		const std::list<std::string>& args,
+		retdec::config::Config& c,
+		retdec::config::Parameters& p)
+		: config(c)
+		, params(p)
+		, _argv(args)
+{
+
+}
+
 void ProgramOptions::load()
 {
 	for (auto i = _argv.begin(); i != _argv.end();)
@@ -168,6 +206,21 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 {
 	std::string c = *i;
 
+	// These would exit the whole server, or change the global LLVM options
+	// of all the jobs running at the same time.
+	if (serverJob
+			&& (isParam(i, "-h", "--help")
+			|| isParam(i, "", "--version")
+			|| isParam(i, "", "--print-after-all")
+			|| isParam(i, "", "--print-before-all")
+			|| isParam(i, "", "--server")
+			|| isParam(i, "", "--server-workers")))
+	{
+		throw std::runtime_error(
+			"[" + c + "] option not allowed in a server job"
+		);
+	}
+
 	if (isParam(i, "-h", "--help"))
 	{
 		printHelpAndDie();
@@ -288,6 +341,20 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 			);
 		}
 	}
+	else if (isParam(i, "", "--max-memory-soft"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setMaxMemorySoftLimit(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--max-memory-soft] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "", "--no-memory-limit"))
 	{
 		params.setMaxMemoryLimit(0);
@@ -309,6 +376,7 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 		params.setOutputConfigFile(out + ".config.json");
 		params.setOutputUnpackedFile(out + "-unpacked");
 		arExtractPath = out + "-extracted";
+		profilePath = out + ".profile.json";
 	}
 	else if (isParam(i, "-k", "--keep-unreachable-funcs"))
 	{
@@ -426,6 +494,20 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 		}
 		params.setBackendVarRenamer(s);
 	}
+	else if (isParam(i, "", "--backend-threads"))
+	{
+		auto n = getParamOrDie(i);
+		try
+		{
+			params.setBackendThreads(std::stoull(n));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--backend-threads] invalid number of threads: " + n
+			);
+		}
+	}
 	else if (isParam(i, "", "--backend-no-opts"))
 	{
 		params.setIsBackendNoOpts(true);
@@ -515,6 +597,60 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 			);
 		}
 	}
+	else if (isParam(i, "", "--decoder-timeout"))
+	{
+		auto t = getParamOrDie(i);
+		try
+		{
+			params.setDecoderTimeout(std::stoull(t));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--decoder-timeout] invalid timeout value: " + t
+			);
+		}
+	}
+	else if (isParam(i, "", "--backend-opts-timeout"))
+	{
+		auto t = getParamOrDie(i);
+		try
+		{
+			params.setBackendOptsTimeout(std::stoull(t));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--backend-opts-timeout] invalid timeout value: " + t
+			);
+		}
+	}
+	else if (isParam(i, "", "--profile"))
+	{
+		profile = true;
+	}
+	else if (isParam(i, "", "--cache-dir"))
+	{
+		params.setCacheDirectory(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--server-workers"))
+	{
+		auto n = getParamOrDie(i);
+		try
+		{
+			serverWorkers = std::stoul(n);
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--server-workers] invalid number of workers: " + n
+			);
+		}
+	}
+	else if (isParam(i, "", "--server"))
+	{
+		server = true;
+	}
 	else if (isParam(i, "-s", "--silent"))
 	{
 		params.setIsVerboseOutput(false);
@@ -536,6 +672,12 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
  */
 void ProgramOptions::afterLoad()
 {
+	// Inputs are given by the individual jobs.
+	if (server)
+	{
+		return;
+	}
+
 	auto in = params.getInputFile();
 	if (params.getOutputAsmFile().empty())
 		params.setOutputAsmFile(in + ".dsm");
@@ -556,6 +698,9 @@ void ProgramOptions::afterLoad()
 		params.setOutputUnpackedFile(in + "-unpacked");
 	if (arExtractPath.empty())
 		arExtractPath = in + "-extracted";
+	if (profile && params.getOutputProfileFile().empty())
+		params.setOutputProfileFile(
+				profilePath.empty() ? in + ".profile.json" : profilePath);
 
 	if (mode == "raw")
 	{
@@ -612,6 +757,11 @@ std::string ProgramOptions::checkFile(
 
 void ProgramOptions::printHelpAndDie()
 {
+	if (serverJob)
+	{
+		throw std::runtime_error("invalid job arguments");
+	}
+
 	Log::info() << programName << R"(:
 Mandatory arguments:
 	INPUT_FILE File to decompile.
@@ -647,6 +797,7 @@ Backend arguments:
 	[--backend-enabled-opts LIST] Runs only the optimizations from the given comma-separated list of optimizations.
 	[--backend-call-info-obtainer NAME] Name of the obtainer of information about function calls [optim|pessim] (Default: optim).
 	[--backend-var-renamer STYLE] Used renamer of variables [address|hungarian|readable|simple|unified] (Default: readable).
+	[--backend-threads N] Number of threads optimizing functions in the backend, computing reaching definitions and pre-decoding instructions in parallel, 0 means the number of CPU cores, shared by the jobs in the server mode (Default: 1).
 	[--backend-no-opts] Disables backend optimizations.
 	[--backend-emit-cfg] Emits a CFG for each function in the backend IR (in the .dot format).
 	[--backend-emit-cg] Emits a CG for the decompiled module in the backend IR (in the .dot format).
@@ -657,9 +808,24 @@ Backend arguments:
 	[--backend-no-compound-operators] Do not emit compound operators (like +=) instead of assignments.
 	[--backend-no-symbolic-names] Disables the conversion of constant arguments to their symbolic names.
 Decompilation process arguments:
-	[--timeout SECONDS]
+	[--timeout SECONDS] Stops the decompilation after the given number of seconds and emits what has been decompiled so far.
+	                    When it does not stop within 30 more seconds, the decompiler is terminated without any output.
+	[--decoder-timeout SECONDS] Time budget of the decoding, the rest of the input is left undecoded when it runs out.
+	[--backend-opts-timeout SECONDS] Time budget of the backend optimizations, the remaining ones are skipped when it runs out.
 	[--max-memory MAX_MEMORY] Limits the maximal memory used by the given number of bytes.
+	[--max-memory-soft MAX_MEMORY] When the resident memory of the decompilation exceeds the given number of bytes, expensive optimizations
+	                               are skipped or downgraded to finish within the maximal memory (default: 3/4 of the maximal memory limit,
+	                               compared with the virtual memory like the maximal memory limit itself).
 	[--no-memory-limit] Disables the default memory limit (half of system RAM).
+	[--profile] Emits time, memory, and IR size of every decompilation pass as JSON next to the output file (.profile.json).
+	                    CPU time is per thread, memory sizes are of the whole process.
+	[--cache-dir DIR] Cache results of the decompilation before the back-end in DIR (keyed by SHA256 of the input
+	                  and the configuration). Repeated decompilations of the same input only run the back-end.
+	[--server] Do not decompile INPUT_FILE, read decompilation jobs from the standard input instead.
+	           Each line contains arguments of one decompilation (e.g. "input.exe -o output.c").
+	           For each finished job, "JOB_INDEX EXIT_CODE" is printed to the standard output.
+	           Jobs must not use --help, --version, --print-after-all, --print-before-all and --server* options.
+	[--server-workers N] Number of jobs decompiled in parallel in the server mode (default: number of CPU cores).
 LLVM IR debug arguments:
 	[--print-after-all] Dump LLVM IR to stderr after every LLVM pass.
 	[--print-before-all] Dump LLVM IR to stderr before every LLVM pass.
@@ -727,9 +893,14 @@ std::string ProgramOptions::getParamOrDie(std::list<std::string>::iterator& i)
 
 /**
 * Limits the maximal memory of the tool based on the command-line parameters.
+* The soft limit is set to three quarters of the maximal memory, unless it
+* is given explicitly. The maximal memory limits the virtual memory of the
+* process, so the derived soft limit is compared with the virtual memory too,
+* while an explicit soft limit is compared with the resident memory.
 */
 void limitMaximalMemoryIfRequested(const retdec::config::Parameters& params)
 {
+	std::size_t hardLimit = 0;
 	if (params.isMaxMemoryLimitHalfRam())
 	{
 		auto ok = retdec::utils::limitSystemMemoryToHalfOfTotalSystemMemory();
@@ -739,6 +910,7 @@ void limitMaximalMemoryIfRequested(const retdec::config::Parameters& params)
 				"failed to limit maximal memory to half of system RAM"
 			);
 		}
+		hardLimit = retdec::utils::getTotalSystemMemory() / 2;
 	}
 	else if (auto lim = params.getMaxMemoryLimit(); lim > 0)
 	{
@@ -749,6 +921,22 @@ void limitMaximalMemoryIfRequested(const retdec::config::Parameters& params)
 				"failed to limit maximal memory to " + std::to_string(lim)
 			);
 		}
+		hardLimit = lim;
+	}
+
+	if (auto softLimit = params.getMaxMemorySoftLimit(); softLimit > 0)
+	{
+		retdec::utils::setMemorySoftLimit(
+				softLimit,
+				retdec::utils::MemoryKind::Resident
+		);
+	}
+	else
+	{
+		retdec::utils::setMemorySoftLimit(
+				hardLimit / 4 * 3,
+				retdec::utils::MemoryKind::Virtual
+		);
 	}
 }
 
@@ -790,9 +978,15 @@ void setLogsFrom(const retdec::config::Parameters& params)
 	}
 }
 
-int decompile(retdec::config::Config& config, ProgramOptions& po)
+int decompile(
+		retdec::config::Config& config,
+		ProgramOptions& po,
+		const retdec::utils::CancellationToken* cancellation = nullptr)
 {
-	setLogsFrom(config.parameters);
+	if (!po.serverJob)
+	{
+		setLogsFrom(config.parameters);
+	}
 
 	// Macho-O extraction.
 	//
@@ -927,6 +1121,17 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 		}
 	}
 
+	// Input file is parsed only once, the parsed file is then shared by
+	// the packer detection and all the decompilation phases.
+	//
+	std::shared_ptr<retdec::fileformat::FileFormat> inputFile;
+	if (!config.fileFormat.isRaw())
+	{
+		inputFile = retdec::fileformat::createFileFormat(
+				config.parameters.getInputFile()
+		);
+	}
+
 	// Unpacking
 	//
 
@@ -942,18 +1147,32 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 			unpackArgs[2].data(),
 			unpackArgs[3].data()
 	};
-	auto unpackCode = retdec::unpackertool::_main(4, uargv);
+	int unpackCode = 0;
+	{
+		// Unpacker plugins are global objects -> one unpacking at a time.
+		static std::mutex unpackerMutex;
+		std::lock_guard<std::mutex> lock(unpackerMutex);
+		unpackCode = retdec::unpackertool::_main(4, uargv, inputFile.get());
+	}
 	if (unpackCode == 0) // EXIT_CODE_OK
 	{
 		config.parameters.setInputFile(
 				config.parameters.getOutputUnpackedFile()
 		);
 		po.toClean.insert(config.parameters.getOutputUnpackedFile());
+		inputFile.reset();
 	}
 
 	// Decompilation.
 	//
-	return retdec::decompile(config);
+	if (po.serverJob)
+	{
+		retdec::DecompilationSession session(config);
+		session.setInputFile(inputFile);
+		session.setCancellationToken(cancellation);
+		return session.run();
+	}
+	return retdec::decompile(config, nullptr, inputFile, cancellation);
 }
 
 //
@@ -975,6 +1194,190 @@ void cleanup(ProgramOptions& po)
 	}
 }
 
+//
+//==============================================================================
+// Server.
+//==============================================================================
+//
+
+/**
+ * Split job line into program arguments. Arguments are separated by
+ * whitespaces, double quotes can be used to group arguments with spaces.
+ */
+std::list<std::string> splitJobArguments(const std::string& line)
+{
+	std::list<std::string> args;
+	std::string arg;
+	bool inArg = false;
+	bool inQuotes = false;
+	for (char c : line)
+	{
+		if (c == '"')
+		{
+			inQuotes = !inQuotes;
+			inArg = true;
+		}
+		else if (!inQuotes && std::isspace(static_cast<unsigned char>(c)))
+		{
+			if (inArg)
+			{
+				args.push_back(arg);
+				arg.clear();
+				inArg = false;
+			}
+		}
+		else
+		{
+			arg += c;
+			inArg = true;
+		}
+	}
+	if (inArg)
+	{
+		args.push_back(arg);
+	}
+	return args;
+}
+
+/**
+ * Run a single server job. Job gets its own copy of the base configuration
+ * loaded on the server start. Jobs asking for all the CPU cores get only
+ * their share of them, since @a workers jobs run in parallel.
+ */
+int runServerJob(
+		const retdec::config::Config& baseConfig,
+		std::size_t jobIndex,
+		const std::string& line,
+		unsigned workers)
+{
+	retdec::config::Config config = baseConfig;
+	ProgramOptions po(splitJobArguments(line), config, config.parameters);
+	po.serverJob = true;
+
+	int ret = EXIT_SUCCESS;
+	try
+	{
+		po.load();
+
+		if (config.parameters.getBackendThreads() == 0)
+		{
+			config.parameters.setBackendThreads(std::max<std::size_t>(
+					1,
+					retdec::utils::getNumberOfThreads(0) / workers));
+		}
+
+		retdec::utils::CancellationToken cancellation;
+		if (config.parameters.isTimeout())
+		{
+			cancellation.setTimeout(
+					std::chrono::seconds(config.parameters.getTimeout())
+			);
+		}
+
+		ret = decompile(config, po, &cancellation);
+		if (cancellation.isCancelled())
+		{
+			Log::error() << "job " << jobIndex << ": timeout after: "
+					<< config.parameters.getTimeout() << " seconds" << std::endl;
+			ret = EXIT_TIMEOUT;
+		}
+	}
+	catch (const std::bad_alloc& e)
+	{
+		Log::error() << "job " << jobIndex << ": catched std::bad_alloc"
+				<< std::endl;
+		ret = EXIT_BAD_ALLOC;
+	}
+	catch (const std::exception& e)
+	{
+		Log::error() << Log::Error << "job " << jobIndex << ": " << e.what()
+				<< std::endl;
+		ret = EXIT_FAILURE;
+	}
+
+	cleanup(po);
+
+	return ret;
+}
+
+/**
+ * Read jobs from the standard input and decompile them in a pool of worker
+ * threads until the end of the input is reached.
+ */
+int runServer(const retdec::config::Config& baseConfig, unsigned workers)
+{
+	if (workers == 0)
+	{
+		workers = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Jobs' informative output would be interleaved -> print only errors.
+	Log::set(Log::Type::Info, Logger::Ptr(new Logger(std::cout, false)));
+
+	std::queue<std::pair<std::size_t, std::string>> jobs;
+	bool inputEnd = false;
+	std::mutex jobsMutex;
+	std::condition_variable jobsCv;
+	std::mutex outMutex;
+
+	auto worker = [&]()
+	{
+		while (true)
+		{
+			std::pair<std::size_t, std::string> job;
+			{
+				std::unique_lock<std::mutex> lock(jobsMutex);
+				jobsCv.wait(lock, [&]() { return inputEnd || !jobs.empty(); });
+				if (jobs.empty())
+				{
+					return;
+				}
+				job = std::move(jobs.front());
+				jobs.pop();
+			}
+
+			int ret = runServerJob(baseConfig, job.first, job.second, workers);
+
+			std::lock_guard<std::mutex> lock(outMutex);
+			std::cout << job.first << " " << ret << std::endl;
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned i = 0; i < workers; ++i)
+	{
+		pool.emplace_back(worker);
+	}
+
+	std::size_t jobIndex = 0;
+	std::string line;
+	while (std::getline(std::cin, line))
+	{
+		++jobIndex;
+		if (retdec::utils::trim(line).empty())
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		jobs.emplace(jobIndex, line);
+		jobsCv.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		inputEnd = true;
+	}
+	jobsCv.notify_all();
+
+	for (auto& t : pool)
+	{
+		t.join();
+	}
+
+	return EXIT_SUCCESS;
+}
+
 //
 //==============================================================================
 // Main.
@@ -1021,37 +1424,62 @@ int main(int argc, char **argv)
 	//
 	limitMaximalMemoryIfRequested(config.parameters);
 
+	// Server mode.
+	//
+	if (po.server)
+	{
+		return runServer(config, po.serverWorkers);
+	}
 
 	// Decompile.
 	//
 	int ret = 0;
 	try
 	{
-		std::stringstream buffer;
+		// The decompilation stops by itself when the timeout expires and
+		// emits the output from what has been decompiled so far.
+		retdec::utils::CancellationToken cancellation;
 		if (config.parameters.isTimeout())
 		{
-			std::packaged_task<
-					int(retdec::config::Config&,
-					ProgramOptions&)> task(decompile);
-			auto future = task.get_future();
-			std::thread thr(std::move(task), std::ref(config), std::ref(po));
 			auto timeout = std::chrono::seconds(config.parameters.getTimeout());
-			if (future.wait_for(timeout) != std::future_status::timeout)
-			{
-				thr.join();
-				ret = future.get(); // this will propagate exception
-			}
-			else
+			cancellation.setTimeout(timeout);
+
+			// The passes producing the output (e.g. the conversion to the
+			// back-end IR or the writers) are not cancelled, so the
+			// decompilation runs in a separate thread, which is abandoned
+			// when it does not stop within the grace period.
+			std::packaged_task<int()> task([&]() {
+				return decompile(config, po, &cancellation);
+			});
+			auto future = task.get_future();
+			std::thread thr(std::move(task));
+			if (future.wait_for(timeout + TIMEOUT_GRACE_PERIOD)
+					== std::future_status::timeout)
 			{
-				thr.detach(); // we leave the thread still running
-				Log::error() << "timeout after: " << config.parameters.getTimeout()
-						<< " seconds" << std::endl;
-				ret = EXIT_TIMEOUT;
+				thr.detach();
+				Log::error() << "timeout after: "
+						<< config.parameters.getTimeout() << " seconds, "
+						<< "the decompilation did not stop within "
+						<< TIMEOUT_GRACE_PERIOD.count() << " more seconds"
+						<< std::endl;
+				cleanup(po);
+				// Do not run destructors of static objects (e.g. LLVM's)
+				// that are still being used by the abandoned thread.
+				std::_Exit(EXIT_TIMEOUT);
 			}
+			thr.join();
+			ret = future.get(); // this will propagate exception
 		}
 		else
 		{
-			ret = decompile(config, po);
+			ret = decompile(config, po, &cancellation);
+		}
+
+		if (cancellation.isCancelled())
+		{
+			Log::error() << "timeout after: " << config.parameters.getTimeout()
+					<< " seconds" << std::endl;
+			ret = EXIT_TIMEOUT;
 		}
 	}
 	catch (const std::runtime_error& e)
@@ -6,6 +6,8 @@ if(NOT TARGET retdec::retdec)
             bin2llvmir
             llvmir2hll
             config
+            fileformat
+            utils
             common
             capstone
             llvm
@@ -4,6 +4,10 @@
  * @copyright (c) 2019 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CallGraph.h>
 #include <llvm/Analysis/CallGraphSCCPass.h>
@@ -12,6 +16,8 @@
 #include <llvm/Analysis/ScalarEvolution.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/CodeGen/CommandFlags.inc>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/DataLayout.h>
@@ -21,6 +27,7 @@
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LegacyPassNameParser.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/OptBisect.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/InitializePasses.h>
@@ -47,9 +54,18 @@
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
 
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
 #include "retdec/config/config.h"
+#include "retdec/fileformat/file_format/file_format.h"
+#include "retdec/fileformat/utils/crypto.h"
 #include "retdec/retdec/retdec.h"
+#include "retdec/utils/cancellation.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/pass_profiler.h"
+#include "retdec/utils/result_cache.h"
+#include "retdec/utils/version.h"
 #include "retdec/utils/io/log.h"
 
 using namespace retdec::utils::io;
@@ -298,6 +314,15 @@ void fillFunctions(
 	}
 }
 
+LlvmModuleContextPair::~LlvmModuleContextPair()
+{
+	bin2llvmir::ProviderInitialization::clearProviders(module.get());
+
+	// Order matters: module destructor uses context.
+	module.reset();
+	context.reset();
+}
+
 LlvmModuleContextPair disassemble(
 		const std::string& inputPath,
 		retdec::common::FunctionSet* fs)
@@ -329,18 +354,24 @@ LlvmModuleContextPair disassemble(
 
 /**
  * Call a bunch of LLVM initialization functions, same as the original opt.
+ * Passes are initialized only once per process, it is safe to call this
+ * function from several threads.
  */
 llvm::PassRegistry& initializeLlvmPasses()
 {
-	// Initialize passes
-	llvm::PassRegistry& Registry = *llvm::PassRegistry::getPassRegistry();
-	initializeCore(Registry);
-	initializeScalarOpts(Registry);
-	initializeIPO(Registry);
-	initializeAnalysis(Registry);
-	initializeTransformUtils(Registry);
-	initializeInstCombine(Registry);
-	initializeTarget(Registry);
+	static llvm::PassRegistry& Registry = []() -> llvm::PassRegistry&
+	{
+		// Initialize passes
+		llvm::PassRegistry& R = *llvm::PassRegistry::getPassRegistry();
+		initializeCore(R);
+		initializeScalarOpts(R);
+		initializeIPO(R);
+		initializeAnalysis(R);
+		initializeTransformUtils(R);
+		initializeInstCombine(R);
+		initializeTarget(R);
+		return R;
+	}();
 	return Registry;
 }
 
@@ -357,7 +388,7 @@ class ModulePassPrinter : public ModulePass
 		std::string PhaseArg;
 		std::string PassName;
 
-		static std::string LastPhase;
+		static thread_local std::string LastPhase;
 		inline static const std::string LlvmAggregatePhaseName = "LLVM";
 
 	public:
@@ -406,21 +437,161 @@ class ModulePassPrinter : public ModulePass
 		}
 };
 char ModulePassPrinter::ID = 0;
-std::string ModulePassPrinter::LastPhase;
+thread_local std::string ModulePassPrinter::LastPhase;
+
+/**
+ * Get the size of LLVM IR in the given module.
+ * Only defined functions are counted. Memory of ASM instructions is the memory
+ * of the module's Capstone instruction arena.
+ */
+utils::IrSize getIrSize(const Module& M)
+{
+	utils::IrSize size;
+	for (auto& F : M)
+	{
+		if (F.isDeclaration())
+		{
+			continue;
+		}
+
+		++size.functions;
+		for (auto& B : F)
+		{
+			++size.blocks;
+			size.instructions += B.size();
+		}
+	}
+	size.asmInstructionsMemory = bin2llvmir::AsmInstruction::getCapstoneInsnArena(
+			&M)->getMemoryUsage();
+	return size;
+}
+
+/**
+ * This pass starts or ends profiling of other pass.
+ * In pass manager, the starting instance should be placed right before the
+ * profiled pass, and the ending one right after it.
+ */
+class ModulePassProfiler : public ModulePass
+{
+	public:
+		static char ID;
+		utils::PassProfiler* Profiler;
+		std::string PhaseArg;
+		bool Start;
+		std::string PassName;
+
+	public:
+		ModulePassProfiler(
+				utils::PassProfiler* profiler,
+				const std::string& phaseArg,
+				bool start)
+				: ModulePass(ID)
+				, Profiler(profiler)
+				, PhaseArg(phaseArg)
+				, Start(start)
+				, PassName("ModulePass Profiler: " + PhaseArg)
+		{
+
+		}
+
+		bool runOnModule(Module &M) override
+		{
+			if (Start)
+			{
+				Profiler->startPass("bin2llvmir", PhaseArg, getIrSize(M));
+			}
+			else
+			{
+				Profiler->endPass(getIrSize(M));
+			}
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return PassName.c_str();
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+};
+char ModulePassProfiler::ID = 0;
+
+/**
+ * Pass gate skipping optional passes once the decompilation is cancelled.
+ * Optional passes (all LLVM optimizations and RetDec's optional analyses and
+ * optimizations) ask the gate whether they should run through
+ * skipModule()/skipFunction()/etc. Passes needed to produce the output
+ * (e.g. the writers and llvmir2hll) do not ask, so they always run.
+ */
+class CancellationPassGate : public OptPassGate
+{
+	public:
+		const utils::CancellationToken* Token;
+		bool Reported = false;
+
+	public:
+		CancellationPassGate(const utils::CancellationToken* token)
+				: Token(token)
+		{
+
+		}
+
+		bool shouldRunPass(const Pass* P, StringRef IRDescription) override
+		{
+			if (!Token->isCancelled())
+			{
+				return true;
+			}
+
+			if (!Reported)
+			{
+				Log::error() << Log::Warning << "decompilation cancelled, "
+						<< "skipping the remaining optional passes" << std::endl;
+				Reported = true;
+			}
+			return false;
+		}
+
+		bool isEnabled() const override
+		{
+			return true;
+		}
+};
 
 /**
  * Add the pass to the pass manager - no verification.
+ * If profiler is set, the pass is profiled by it.
  */
 static inline void addPass(
 		legacy::PassManagerBase& PM,
 		Pass* P,
-		const PassInfo* PI)
+		const PassInfo* PI,
+		utils::PassProfiler* profiler = nullptr)
 {
 	PM.add(new ModulePassPrinter(
 			PI->getPassName().str(),
 			PI->getPassArgument().str()
 	));
+	if (profiler)
+	{
+		PM.add(new ModulePassProfiler(
+				profiler,
+				PI->getPassArgument().str(),
+				true
+		));
+	}
 	PM.add(P);
+	if (profiler)
+	{
+		PM.add(new ModulePassProfiler(
+				profiler,
+				PI->getPassArgument().str(),
+				false
+		));
+	}
 
 // if (!PI->isAnalysis())
 // PM.add(P->createPrinterPass(
@@ -460,18 +631,403 @@ void setLogsFrom(const retdec::config::Parameters& params)
 	}
 }
 
-bool decompile(retdec::config::Config& config, std::string* outString)
+DecompilationSession::DecompilationSession(
+		retdec::config::Config& config,
+		std::string* outString)
+		: _config(config)
+		, _outString(outString)
+		, _context(std::make_unique<llvm::LLVMContext>())
 {
-	setLogsFrom(config.parameters);
+	_module = createLlvmModule(*_context);
+}
 
-	Log::phase("Initialization");
-	auto& passRegistry = initializeLlvmPasses();
+DecompilationSession::~DecompilationSession()
+{
+	bin2llvmir::ProviderInitialization::clearProviders(_module.get());
 
-	// limitMaximalMemoryIfRequested(params);
-	// PrintAfterAll = true;
+	// Order matters: module destructor uses context.
+	_module.reset();
+	_context.reset();
+}
 
-	auto context = std::make_unique<llvm::LLVMContext>();
-	auto module = createLlvmModule(*context);
+void DecompilationSession::setInputFile(
+		const std::shared_ptr<retdec::fileformat::FileFormat>& inputFile)
+{
+	_inputFile = inputFile;
+}
+
+void DecompilationSession::setCancellationToken(
+		const retdec::utils::CancellationToken* cancellation)
+{
+	_cancellation = cancellation;
+}
+
+llvm::Module* DecompilationSession::getModule() const
+{
+	return _module.get();
+}
+
+/**
+ * Serialize IR size into the JSON writer.
+ */
+template <typename Writer>
+void serializeIrSize(Writer& writer, const utils::IrSize& size)
+{
+	writer.StartObject();
+	writer.String("functions");
+	writer.Uint64(size.functions);
+	writer.String("blocks");
+	writer.Uint64(size.blocks);
+	writer.String("instructions");
+	writer.Uint64(size.instructions);
+	writer.String("asmInstructionsMemory");
+	writer.Uint64(size.asmInstructionsMemory);
+	writer.EndObject();
+}
+
+/**
+ * Write profiles of all the passes measured by the profiler into the given
+ * JSON file.
+ */
+void writePassProfile(
+		const utils::PassProfiler& profiler,
+		const std::string& outFile)
+{
+	rapidjson::StringBuffer sb;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::UTF8<>> writer(sb);
+
+	writer.StartObject();
+	writer.String("passes");
+	writer.StartArray();
+	for (auto& p : profiler.getProfiles())
+	{
+		writer.StartObject();
+		writer.String("component");
+		writer.String(p.component);
+		writer.String("name");
+		writer.String(p.name);
+		writer.String("depth");
+		writer.Uint64(p.depth);
+		writer.String("wallTime");
+		writer.Double(p.wallTime);
+		// CPU time of the process is reported only when it is not shared with
+		// other decompilations.
+		writer.String("cpuTime");
+		if (p.ranAlone)
+		{
+			writer.Double(p.cpuTime);
+		}
+		else
+		{
+			writer.Null();
+		}
+		writer.String("threadCpuTime");
+		writer.Double(p.threadCpuTime);
+		writer.String("processRssBefore");
+		writer.Uint64(p.residentMemoryBefore);
+		writer.String("processRssAfter");
+		writer.Uint64(p.residentMemoryAfter);
+		writer.String("processRssDelta");
+		writer.Int64(p.getResidentMemoryDelta());
+		writer.String("processRssPeak");
+		writer.Uint64(p.peakResidentMemory);
+		writer.String("irBefore");
+		serializeIrSize(writer, p.irSizeBefore);
+		writer.String("irAfter");
+		serializeIrSize(writer, p.irSizeAfter);
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	std::ofstream out(outFile);
+	if (!out)
+	{
+		Log::error() << Log::Warning
+				<< "failed to write pass profile: " << outFile << std::endl;
+		return;
+	}
+	out << sb.GetString() << std::endl;
+}
+
+//==============================================================================
+// result cache
+//==============================================================================
+
+/// Name of the first pass which is not cached -- the backend.
+const std::string CACHE_BACKEND_PASS = "retdec-llvmir2hll";
+/// Cached LLVM IR (bitcode) of the module before the backend.
+const std::string CACHE_MODULE_ARTIFACT = "module.bc";
+/// Cached config before the backend.
+const std::string CACHE_CONFIG_ARTIFACT = "config.json";
+/// Cached disassembly (output of retdec-write-dsm).
+const std::string CACHE_DSM_ARTIFACT = "output.dsm";
+
+/**
+ * Copy parameters which are specific to a single decompilation job (input
+ * and output files, logging, limits, and backend options) from \p from
+ * to \p to. These parameters do not influence the cached results.
+ */
+void copyJobParameters(
+		const config::Parameters& from,
+		config::Parameters& to)
+{
+	to.setIsVerboseOutput(from.isVerboseOutput());
+	to.setInputFile(from.getInputFile());
+	to.setOutputFile(from.getOutputFile());
+	to.setOutputBitcodeFile(from.getOutputBitcodeFile());
+	to.setOutputAsmFile(from.getOutputAsmFile());
+	to.setOutputLlvmirFile(from.getOutputLlvmirFile());
+	to.setOutputConfigFile(from.getOutputConfigFile());
+	to.setOutputUnpackedFile(from.getOutputUnpackedFile());
+	to.setOutputProfileFile(from.getOutputProfileFile());
+	to.setOutputFormat(from.getOutputFormat());
+	to.setLogFile(from.getLogFile());
+	to.setErrFile(from.getErrFile());
+	to.setCacheDirectory(from.getCacheDirectory());
+	to.setMaxMemoryLimit(from.getMaxMemoryLimit());
+	to.setIsMaxMemoryLimitHalfRam(from.isMaxMemoryLimitHalfRam());
+	to.setMaxMemorySoftLimit(from.getMaxMemorySoftLimit());
+	to.setTimeout(from.getTimeout());
+	to.setBackendOptsTimeout(from.getBackendOptsTimeout());
+	to.setBackendDisabledOpts(from.getBackendDisabledOpts());
+	to.setBackendEnabledOpts(from.getBackendEnabledOpts());
+	to.setBackendCallInfoObtainer(from.getBackendCallInfoObtainer());
+	to.setBackendVarRenamer(from.getBackendVarRenamer());
+	to.setBackendThreads(from.getBackendThreads());
+	to.setIsBackendNoOpts(from.isBackendNoOpts());
+	to.setIsBackendEmitCfg(from.isBackendEmitCfg());
+	to.setIsBackendEmitCg(from.isBackendEmitCg());
+	to.setIsBackendKeepAllBrackets(from.isBackendKeepAllBrackets());
+	to.setIsBackendKeepLibraryFuncs(from.isBackendKeepLibraryFuncs());
+	to.setIsBackendNoTimeVaryingInfo(from.isBackendNoTimeVaryingInfo());
+	to.setIsBackendNoVarRenaming(from.isBackendNoVarRenaming());
+	to.setIsBackendNoCompoundOperators(from.isBackendNoCompoundOperators());
+	to.setIsBackendNoSymbolicNames(from.isBackendNoSymbolicNames());
+	to.llvmPasses = from.llvmPasses;
+}
+
+/**
+ * Get the key of the cached results of the decompilation: SHA256 of the input
+ * file content and SHA256 of the decompiler version and the configuration the
+ * results depend on (i.e. without the job parameters, and with passes before
+ * the backend only), including stamps (size and modification time) of the
+ * used support files.
+ * \return Key or an empty string if the input file cannot be read.
+ */
+std::string getCacheKey(
+		const config::Config& config,
+		const fileformat::FileFormat* inputFile,
+		std::size_t backendStart)
+{
+	std::string inputHash = inputFile ? inputFile->getSha256() : "";
+	if (inputHash.empty())
+	{
+		std::ifstream in(config.parameters.getInputFile(), std::ios::binary);
+		if (!in)
+		{
+			return "";
+		}
+		std::string content(
+				(std::istreambuf_iterator<char>(in)),
+				std::istreambuf_iterator<char>()
+		);
+		inputHash = fileformat::getSha256(
+				reinterpret_cast<const unsigned char*>(content.data()),
+				content.size()
+		);
+	}
+
+	auto c = config;
+	copyJobParameters(config::Parameters(), c.parameters);
+	c.parameters.llvmPasses.assign(
+			config.parameters.llvmPasses.begin(),
+			config.parameters.llvmPasses.begin() + backendStart
+	);
+	// Results also depend on the content of the used signatures, type
+	// information, patterns, etc., which may change without changing their
+	// paths.
+	std::vector<std::string> usedFiles;
+	for (const auto* paths : {
+			&config.parameters.userStaticSignaturePaths,
+			&config.parameters.staticSignaturePaths,
+			&config.parameters.libraryTypeInfoPaths,
+			&config.parameters.cryptoPatternPaths,
+			&config.parameters.abiPaths})
+	{
+		usedFiles.insert(usedFiles.end(), paths->begin(), paths->end());
+	}
+	for (const auto& path : {
+			config.parameters.getOrdinalNumbersDirectory(),
+			config.parameters.getInputPdbFile()})
+	{
+		if (!path.empty())
+		{
+			usedFiles.push_back(path);
+		}
+	}
+	// Results of other versions of the decompiler may differ.
+	auto json = utils::version::getVersionStringLong() + "\n"
+			+ c.generateJsonString() + "\n"
+			+ utils::ResultCache::getFilesStamp(usedFiles);
+	auto configHash = fileformat::getSha256(
+			reinterpret_cast<const unsigned char*>(json.data()),
+			json.size()
+	);
+
+	return inputHash + "-" + configHash;
+}
+
+/**
+ * Restore the module and the config from the cached results.
+ * Job parameters in \p config are kept.
+ * \return Module or \c nullptr if the results cannot be used for this job.
+ */
+std::unique_ptr<Module> loadCachedResults(
+		const utils::ResultCache::Artifacts& artifacts,
+		llvm::LLVMContext& context,
+		config::Config& config)
+{
+	auto bitcode = artifacts.find(CACHE_MODULE_ARTIFACT);
+	auto json = artifacts.find(CACHE_CONFIG_ARTIFACT);
+	auto dsm = artifacts.find(CACHE_DSM_ARTIFACT);
+	if (bitcode == artifacts.end()
+			|| json == artifacts.end()
+			|| (dsm == artifacts.end()
+					&& !config.parameters.getOutputAsmFile().empty()))
+	{
+		return nullptr;
+	}
+
+	config::Config cachedConfig;
+	try
+	{
+		cachedConfig.readJsonString(json->second);
+	}
+	catch (const config::Exception&)
+	{
+		return nullptr;
+	}
+
+	auto module = llvm::parseBitcodeFile(
+			llvm::MemoryBufferRef(bitcode->second, CACHE_MODULE_ARTIFACT),
+			context
+	);
+	if (!module)
+	{
+		llvm::consumeError(module.takeError());
+		return nullptr;
+	}
+
+	auto& asmFile = config.parameters.getOutputAsmFile();
+	if (!asmFile.empty())
+	{
+		std::ofstream out(asmFile, std::ios::binary);
+		if (!out.write(dsm->second.data(), dsm->second.size()))
+		{
+			return nullptr;
+		}
+	}
+
+	copyJobParameters(config.parameters, cachedConfig.parameters);
+	config = std::move(cachedConfig);
+	return std::move(*module);
+}
+
+/**
+ * Read the disassembly written by retdec-write-dsm into \p artifacts.
+ */
+void addCachedDsm(
+		const config::Config& config,
+		utils::ResultCache::Artifacts& artifacts)
+{
+	auto& asmFile = config.parameters.getOutputAsmFile();
+	if (asmFile.empty())
+	{
+		return;
+	}
+
+	std::ifstream in(asmFile, std::ios::binary);
+	if (in)
+	{
+		artifacts[CACHE_DSM_ARTIFACT].assign(
+				std::istreambuf_iterator<char>(in),
+				std::istreambuf_iterator<char>()
+		);
+	}
+}
+
+/**
+ * This pass takes a snapshot of the module and the config for the result
+ * cache. In pass manager, it should be placed right before the backend.
+ */
+class CacheSnapshotPass : public ModulePass
+{
+	public:
+		static char ID;
+		const config::Config* Config;
+		utils::ResultCache::Artifacts* Artifacts;
+
+	public:
+		CacheSnapshotPass(
+				const config::Config* config,
+				utils::ResultCache::Artifacts* artifacts)
+				: ModulePass(ID)
+				, Config(config)
+				, Artifacts(artifacts)
+		{
+
+		}
+
+		bool runOnModule(Module &M) override
+		{
+			// The results may be incomplete, do not cache them.
+			if (utils::isMemorySoftLimitExceeded())
+			{
+				return false;
+			}
+
+			std::string bitcode;
+			llvm::raw_string_ostream os(bitcode);
+			bool ShouldPreserveUseListOrder = true;
+			WriteBitcodeToFile(M, os, ShouldPreserveUseListOrder);
+			os.flush();
+
+			(*Artifacts)[CACHE_MODULE_ARTIFACT] = std::move(bitcode);
+			(*Artifacts)[CACHE_CONFIG_ARTIFACT] = Config->generateJsonString();
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return "Result Cache Snapshot";
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+};
+char CacheSnapshotPass::ID = 0;
+
+/**
+ * Should the pass be run even if the results before the backend are loaded
+ * from the cache? These are the writers of the module and the config.
+ */
+bool isRunOnCachedResults(const std::string& pass)
+{
+	return pass == "retdec-write-ll"
+			|| pass == "retdec-write-bc"
+			|| pass == "retdec-write-config";
+}
+
+int DecompilationSession::run()
+{
+	// Lets the pass profiler know whether other decompilations (e.g. those of
+	// a server) run concurrently with this one.
+	utils::RunningJob job;
+
+	auto& passRegistry = initializeLlvmPasses();
 
 	// Create a PassManager to hold and optimize the collection of passes we
 	// are about to build.
@@ -481,29 +1037,90 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	// e.g. printf() call -> puts() call
 	//
 	// Add an appropriate TargetLibraryInfo pass for the module's triple.
-	Triple ModuleTriple(module->getTargetTriple());
+	Triple ModuleTriple(_module->getTargetTriple());
 	TargetLibraryInfoImpl TLII(ModuleTriple);
 	// The -disable-simplify-libcalls flag actually disables all builtin optzns.
 	TLII.disableAllFunctions();
 	pm.add(new TargetLibraryInfoWrapperPass(TLII));
 
-	for (auto& p : config.parameters.llvmPasses)
+	if (_cancellation)
+	{
+		_passGate = std::make_unique<CancellationPassGate>(_cancellation);
+		_context->setOptPassGate(*_passGate);
+	}
+
+	std::unique_ptr<utils::PassProfiler> profiler;
+	auto& profileFile = _config.parameters.getOutputProfileFile();
+	if (!profileFile.empty())
+	{
+		profiler = std::make_unique<utils::PassProfiler>();
+	}
+
+	// Results of the passes before the backend may be cached.
+	//
+	auto& passes = _config.parameters.llvmPasses;
+	std::size_t backendStart = std::find(
+			passes.begin(),
+			passes.end(),
+			CACHE_BACKEND_PASS
+	) - passes.begin();
+	utils::ResultCache cache(_config.parameters.getCacheDirectory());
+	std::string cacheKey;
+	if (cache.isEnabled() && backendStart < passes.size())
+	{
+		cacheKey = getCacheKey(_config, _inputFile.get(), backendStart);
+	}
+
+	utils::ResultCache::Artifacts cacheArtifacts;
+	bool cached = false;
+	if (!cacheKey.empty() && cache.load(cacheKey, cacheArtifacts))
+	{
+		if (auto module = loadCachedResults(cacheArtifacts, *_context, _config))
+		{
+			Log::phase("Loading cached results");
+			_module = std::move(module);
+			bin2llvmir::ConfigProvider::addConfig(_module.get(), _config);
+			cached = true;
+		}
+		cacheArtifacts.clear();
+	}
+
+	for (std::size_t i = 0; i < passes.size(); ++i)
 	{
+		auto& p = passes[i];
+		if (cached && i < backendStart && !isRunOnCachedResults(p))
+		{
+			continue;
+		}
+		if (!cached && !cacheKey.empty() && i == backendStart)
+		{
+			pm.add(new CacheSnapshotPass(&_config, &cacheArtifacts));
+		}
+
 		if (auto* info = passRegistry.getPassInfo(p))
 		{
 			auto* pass = info->createPass();
-			addPass(pm, pass, info);
+			addPass(pm, pass, info, profiler.get());
 
 			if (info->getTypeInfo() == &bin2llvmir::ProviderInitialization::ID)
 			{
 				auto* p = static_cast<bin2llvmir::ProviderInitialization*>(pass);
-				p->setConfig(&config);
+				p->setConfig(&_config);
+				p->setInputFile(_inputFile);
+				p->setCancellationToken(_cancellation);
+			}
+			if (info->getTypeInfo() == &bin2llvmir::Decoder::ID)
+			{
+				auto* p = static_cast<bin2llvmir::Decoder*>(pass);
+				p->setCancellationToken(_cancellation);
 			}
 			if (info->getTypeInfo() == &llvmir2hll::LlvmIr2Hll::ID)
 			{
 				auto* p = static_cast<llvmir2hll::LlvmIr2Hll*>(pass);
-				p->setConfig(&config);
-				p->setOutputString(outString);
+				p->setConfig(&_config);
+				p->setOutputString(_outString);
+				p->setPassProfiler(profiler.get());
+				p->setCancellationToken(_cancellation);
 			}
 		}
 		else
@@ -513,9 +1130,60 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	}
 
 	// Now that we have all of the passes ready, run them.
-	pm.run(*module);
+	// The profile is written even if a pass fails, so it can be used to find
+	// out which one it was.
+	try
+	{
+		pm.run(*_module);
+	}
+	catch (...)
+	{
+		if (profiler)
+		{
+			profiler->endAllPasses();
+			writePassProfile(*profiler, profileFile);
+		}
+		throw;
+	}
+
+	if (profiler)
+	{
+		writePassProfile(*profiler, profileFile);
+	}
+
+	if (cached)
+	{
+		// Normally done by the finalization of retdec-provider-init.
+		bin2llvmir::ConfigProvider::doFinalization(_module.get());
+	}
+	else if (!cacheArtifacts.empty()
+			&& _config.parameters.getDecoderTimeout() == 0
+			&& !(_cancellation && _cancellation->isCancelled()))
+	{
+		addCachedDsm(_config, cacheArtifacts);
+		cache.store(cacheKey, cacheArtifacts);
+	}
 
 	return EXIT_SUCCESS;
 }
 
+int decompile(
+		retdec::config::Config& config,
+		std::string* outString,
+		const std::shared_ptr<retdec::fileformat::FileFormat>& inputFile,
+		const retdec::utils::CancellationToken* cancellation)
+{
+	setLogsFrom(config.parameters);
+
+	Log::phase("Initialization");
+
+	// limitMaximalMemoryIfRequested(params);
+	// PrintAfterAll = true;
+
+	DecompilationSession session(config, outString);
+	session.setInputFile(inputFile);
+	session.setCancellationToken(cancellation);
+	return session.run();
+}
+
 } // namespace retdec
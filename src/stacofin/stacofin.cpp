@@ -695,6 +695,22 @@ const DetectedFunctionsPtrMap& Finder::getConfirmedDetections() const
 void Finder::search(
 	const Image& image,
 	const std::string& yaraFile)
+{
+	search(image, std::set<std::string>{yaraFile});
+}
+
+/**
+ * Search for static code in input file.
+ *
+ * All the signature files are evaluated by a single detector, so that the
+ * input is scanned by all their text rules at once.
+ *
+ * @param image input file image
+ * @param yaraFiles static code signature files
+ */
+void Finder::search(
+	const retdec::loader::Image& image,
+	const std::set<std::string>& yaraFiles)
 {
 	// Get FileFormat instance.
 	const auto* fileFormat = image.getFileFormat();
@@ -703,11 +719,14 @@ void Finder::search(
 		return;
 	}
 
-	// Start Yara detector.
+	// Start Yara detector. Every file has its own namespace, so rules from
+	// different files do not collide and detected rules know their files.
 	YaraDetector detector;
-	detector.addRuleFile(yaraFile);
-	auto inputBytes = fileFormat->getLoadedBytes();
-	detector.analyze(inputBytes);
+	for (const auto& yaraFile : yaraFiles)
+	{
+		detector.addRuleFile(yaraFile, yaraFile);
+	}
+	detector.analyze(fileFormat->getLoadedBytes());
 	if (!detector.isInValidState())
 	{
 		return;
@@ -717,7 +736,7 @@ void Finder::search(
 	for (const YaraRule &detectedRule : detector.getDetectedRules())
 	{
 		DetectedFunction detectedFunction;
-		detectedFunction.signaturePath = yaraFile;
+		detectedFunction.signaturePath = detectedRule.getRuleFile();
 
 		for (const YaraMeta &ruleMeta : detectedRule.getMetas())
 		{
@@ -770,22 +789,6 @@ void Finder::search(
 	}
 }
 
-/**
- * Search for static code in input file.
- *
- * @param image input file image
- * @param yaraFiles static code signature files
- */
-void Finder::search(
-	const retdec::loader::Image& image,
-	const std::set<std::string>& yaraFiles)
-{
-	for (const auto& f : yaraFiles)
-	{
-		search(image, f);
-	}
-}
-
 /**
  * Search for static code in input file based on information in config file.
  *
@@ -424,7 +424,7 @@ template <int bits> void PeUpxStub<bits>::unpackData(DynamicBuffer& unpackedData
  */
 template <int bits> void PeUpxStub<bits>::readPackedFileILT(DynamicBuffer& ilt)
 {
-	const PeLib::ImageLoader imageLoader = _newPeFile->imageLoader();
+	const PeLib::ImageLoader & imageLoader = _newPeFile->imageLoader();
 	std::uint32_t importRva = imageLoader.getDataDirRva(PeLib::PELIB_IMAGE_DIRECTORY_ENTRY_IMPORT);
 	std::uint32_t importSize = imageLoader.getDataDirSize(PeLib::PELIB_IMAGE_DIRECTORY_ENTRY_IMPORT);
 
@@ -39,7 +39,7 @@ enum ExitCode
 	EXIT_CODE_MEMORY_LIMIT_ERROR ///< There was an error when setting the memory limit.
 };
 
-bool detectPackers(const std::string& inputFile, std::vector<retdec::cpdetect::DetectResult>& detectedPackers)
+bool detectPackers(const std::string& inputFile, fileformat::FileFormat* inputFileParser, std::vector<retdec::cpdetect::DetectResult>& detectedPackers)
 {
 	using namespace retdec::cpdetect;
 	using namespace retdec::fileformat;
@@ -57,7 +57,14 @@ bool detectPackers(const std::string& inputFile, std::vector<retdec::cpdetect::D
 			return false;
 		default:
 		{
-			auto fileParser = createFileFormat(inputFile);
+			// Reuse the already parsed file if we got one
+			std::unique_ptr<FileFormat> fileParserOwner;
+			auto* fileParser = inputFileParser;
+			if (!fileParser || fileParser->getPathToFile() != inputFile)
+			{
+				fileParserOwner = createFileFormat(inputFile);
+				fileParser = fileParserOwner.get();
+			}
 			if (!fileParser)
 			{
 				Log::error() << "Error while detecting format of file '" << inputFile << "'! Please, report this." << std::endl;
@@ -65,7 +72,7 @@ bool detectPackers(const std::string& inputFile, std::vector<retdec::cpdetect::D
 			}
 
 			auto compilerDetector = std::make_unique<CompilerDetector>(
-					*(fileParser.get()),
+					*fileParser,
 					detectionParams,
 					toolInfo
 			);
@@ -118,7 +125,7 @@ ExitCode unpackFile(const std::string& inputFile, const std::string& outputFile,
 	return ret;
 }
 
-ExitCode processArgs(ArgHandler& handler, char argc, char** argv)
+ExitCode processArgs(ArgHandler& handler, char argc, char** argv, fileformat::FileFormat* inputFileParser)
 {
 	// In case of failed parsing just print the help
 	if (!handler.parse(argc, argv))
@@ -192,7 +199,7 @@ ExitCode processArgs(ArgHandler& handler, char argc, char** argv)
 		std::string outputFile = handler["output"]->used ? handler["output"]->input : std::string{inputFile}.append("-unpacked");
 		std::vector<retdec::cpdetect::DetectResult> detectedPackers;
 
-		if (!detectPackers(inputFile, detectedPackers))
+		if (!detectPackers(inputFile, inputFileParser, detectedPackers))
 			return EXIT_CODE_PREPROCESSING_ERROR;
 
 		return unpackFile(inputFile, outputFile, brute, detectedPackers);
@@ -204,7 +211,7 @@ ExitCode processArgs(ArgHandler& handler, char argc, char** argv)
 	return EXIT_CODE_OK;
 }
 
-int _main(int argc, char** argv)
+int _main(int argc, char** argv, fileformat::FileFormat* inputFile)
 {
 	ArgHandler handler("unpacker options [PACKED_FILE] [optional]");
 	handler.setHelp(
@@ -242,7 +249,7 @@ int _main(int argc, char** argv)
 	handler.registerArg('m', "max-memory", true);
 	handler.registerArg('M', "max-memory-half-ram", false);
 
-	return processArgs(handler, argc, argv);
+	return processArgs(handler, argc, argv, inputFile);
 }
 
 } // namespace unpackertool
@@ -0,0 +1,79 @@
+/**
+* @file src/utils/cancellation.cpp
+* @brief Cooperative cancellation of long-running work.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <limits>
+
+#include "retdec/utils/cancellation.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/// Value of the deadline of tokens without a deadline.
+constexpr auto NO_DEADLINE =
+	std::numeric_limits<CancellationToken::Clock::rep>::max();
+
+} // anonymous namespace
+
+/**
+* @brief Creates a new token without a deadline.
+*
+* @param[in] parent If non-null, the created token is cancelled whenever @a
+*                   parent is. @a parent has to outlive the created token.
+*/
+CancellationToken::CancellationToken(const CancellationToken *parent):
+	parent(parent), cancelled(false), deadline(NO_DEADLINE) {}
+
+/**
+* @brief Cancels the token.
+*/
+void CancellationToken::cancel() {
+	cancelled = true;
+}
+
+/**
+* @brief Cancels the token at the given point of time.
+*/
+void CancellationToken::setDeadline(Clock::time_point deadline) {
+	this->deadline = deadline.time_since_epoch().count();
+}
+
+/**
+* @brief Cancels the token after @a timeout from now.
+*/
+void CancellationToken::setTimeout(Clock::duration timeout) {
+	setDeadline(Clock::now() + timeout);
+}
+
+/**
+* @brief Does the token have a deadline?
+*/
+bool CancellationToken::hasDeadline() const {
+	return deadline != NO_DEADLINE;
+}
+
+/**
+* @brief Has the token been cancelled?
+*
+* It returns @c true if @c cancel() has been called, if the deadline has
+* passed, or if the parent token has been cancelled.
+*/
+bool CancellationToken::isCancelled() const {
+	if (cancelled) {
+		return true;
+	}
+
+	auto d = deadline.load();
+	if (d != NO_DEADLINE && Clock::now().time_since_epoch().count() >= d) {
+		return true;
+	}
+
+	return parent && parent->isCancelled();
+}
+
+} // namespace utils
+} // namespace retdec
@@ -4,6 +4,7 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <atomic>
 #include <cstddef>
 
 #include "retdec/utils/memory.h"
@@ -11,10 +12,16 @@
 
 #ifdef OS_WINDOWS
 	#include <windows.h>
+	#include <psapi.h>
 #elif defined(OS_MACOS) || defined(OS_BSD)
 	#include <sys/types.h>
 	#include <sys/sysctl.h>
+	#ifdef OS_MACOS
+		#include <mach/mach.h>
+	#endif
 #else
+	#include <fstream>
+	#include <unistd.h>
 	#include <sys/sysinfo.h>
 #endif
 
@@ -27,6 +34,12 @@ namespace utils {
 
 namespace {
 
+/// Soft limit of the memory (in bytes), zero if there is none.
+std::atomic<std::size_t> memorySoftLimit(0);
+
+/// Kind of memory compared with @c memorySoftLimit.
+std::atomic<MemoryKind> memorySoftLimitKind(MemoryKind::Resident);
+
 #ifdef OS_POSIX
 
 /**
@@ -41,6 +54,24 @@ bool limitSystemMemoryOnPOSIX(std::size_t limit) {
 	return rc == 0;
 }
 
+/**
+* @brief Implementation of @c getPeakResidentMemory() on POSIX-compliant
+*        systems.
+*/
+std::size_t getPeakResidentMemoryOnPOSIX() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#ifdef OS_MACOS
+	// On macOS, ru_maxrss is in bytes.
+	return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+	// Elsewhere, ru_maxrss is in kilobytes.
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
 #endif
 
 #ifdef OS_WINDOWS
@@ -98,6 +129,17 @@ bool limitSystemMemoryOnWindows(std::size_t limit) {
 	return succeeded;
 }
 
+/**
+* @brief Obtains memory counters of the current process on Windows.
+*/
+bool getProcessMemoryCountersOnWindows(PROCESS_MEMORY_COUNTERS &counters) {
+	return GetProcessMemoryInfo(
+		GetCurrentProcess(),
+		&counters,
+		sizeof(counters)
+	);
+}
+
 #elif defined(OS_MACOS)
 
 /**
@@ -121,6 +163,36 @@ bool limitSystemMemoryOnMacOS(std::size_t limit) {
 	return limitSystemMemoryOnPOSIX(limit);
 }
 
+/**
+* @brief Implementation of @c getCurrentResidentMemory() on MacOS.
+*/
+std::size_t getCurrentResidentMemoryOnMacOS() {
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	auto rc = task_info(
+		mach_task_self(),
+		MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info),
+		&count
+	);
+	return rc == KERN_SUCCESS ? info.resident_size : 0;
+}
+
+/**
+* @brief Implementation of @c getCurrentVirtualMemory() on MacOS.
+*/
+std::size_t getCurrentVirtualMemoryOnMacOS() {
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	auto rc = task_info(
+		mach_task_self(),
+		MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info),
+		&count
+	);
+	return rc == KERN_SUCCESS ? info.virtual_size : 0;
+}
+
 #elif defined(OS_BSD)
 
 /**
@@ -163,6 +235,39 @@ bool limitSystemMemoryOnLinux(std::size_t limit) {
 	return limitSystemMemoryOnPOSIX(limit);
 }
 
+/**
+* @brief Returns the given field of @c /proc/self/statm converted to bytes.
+*
+* @param[in] field Zero-based index of the field.
+*/
+std::size_t getStatmFieldOnLinux(std::size_t field) {
+	std::ifstream statm("/proc/self/statm");
+	std::size_t pages = 0;
+	for (std::size_t i = 0; i <= field; ++i) {
+		if (!(statm >> pages)) {
+			return 0;
+		}
+	}
+	auto pageSize = sysconf(_SC_PAGESIZE);
+	return pageSize > 0 ? pages * static_cast<std::size_t>(pageSize) : 0;
+}
+
+/**
+* @brief Implementation of @c getCurrentResidentMemory() on Linux.
+*/
+std::size_t getCurrentResidentMemoryOnLinux() {
+	// The second field of /proc/self/statm is the resident set size in pages.
+	return getStatmFieldOnLinux(1);
+}
+
+/**
+* @brief Implementation of @c getCurrentVirtualMemory() on Linux.
+*/
+std::size_t getCurrentVirtualMemoryOnLinux() {
+	// The first field of /proc/self/statm is the virtual memory size in pages.
+	return getStatmFieldOnLinux(0);
+}
+
 #endif
 
 } // anonymous namespace
@@ -222,5 +327,117 @@ bool limitSystemMemoryToHalfOfTotalSystemMemory() {
 	return limitSystemMemory(totalSize / 2);
 }
 
+/**
+* @brief Returns the current resident set size of the process (in bytes).
+*
+* When the size cannot be obtained, it returns @c 0.
+*/
+std::size_t getCurrentResidentMemory() {
+#ifdef OS_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	return getProcessMemoryCountersOnWindows(counters)
+		? counters.WorkingSetSize : 0;
+#elif defined(OS_MACOS)
+	return getCurrentResidentMemoryOnMacOS();
+#elif defined(OS_BSD)
+	// There is no cheap way of obtaining the current size on *BSD, so we
+	// approximate it by the peak size.
+	return getPeakResidentMemoryOnPOSIX();
+#else
+	return getCurrentResidentMemoryOnLinux();
+#endif
+}
+
+/**
+* @brief Returns the peak resident set size of the process (in bytes) since
+*        its start.
+*
+* When the size cannot be obtained, it returns @c 0.
+*/
+std::size_t getPeakResidentMemory() {
+#ifdef OS_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	return getProcessMemoryCountersOnWindows(counters)
+		? counters.PeakWorkingSetSize : 0;
+#else
+	return getPeakResidentMemoryOnPOSIX();
+#endif
+}
+
+/**
+* @brief Returns the current size of the virtual memory of the process (in
+*        bytes).
+*
+* This is the size limited by @c limitSystemMemory(): the address space on
+* POSIX systems and the committed memory on Windows. When the size cannot be
+* obtained, it returns @c 0.
+*/
+std::size_t getCurrentVirtualMemory() {
+#ifdef OS_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	return getProcessMemoryCountersOnWindows(counters)
+		? counters.PagefileUsage : 0;
+#elif defined(OS_MACOS)
+	return getCurrentVirtualMemoryOnMacOS();
+#elif defined(OS_BSD)
+	// There is no cheap way of obtaining the size on *BSD, so we approximate
+	// it by the resident size.
+	return getCurrentResidentMemory();
+#else
+	return getCurrentVirtualMemoryOnLinux();
+#endif
+}
+
+/**
+* @brief Sets the soft limit of the memory of the process (in bytes).
+*
+* @param[in] limit The limit, @c 0 if there is none.
+* @param[in] kind Kind of memory compared with the limit. A limit derived from
+*                 the limit set by @c limitSystemMemory() has to be compared
+*                 with the virtual memory, which is what the system limits.
+*
+* Unlike @c limitSystemMemory(), the soft limit is not enforced by the system.
+* Expensive parts of the decompilation check it by using @c
+* isMemorySoftLimitExceeded() and are skipped or downgraded when it is
+* exceeded, so the decompilation can finish before it runs out of memory.
+*/
+void setMemorySoftLimit(std::size_t limit, MemoryKind kind) {
+	memorySoftLimitKind = kind;
+	memorySoftLimit = limit;
+}
+
+/**
+* @brief Returns the soft limit of the memory of the process (in bytes), @c 0
+*        if there is none.
+*/
+std::size_t getMemorySoftLimit() {
+	return memorySoftLimit;
+}
+
+/**
+* @brief Returns the kind of memory compared with the soft limit.
+*/
+MemoryKind getMemorySoftLimitKind() {
+	return memorySoftLimitKind;
+}
+
+/**
+* @brief Returns @c true if the memory of the process is above the soft limit,
+*        @c false otherwise.
+*
+* When there is no soft limit, it returns @c false.
+*/
+bool isMemorySoftLimitExceeded() {
+	auto limit = getMemorySoftLimit();
+	if (limit == 0) {
+		return false;
+	}
+
+	auto current = getMemorySoftLimitKind() == MemoryKind::Virtual
+		? getCurrentVirtualMemory()
+		: getCurrentResidentMemory();
+	return current > limit;
+}
+
 } // namespace utils
 } // namespace retdec
@@ -0,0 +1,94 @@
+/**
+* @file src/utils/parallel.cpp
+* @brief Processing of independent items by several threads.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "retdec/utils/parallel.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Returns the number of threads to be used for the configured number
+*        of threads.
+*
+* Zero means to use all CPU cores.
+*/
+std::size_t getNumberOfThreads(std::uint64_t configuredThreads) {
+	if (configuredThreads == 0) {
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+	return static_cast<std::size_t>(configuredThreads);
+}
+
+/**
+* @brief Processes items with indexes 0 to @a count - 1 by up to @a threads
+*        threads.
+*
+* @param[in] count Number of the items.
+* @param[in] threads Maximal number of threads, including the calling thread.
+*                    At most @a count threads are used, and at least one.
+* @param[in] process Processes the item with the given index. It also gets the
+*                    index of the thread processing the item, which is smaller
+*                    than @a threads, so threads can keep their own state.
+*                    Returning @c false stops the processing.
+*
+* Threads take the items one by one in the order of their indexes until all of
+* them are processed. If @a process returns @c false or throws an exception, no
+* more items are taken. The first thrown exception is rethrown after all the
+* threads finish.
+*/
+void parallelFor(std::size_t count, std::size_t threads,
+		const std::function<bool (std::size_t item, std::size_t thread)> &process) {
+	std::atomic<std::size_t> nextItem(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+
+	auto processItems = [&](std::size_t thread) {
+		try {
+			for (auto i = nextItem++; i < count; i = nextItem++) {
+				if (!process(i, thread)) {
+					nextItem = count;
+					break;
+				}
+			}
+		} catch (...) {
+			nextItem = count;
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	};
+
+	auto threadsCount = std::max<std::size_t>(1, std::min(threads, count));
+	std::vector<std::thread> workers;
+	for (std::size_t i = 1; i < threadsCount; ++i) {
+		try {
+			workers.emplace_back(processItems, i);
+		} catch (const std::system_error &) {
+			// The items are processed by the threads that could be started.
+			break;
+		}
+	}
+	processItems(0);
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,164 @@
+/**
+* @file src/utils/pass_profiler.cpp
+* @brief Collection of performance data about passes of the decompilation.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "retdec/utils/memory.h"
+#include "retdec/utils/pass_profiler.h"
+#include "retdec/utils/time.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+std::atomic<std::size_t> runningJobsCount(0);
+std::atomic<std::uint64_t> startedJobsCount(0);
+
+/**
+* @brief Was the profiled job the only job running in the process during a pass?
+*/
+bool ranAlone(std::size_t runningJobsAtStart, std::uint64_t startedJobsAtStart) {
+	// When no job is marked (e.g. in a tool running a single job), the process
+	// is assumed to run just the profiled one.
+	return runningJobsAtStart <= 1
+		&& RunningJob::getRunningJobsCount() <= 1
+		&& RunningJob::getStartedJobsCount() == startedJobsAtStart;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Marks the start of a job.
+*/
+RunningJob::RunningJob() {
+	++startedJobsCount;
+	++runningJobsCount;
+}
+
+/**
+* @brief Marks the end of a job.
+*/
+RunningJob::~RunningJob() {
+	--runningJobsCount;
+}
+
+/**
+* @brief Returns the number of jobs currently running in the process.
+*/
+std::size_t RunningJob::getRunningJobsCount() {
+	return runningJobsCount;
+}
+
+/**
+* @brief Returns the number of jobs started in the process so far.
+*/
+std::uint64_t RunningJob::getStartedJobsCount() {
+	return startedJobsCount;
+}
+
+/**
+* @brief Returns the change of the resident memory during the pass (in bytes).
+*
+* The result is negative when the pass released more memory than it acquired.
+*/
+std::int64_t PassProfile::getResidentMemoryDelta() const {
+	return static_cast<std::int64_t>(residentMemoryAfter)
+		- static_cast<std::int64_t>(residentMemoryBefore);
+}
+
+/**
+* @brief Starts measuring a pass.
+*
+* @param[in] component Part of the decompiler the pass belongs to.
+* @param[in] name Name of the pass.
+* @param[in] irSize Size of the IR before the pass is run.
+*
+* If there already is a running pass, the new pass is nested in it.
+*/
+void PassProfiler::startPass(const std::string &component,
+		const std::string &name, const IrSize &irSize) {
+	PassProfile profile;
+	profile.component = component;
+	profile.name = name;
+	profile.depth = running.size();
+	profile.irSizeBefore = irSize;
+	profile.residentMemoryBefore = getCurrentResidentMemory();
+	profiles.push_back(std::move(profile));
+
+	// Obtain the times as the last thing so the overhead of the profiler is
+	// not attributed to the pass.
+	running.push_back(RunningPass{profiles.size() - 1,
+		std::chrono::steady_clock::now(), getProcessCpuTime(),
+		getThreadCpuTime(), RunningJob::getRunningJobsCount(),
+		RunningJob::getStartedJobsCount()});
+}
+
+/**
+* @brief Ends measuring of the most recently started running pass.
+*
+* @param[in] irSize Size of the IR after the pass was run.
+*
+* If there is no running pass, this function does nothing.
+*/
+void PassProfiler::endPass(const IrSize &irSize) {
+	if (running.empty()) {
+		return;
+	}
+
+	auto threadCpuEnd = getThreadCpuTime();
+	auto cpuEnd = getProcessCpuTime();
+	auto wallEnd = std::chrono::steady_clock::now();
+
+	auto pass = running.back();
+	running.pop_back();
+
+	auto &profile = profiles[pass.index];
+	profile.cpuTime = cpuEnd - pass.cpuStart;
+	profile.threadCpuTime = threadCpuEnd - pass.threadCpuStart;
+	profile.ranAlone = ranAlone(pass.runningJobs, pass.startedJobs);
+	profile.wallTime = std::chrono::duration<double>(
+		wallEnd - pass.wallStart).count();
+	profile.residentMemoryAfter = getCurrentResidentMemory();
+	// The peak size may be updated by the system lazily, so make sure it is
+	// never below the current size.
+	profile.peakResidentMemory = std::max(getPeakResidentMemory(),
+		profile.residentMemoryAfter);
+	profile.irSizeAfter = irSize;
+}
+
+/**
+* @brief Ends all the running passes.
+*
+* This is useful when the passes were interrupted (e.g. by an exception), in
+* which case sizes of the IR after the passes are unknown.
+*/
+void PassProfiler::endAllPasses() {
+	while (!running.empty()) {
+		endPass();
+	}
+}
+
+/**
+* @brief Is there a pass being measured?
+*/
+bool PassProfiler::isPassRunning() const {
+	return !running.empty();
+}
+
+/**
+* @brief Returns profiles of all the passes, in the order they were started.
+*
+* Profiles of the running passes are incomplete.
+*/
+const std::vector<PassProfile> &PassProfiler::getProfiles() const {
+	return profiles;
+}
+
+} // namespace utils
+} // namespace retdec
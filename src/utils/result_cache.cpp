@@ -0,0 +1,179 @@
+/**
+* @file src/utils/result_cache.cpp
+* @brief On-disk cache of results of an analysis of a file.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/result_cache.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/**
+* @brief Can @a key be used as a name of a directory?
+*/
+bool isValidKey(const std::string &key) {
+	return !key.empty() && std::all_of(key.begin(), key.end(), [](char c) {
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+	});
+}
+
+/**
+* @brief Appends a stamp of the file or directory @a path to @a stamp.
+*/
+void appendFileStamp(const fs::path &path, std::string &stamp) {
+	std::error_code ec;
+	if (fs::is_directory(path, ec)) {
+		std::vector<fs::path> files;
+		fs::recursive_directory_iterator it(path, ec), end;
+		for (; !ec && it != end; it.increment(ec)) {
+			if (fs::is_regular_file(it->path(), ec)) {
+				files.push_back(it->path());
+			}
+		}
+		std::sort(files.begin(), files.end());
+		for (const auto &file : files) {
+			appendFileStamp(file, stamp);
+		}
+		return;
+	}
+
+	stamp += path.string() + "\t";
+	auto size = fs::file_size(path, ec);
+	auto time = ec ? fs::file_time_type() : fs::last_write_time(path, ec);
+	if (ec) {
+		stamp += "-\n";
+		return;
+	}
+	stamp += std::to_string(size) + "\t"
+		+ std::to_string(time.time_since_epoch().count()) + "\n";
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a cache stored in @a directory.
+*
+* If @a directory is empty, the cache is disabled: nothing is loaded and
+* nothing is stored.
+*/
+ResultCache::ResultCache(const std::string &directory): directory(directory) {}
+
+/**
+* @brief Is the cache enabled?
+*/
+bool ResultCache::isEnabled() const {
+	return !directory.empty();
+}
+
+/**
+* @brief Loads all artifacts of the entry with the given key.
+*
+* @param[in] key Key of the entry.
+* @param[out] artifacts Artifacts of the entry (name -> content).
+*
+* @return @c true if the entry exists and all its artifacts were loaded,
+*         @c false otherwise.
+*/
+bool ResultCache::load(const std::string &key, Artifacts &artifacts) const {
+	if (!isEnabled() || !isValidKey(key)) {
+		return false;
+	}
+
+	std::error_code ec;
+	fs::directory_iterator it(getEntryPath(key), ec);
+	if (ec) {
+		return false;
+	}
+
+	Artifacts loaded;
+	for (const auto &file : it) {
+		std::ifstream in(file.path(), std::ios::binary);
+		if (!in) {
+			return false;
+		}
+
+		auto &content = loaded[file.path().filename().string()];
+		content.assign(std::istreambuf_iterator<char>(in),
+			std::istreambuf_iterator<char>());
+		if (in.bad()) {
+			return false;
+		}
+	}
+
+	artifacts = std::move(loaded);
+	return true;
+}
+
+/**
+* @brief Stores @a artifacts as the entry with the given key.
+*
+* @param[in] key Key of the entry.
+* @param[in] artifacts Artifacts of the entry (name -> content). Names have to
+*                      be valid file names.
+*
+* @return @c true if the entry was stored, @c false otherwise. An existing
+*         entry is not replaced.
+*/
+bool ResultCache::store(const std::string &key, const Artifacts &artifacts) const {
+	if (!isEnabled() || !isValidKey(key)) {
+		return false;
+	}
+
+	std::error_code ec;
+	fs::create_directories(directory, ec);
+	auto entryPath = getEntryPath(key);
+	auto tmpPath = entryPath + "." + std::to_string(std::random_device()()) + ".tmp";
+	bool ok = fs::create_directory(tmpPath, ec);
+	for (auto it = artifacts.begin(); ok && it != artifacts.end(); ++it) {
+		std::ofstream out(fs::path(tmpPath) / it->first, std::ios::binary);
+		ok = out.write(it->second.data(), it->second.size()).good();
+	}
+
+	if (ok) {
+		fs::rename(tmpPath, entryPath, ec);
+		ok = !ec;
+	}
+	if (fs::exists(tmpPath, ec)) {
+		fs::remove_all(tmpPath, ec);
+	}
+	return ok;
+}
+
+/**
+* @brief Returns a stamp of the given files.
+*
+* The stamp consists of the path, size, and time of the last modification of
+* each file. Directories are traversed recursively. Missing files are stamped
+* as well, so the stamp changes when any of the files is created, removed, or
+* modified. Include it into a key of an entry whose artifacts depend on the
+* files.
+*
+* @param[in] paths Paths to files or directories.
+*/
+std::string ResultCache::getFilesStamp(const std::vector<std::string> &paths) {
+	std::string stamp;
+	for (const auto &path : paths) {
+		appendFileStamp(path, stamp);
+	}
+	return stamp;
+}
+
+/**
+* @brief Returns the path to the directory of the entry with the given key.
+*/
+std::string ResultCache::getEntryPath(const std::string &key) const {
+	return (fs::path(directory) / key).string();
+}
+
+} // namespace utils
+} // namespace retdec
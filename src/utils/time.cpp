@@ -12,6 +12,12 @@
 #include "retdec/utils/os.h"
 #include "retdec/utils/time.h"
 
+#ifdef OS_WINDOWS
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
 namespace retdec {
 namespace utils {
 
@@ -127,5 +133,62 @@ double getElapsedTime() {
 	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
 }
 
+/**
+* @brief Returns the processor time consumed by the calling thread (in
+*        seconds).
+*
+* Unlike @c getElapsedTime(), the result is not affected by other threads of
+* the process. If the time of the thread cannot be obtained, the processor
+* time of the whole process is returned.
+*/
+double getThreadCpuTime() {
+#ifdef OS_WINDOWS
+	FILETIME creation, exit, kernel, user;
+	if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+		auto toTicks = [](const FILETIME &t) {
+			return (static_cast<unsigned long long>(t.dwHighDateTime) << 32)
+				| t.dwLowDateTime;
+		};
+		// The times are in 100-nanosecond units.
+		return static_cast<double>(toTicks(kernel) + toTicks(user)) / 1e7;
+	}
+#else
+	struct timespec ts;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+		return static_cast<double>(ts.tv_sec)
+			+ static_cast<double>(ts.tv_nsec) / 1e9;
+	}
+#endif
+	return getElapsedTime();
+}
+
+/**
+* @brief Returns the processor time consumed by all threads of the process (in
+*        seconds).
+*
+* If the time of the process cannot be obtained, @c getElapsedTime() is
+* returned.
+*/
+double getProcessCpuTime() {
+#ifdef OS_WINDOWS
+	FILETIME creation, exit, kernel, user;
+	if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+		auto toTicks = [](const FILETIME &t) {
+			return (static_cast<unsigned long long>(t.dwHighDateTime) << 32)
+				| t.dwLowDateTime;
+		};
+		// The times are in 100-nanosecond units.
+		return static_cast<double>(toTicks(kernel) + toTicks(user)) / 1e7;
+	}
+#else
+	struct timespec ts;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0) {
+		return static_cast<double>(ts.tv_sec)
+			+ static_cast<double>(ts.tv_nsec) / 1e9;
+	}
+#endif
+	return getElapsedTime();
+}
+
 } // namespace utils
 } // namespace retdec
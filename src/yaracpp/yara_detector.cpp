@@ -4,10 +4,24 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
 #include <yara.h>
 #include <yara/compiler.h>
 #include <yara/types.h>
 
+#include "retdec/utils/crc32.h"
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/os.h"
+#include "retdec/utils/result_cache.h"
 #include "retdec/yaracpp/yara_detector.h"
 
 namespace retdec {
@@ -16,74 +30,541 @@ namespace yaracpp {
 namespace {
 
 /**
- * Interface for YARA scanning interface. Uses template specialization
- * to decide whether to scan file or memory buffer.
+ * Scan memory buffer by @a rules.
+ */
+bool scan(
+		YR_RULES* rules,
+		YR_CALLBACK_FUNC callback,
+		YaraDetector::CallbackSettings& settings,
+		const std::uint8_t* data,
+		std::size_t size)
+{
+	return yr_rules_scan_mem(
+			rules,
+			const_cast<uint8_t*>(data),
+			size,
+			0,
+			callback,
+			&settings, 0
+	) == ERROR_SUCCESS;
+}
+
+/**
+ * Mutex serializing (de)initialization and configuration of YARA.
+ * @c yr_initialize() and @c yr_finalize() maintain a reference count that is
+ * not thread-safe, so detectors created in different threads (e.g. by the
+ * batch mode of fileinfo) would corrupt it without the mutex.
+ */
+std::mutex& yaraInitMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+/**
+ * Thread-safe @c yr_initialize()
  */
-template <typename T>
-struct Scanner {};
+int initializeYara()
+{
+	std::lock_guard<std::mutex> lock(yaraInitMutex());
+	return yr_initialize();
+}
 
 /**
- * Specialization for scanning files.
+ * Thread-safe @c yr_finalize()
  */
-template <>
-struct Scanner<std::string>
+void finalizeYara()
 {
-	static bool scan(
-			YR_RULES* rules,
-			YR_CALLBACK_FUNC callback,
-			YaraDetector::CallbackSettings& settings,
-			const std::string& pathToFile)
+	std::lock_guard<std::mutex> lock(yaraInitMutex());
+	yr_finalize();
+}
+
+/**
+ * Add the text rule @a file into @a compiler.
+ * @return @c true if the file was compiled without errors.
+ */
+bool addFileToCompiler(
+		YR_COMPILER* compiler,
+		const std::pair<std::string, std::string>& file)
+{
+	auto handle = fopen(file.first.c_str(), "r");
+	if (!handle)
+		return false;
+
+	const char* ns = file.second.empty() ? nullptr : file.second.c_str();
+	bool ok = yr_compiler_add_file(
+			compiler,
+			handle,
+			ns,
+			file.first.c_str()
+	) == 0;
+	fclose(handle);
+	return ok;
+}
+
+/**
+ * Process-wide cache of rules loaded from rule files. Rule files are loaded
+ * or compiled only once (and again only if they are modified), detectors
+ * share the loaded rules.
+ *
+ * Rules compiled from text files are also saved into the cache directory, so
+ * that other processes load them instead of compiling them. The saved files
+ * are named by a hash of the paths, namespaces, sizes and modification times
+ * of the text files, and they have other suffixes than rule files, so they
+ * are never taken for rule sets:
+ * - @c <key>.rules contains rules compiled from the whole list of files.
+ * - @c <key>.valid marks every beginning of such a list as compilable, so
+ *   that detectors adding the files one by one do not have to compile them
+ *   to check them.
+ * - @c <key>.invalid marks a list which can not be compiled, so that a broken
+ *   set of files is not compiled again.
+ */
+class RulesCache
+{
+	public:
+		/// Text rule file and the namespace its rules are compiled into.
+		using TextRuleFile = std::pair<std::string, std::string>;
+
+		/// What is known about compilation of a list of text rule files.
+		enum class State
+		{
+			UNKNOWN,
+			VALID,
+			INVALID
+		};
+
+		static RulesCache& instance()
+		{
+			static RulesCache cache;
+			return cache;
+		}
+
+		void setDirectory(const std::string& dir);
+
+		std::shared_ptr<YR_RULES> getPrecompiledRules(
+				const std::string& pathToFile,
+				bool& precompiled);
+		State getTextRulesState(const std::vector<TextRuleFile>& files);
+		std::shared_ptr<YR_RULES> getTextRules(
+				const std::vector<TextRuleFile>& files);
+		std::shared_ptr<YR_RULES> addTextRules(
+				const std::vector<TextRuleFile>& files,
+				YR_RULES* rules);
+		void addTextRulesFailure(const std::vector<TextRuleFile>& files);
+
+	private:
+		struct Entry
+		{
+			/// Modification times of all the files the rules come from.
+			std::vector<fs::file_time_type> modified;
+			/// Can the files be compiled?
+			bool valid = false;
+			/// Compiled rules, @c nullptr if they have not been loaded.
+			std::shared_ptr<YR_RULES> rules;
+		};
+
+		RulesCache() : directory(getDefaultDirectory())
+		{
+			// Keep YARA initialized while the cached rules exist.
+			initializeYara();
+		}
+		~RulesCache()
+		{
+			precompiledEntries.clear();
+			textEntries.clear();
+			finalizeYara();
+		}
+
+		static std::string getDefaultDirectory();
+		static bool getModificationTimes(
+				const std::vector<TextRuleFile>& files,
+				std::vector<fs::file_time_type>& modified);
+		static std::shared_ptr<YR_RULES> makeShared(YR_RULES* rules);
+		static std::shared_ptr<YR_RULES> load(const std::string& path);
+		static YR_RULES* compile(const std::vector<TextRuleFile>& files);
+
+		std::string getCachePath(
+				const std::vector<TextRuleFile>& files,
+				const std::string& suffix);
+		Entry* findTextEntry(
+				const std::vector<TextRuleFile>& files,
+				const std::vector<fs::file_time_type>& modified);
+		void save(const std::vector<TextRuleFile>& files, YR_RULES* rules);
+
+		std::mutex mutex;
+		/// Directory the compiled rules are saved into, empty if they are not.
+		std::string directory;
+		/// Rule file -> precompiled rules, or @c nullptr if it is a text file.
+		std::map<std::string, Entry> precompiledEntries;
+		/// Text rule files -> rules compiled from all of them together.
+		std::map<std::vector<TextRuleFile>, Entry> textEntries;
+};
+
+/**
+ * Get the per-user cache directory, or an empty string if it is not known.
+ */
+std::string RulesCache::getDefaultDirectory()
+{
+#ifdef OS_WINDOWS
+	if (auto* localAppData = std::getenv("LOCALAPPDATA"))
+		return (fs::path(localAppData) / "retdec" / "yara-rules").string();
+#else
+	if (auto* cacheHome = std::getenv("XDG_CACHE_HOME"))
+		return (fs::path(cacheHome) / "retdec" / "yara-rules").string();
+	if (auto* home = std::getenv("HOME"))
+		return (fs::path(home) / ".cache" / "retdec" / "yara-rules").string();
+#endif
+	return std::string();
+}
+
+/**
+ * Get modification times of all the @a files.
+ * @return @c false if the time of any of them can not be obtained.
+ */
+bool RulesCache::getModificationTimes(
+		const std::vector<TextRuleFile>& files,
+		std::vector<fs::file_time_type>& modified)
+{
+	modified.clear();
+	for (const auto& f : files)
 	{
-		return yr_rules_scan_file(
-				rules,
-				pathToFile.c_str(),
-				0,
-				callback,
-				&settings, 0
-		) == ERROR_SUCCESS;
+		std::error_code ec;
+		modified.push_back(fs::last_write_time(f.first, ec));
+		if (ec)
+			return false;
 	}
-};
+	return true;
+}
+
+std::shared_ptr<YR_RULES> RulesCache::makeShared(YR_RULES* rules)
+{
+	return std::shared_ptr<YR_RULES>(rules, yr_rules_destroy);
+}
+
+std::shared_ptr<YR_RULES> RulesCache::load(const std::string& path)
+{
+	YR_RULES* rules = nullptr;
+	if (yr_rules_load(path.c_str(), &rules) != ERROR_SUCCESS)
+		return nullptr;
+
+	return makeShared(rules);
+}
 
 /**
- * Specialization for scanning memory buffers.
+ * Compile all the text rule @a files by a single compiler, in the given order,
+ * so that rules can refer to rules from the previous files.
+ * @return Rules or @c nullptr if the files can not be compiled.
  */
-template <>
-struct Scanner<std::vector<std::uint8_t>>
+YR_RULES* RulesCache::compile(const std::vector<TextRuleFile>& files)
 {
-	static bool scan(
-			YR_RULES* rules,
-			YR_CALLBACK_FUNC callback,
-			YaraDetector::CallbackSettings& settings,
-			const std::vector<std::uint8_t>& buffer)
+	YR_COMPILER* compiler = nullptr;
+	if (yr_compiler_create(&compiler) != ERROR_SUCCESS)
+		return nullptr;
+
+	bool ok = true;
+	for (const auto& f : files)
 	{
-		return yr_rules_scan_mem(
-				rules,
-				const_cast<uint8_t*>(buffer.data()),
-				buffer.size(),
-				0,
-				callback,
-				&settings, 0
-		) == ERROR_SUCCESS;
+		ok = addFileToCompiler(compiler, f);
+		if (!ok)
+			break;
 	}
-};
+
+	YR_RULES* rules = nullptr;
+	if (ok && yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+		rules = nullptr;
+
+	yr_compiler_destroy(compiler);
+	return rules;
+}
 
 /**
- * Interface for Scanner. Provides template type deduction and
- * always passes correct type into Scanner template.
+ * Set the directory compiled rules are saved into and loaded from. If it is
+ * empty, compiled rules are kept only in memory.
  */
-template <typename T>
-bool scan(
-		YR_RULES* rules,
-		YR_CALLBACK_FUNC callback,
-		YaraDetector::CallbackSettings& settings,
-		T&& value)
+void RulesCache::setDirectory(const std::string& dir)
 {
-	return Scanner<std::decay_t<T>>::scan(
-			rules,
-			callback,
-			settings,
-			std::forward<T>(value)
-	);
+	std::lock_guard<std::mutex> lock(mutex);
+	directory = dir;
+}
+
+/**
+ * Get path of the file with suffix @a suffix in the cache directory that
+ * belongs to text rule @a files, or an empty string if there is no cache
+ * directory.
+ */
+std::string RulesCache::getCachePath(
+		const std::vector<TextRuleFile>& files,
+		const std::string& suffix)
+{
+	std::string dir;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		dir = directory;
+	}
+	if (dir.empty())
+		return std::string();
+
+	// Compiled rules can be loaded only by the same version of YARA.
+	std::string key = YR_VERSION "\n";
+	for (const auto& f : files)
+	{
+		std::error_code ec;
+		auto path = fs::absolute(f.first, ec);
+		key += (ec ? f.first : path.string()) + "\t" + f.second + "\n";
+	}
+	for (const auto& f : files)
+	{
+		key += utils::ResultCache::getFilesStamp({f.first});
+	}
+
+	std::ostringstream name;
+	name << std::hex << std::setfill('0') << std::setw(16)
+			<< std::hash<std::string>()(key)
+			<< utils::CRC32()(key)
+			<< suffix;
+	return (fs::path(dir) / name.str()).string();
+}
+
+/**
+ * Find the entry of text rule @a files which have not been modified since
+ * the entry was created. The mutex has to be locked.
+ */
+RulesCache::Entry* RulesCache::findTextEntry(
+		const std::vector<TextRuleFile>& files,
+		const std::vector<fs::file_time_type>& modified)
+{
+	auto it = textEntries.find(files);
+	return it != textEntries.end() && it->second.modified == modified
+			? &it->second
+			: nullptr;
+}
+
+/**
+ * Save @a rules compiled from text rule @a files into the cache directory,
+ * and mark all the beginnings of @a files as compilable. The rules are written
+ * into a temporary file first, so that other processes never see a partially
+ * written file. Failures are ignored, the cache on disk is only an
+ * optimization.
+ */
+void RulesCache::save(
+		const std::vector<TextRuleFile>& files,
+		YR_RULES* rules)
+{
+	auto path = getCachePath(files, ".rules");
+	if (path.empty())
+		return;
+
+	std::error_code ec;
+	fs::create_directories(fs::path(path).parent_path(), ec);
+	auto tmpPath = path + "." + std::to_string(std::random_device()()) + ".tmp";
+	if (yr_rules_save(rules, tmpPath.c_str()) == ERROR_SUCCESS)
+	{
+		fs::rename(tmpPath, path, ec);
+	}
+	if (ec || fs::exists(tmpPath, ec))
+	{
+		fs::remove(tmpPath, ec);
+	}
+
+	std::vector<TextRuleFile> prefix;
+	for (std::size_t i = 0; i + 1 < files.size(); ++i)
+	{
+		prefix.push_back(files[i]);
+		std::ofstream{getCachePath(prefix, ".valid")};
+	}
+}
+
+/**
+ * Get rules from precompiled rule file @a pathToFile.
+ * @param pathToFile Path to rule file.
+ * @param[out] precompiled Set to @c true if the file is precompiled.
+ * @return Rules, or @c nullptr if the file can not be read or it is not
+ *         precompiled.
+ */
+std::shared_ptr<YR_RULES> RulesCache::getPrecompiledRules(
+		const std::string& pathToFile,
+		bool& precompiled)
+{
+	precompiled = false;
+
+	std::error_code ec;
+	auto modified = fs::last_write_time(pathToFile, ec);
+	if (ec)
+		return nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = precompiledEntries.find(pathToFile);
+		if (it != precompiledEntries.end()
+				&& it->second.modified.front() == modified)
+		{
+			precompiled = it->second.rules != nullptr;
+			return it->second.rules;
+		}
+	}
+
+	Entry entry;
+	entry.modified.push_back(modified);
+	entry.rules = load(pathToFile);
+	entry.valid = entry.rules != nullptr;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	precompiled = entry.rules != nullptr;
+	auto rules = entry.rules;
+	precompiledEntries[pathToFile] = std::move(entry);
+	return rules;
+}
+
+/**
+ * Find out whether text rule @a files can be compiled together, without
+ * compiling them.
+ */
+RulesCache::State RulesCache::getTextRulesState(
+		const std::vector<TextRuleFile>& files)
+{
+	std::vector<fs::file_time_type> modified;
+	if (!getModificationTimes(files, modified))
+		return State::INVALID;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto* entry = findTextEntry(files, modified))
+			return entry->valid ? State::VALID : State::INVALID;
+	}
+
+	std::error_code ec;
+	auto rulesPath = getCachePath(files, ".rules");
+	if (rulesPath.empty())
+		return State::UNKNOWN;
+
+	bool valid = fs::exists(rulesPath, ec)
+			|| fs::exists(getCachePath(files, ".valid"), ec);
+	if (!valid && !fs::exists(getCachePath(files, ".invalid"), ec))
+		return State::UNKNOWN;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& entry = textEntries[files];
+	if (entry.modified != modified)
+	{
+		entry = Entry();
+		entry.modified = std::move(modified);
+		entry.valid = valid;
+	}
+	return entry.valid ? State::VALID : State::INVALID;
+}
+
+/**
+ * Get rules compiled from all the text rule @a files together. They are taken
+ * from memory, loaded from the cache directory, or compiled, in this order.
+ * @return Rules or @c nullptr if the files can not be compiled.
+ */
+std::shared_ptr<YR_RULES> RulesCache::getTextRules(
+		const std::vector<TextRuleFile>& files)
+{
+	std::vector<fs::file_time_type> modified;
+	if (!getModificationTimes(files, modified))
+		return nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto* entry = findTextEntry(files, modified))
+		{
+			if (!entry->valid || entry->rules)
+				return entry->rules;
+		}
+	}
+
+	auto rulesPath = getCachePath(files, ".rules");
+	if (!rulesPath.empty())
+	{
+		if (auto rules = load(rulesPath))
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto& entry = textEntries[files];
+			entry.modified = std::move(modified);
+			entry.valid = true;
+			entry.rules = std::move(rules);
+			return entry.rules;
+		}
+	}
+
+	auto* rules = compile(files);
+	if (!rules)
+	{
+		addTextRulesFailure(files);
+		return nullptr;
+	}
+	return addTextRules(files, rules);
+}
+
+/**
+ * Add @a rules compiled from all the text rule @a files together into the
+ * cache, which takes the ownership of them.
+ * @return Cached rules, which may be other than @a rules if the same files
+ *         have been compiled concurrently.
+ */
+std::shared_ptr<YR_RULES> RulesCache::addTextRules(
+		const std::vector<TextRuleFile>& files,
+		YR_RULES* rules)
+{
+	auto shared = makeShared(rules);
+	std::vector<fs::file_time_type> modified;
+	if (!getModificationTimes(files, modified))
+		return shared;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto* entry = findTextEntry(files, modified))
+		{
+			if (entry->rules)
+				return entry->rules;
+		}
+
+		// All the beginnings of the files can be compiled as well.
+		std::vector<TextRuleFile> prefix;
+		for (std::size_t i = 0; i < files.size(); ++i)
+		{
+			prefix.push_back(files[i]);
+			std::vector<fs::file_time_type> prefixModified(
+					modified.begin(),
+					modified.begin() + i + 1
+			);
+			auto& entry = textEntries[prefix];
+			if (entry.modified != prefixModified)
+			{
+				entry = Entry();
+				entry.modified = std::move(prefixModified);
+			}
+			entry.valid = true;
+		}
+		textEntries[files].rules = shared;
+	}
+
+	save(files, rules);
+	return shared;
+}
+
+/**
+ * Remember that text rule @a files can not be compiled together.
+ */
+void RulesCache::addTextRulesFailure(const std::vector<TextRuleFile>& files)
+{
+	Entry entry;
+	if (!getModificationTimes(files, entry.modified))
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		textEntries[files] = std::move(entry);
+	}
+
+	auto path = getCachePath(files, ".invalid");
+	if (!path.empty())
+	{
+		std::error_code ec;
+		fs::create_directories(fs::path(path).parent_path(), ec);
+		std::ofstream{path};
+	}
 }
 
 } // anonymous namespace
@@ -93,9 +574,10 @@ bool scan(
  */
 YaraDetector::YaraDetector()
 {
-	stateIsValid = ((yr_initialize() == ERROR_SUCCESS)
+	stateIsValid = ((initializeYara() == ERROR_SUCCESS)
 			&& (yr_compiler_create(&compiler) == ERROR_SUCCESS));
 	std::uint32_t max_match_data = 65536;
+	std::lock_guard<std::mutex> lock(yaraInitMutex());
 	yr_set_configuration(YR_CONFIG_MAX_MATCH_DATA, &max_match_data);
 }
 
@@ -104,13 +586,6 @@ YaraDetector::YaraDetector()
  */
 YaraDetector::~YaraDetector()
 {
-	for (auto* file : files)
-	{
-		if (file)
-			fclose(file);
-	}
-
-	files.clear();
 	detectedRules.clear();
 	undetectedRules.clear();
 
@@ -119,16 +594,15 @@ YaraDetector::~YaraDetector()
 		yr_compiler_destroy(compiler);
 	}
 
-	if (textFilesRules)
-		yr_rules_destroy(textFilesRules);
+	destroyFilesCompiler();
 
-	for (auto* rules : precompiledRules)
-	{
-		if (rules)
-			yr_rules_destroy(rules);
-	}
+	if (textRules)
+		yr_rules_destroy(textRules);
 
-	yr_finalize();
+	textFilesRules.reset();
+	precompiledRules.clear();
+
+	finalizeYara();
 }
 
 /**
@@ -176,6 +650,42 @@ bool YaraDetector::CallbackSettings::storeAllRules() const
 	return storeAll;
 }
 
+/**
+ * Set rule file the scanned rules come from
+ * @param pathToFile Path to rule file
+ */
+void YaraDetector::CallbackSettings::setRuleFile(const std::string &pathToFile)
+{
+	ruleFile = pathToFile;
+	namespaceFiles = nullptr;
+}
+
+/**
+ * Set rule files the scanned rules come from, if they come from more files
+ * @param files Mapping of namespaces to rule files
+ */
+void YaraDetector::CallbackSettings::setNamespaceFiles(
+		const std::map<std::string, std::string> *files)
+{
+	ruleFile.clear();
+	namespaceFiles = files;
+}
+
+/**
+ * Get rule file a scanned rule comes from
+ * @param nameSpace Namespace of the rule
+ * @return Path to rule file or empty string if it is not known
+ */
+std::string YaraDetector::CallbackSettings::getRuleFile(
+		const std::string &nameSpace) const
+{
+	if (!namespaceFiles)
+		return ruleFile;
+
+	auto it = namespaceFiles->find(nameSpace);
+	return it != namespaceFiles->end() ? it->second : std::string();
+}
+
 /**
  * Callback function for scanning of input file
  * @param context YARA context
@@ -226,6 +736,7 @@ int YaraDetector::yaraCallback(
 
 	YaraRule actual;
 	actual.setName(actRule->identifier);
+	actual.setRuleFile(settings->getRuleFile(actRule->ns->name));
 	YR_META *meta;
 	yr_rule_metas_foreach(actRule, meta)
 	{
@@ -284,9 +795,11 @@ int YaraDetector::yaraCallback(
 bool YaraDetector::addRules(const char *string)
 {
 	const auto result = yr_compiler_add_string(compiler, string, nullptr);
+	if (result != 0)
+		return false;
 
-	needsRecompilation = (result == 0);
-	return needsRecompilation;
+	needsRecompilation = true;
+	return true;
 }
 
 /**
@@ -296,38 +809,71 @@ bool YaraDetector::addRules(const char *string)
  *                  already compiled, this has no effect. If it is a text file,
  *                  this allows to have multiple rules with the same ID across
  *                  multiple rule files.
+ * @return @c true if the file was added, @c false if it can not be read or
+ *         its rules can not be compiled
+ *
+ * Text files are compiled together with the text files added before. If they
+ * are known to be compilable from an earlier compilation (in this or in
+ * another process), they are not compiled again.
  */
 bool YaraDetector::addRuleFile(
 		const std::string &pathToFile,
 		const std::string &nameSpace)
 {
-	// AT first, try to load the files as precompiled file
-	YR_RULES* rules = nullptr;
-	if (yr_rules_load(pathToFile.c_str(), &rules) == ERROR_SUCCESS)
+	// Precompiled files are loaded only once per process
+	bool precompiled = false;
+	auto rules = RulesCache::instance().getPrecompiledRules(
+			pathToFile,
+			precompiled
+	);
+	if (precompiled)
 	{
-		precompiledRules.push_back(rules);
+		precompiledRules.emplace_back(pathToFile, std::move(rules));
+		return true;
 	}
-	// If we didn't succeeded consider it as text file
-	else
-	{
-		auto file = fopen(pathToFile.c_str(), "r");
-		if (!file)
-			return false;
 
-		const char* ns = nameSpace.empty() ? nullptr : nameSpace.c_str();
-		if (yr_compiler_add_file(compiler, file, ns, nullptr) != 0)
-		{
-			fclose(file);
-			return false;
-		}
+	std::error_code ec;
+	if (!fs::is_regular_file(pathToFile, ec))
+		return false;
 
-		files.push_back(file);
-		needsRecompilation = true;
+	auto files = textFiles;
+	files.emplace_back(pathToFile, nameSpace);
+
+	auto& cache = RulesCache::instance();
+	auto state = cache.getTextRulesState(files);
+	if (state == RulesCache::State::UNKNOWN)
+	{
+		state = addToFilesCompiler(files)
+				? RulesCache::State::VALID
+				: RulesCache::State::INVALID;
+		if (state == RulesCache::State::INVALID)
+			cache.addTextRulesFailure(files);
 	}
+	if (state != RulesCache::State::VALID)
+		return false;
+
+	textFiles = std::move(files);
+	textFilesRules.reset();
 
+	const auto& ns = nameSpace.empty() ? std::string("default") : nameSpace;
+	auto inserted = textFilesNamespaces.emplace(ns, pathToFile);
+	if (!inserted.second)
+		inserted.first->second.clear();
 	return true;
 }
 
+/**
+ * Set the directory rules compiled from text rule files are saved into, so
+ * that other processes do not have to compile them again. The directory is
+ * shared by all detectors in the process. By default, it is the per-user
+ * cache directory (e.g. @c ~/.cache/retdec/yara-rules). If @a dir is empty,
+ * compiled rules are not saved.
+ */
+void YaraDetector::setRulesCacheDirectory(const std::string &dir)
+{
+	RulesCache::instance().setDirectory(dir);
+}
+
 /**
  * Getter for state of instance
  * @return @c true if all is OK, @c false otherwise
@@ -348,7 +894,14 @@ bool YaraDetector::analyze(
 		const std::string &pathToInputFile,
 		bool storeAllRules)
 {
-	return analyzeWithScan(pathToInputFile, storeAllRules);
+	// The file is read only once for all the rule sets
+	YR_MAPPED_FILE file;
+	if (yr_filemap_map(pathToInputFile.c_str(), &file) != ERROR_SUCCESS)
+		return false;
+
+	auto result = analyzeData(file.data, file.size, storeAllRules);
+	yr_filemap_unmap(&file);
+	return result;
 }
 
 /**
@@ -358,9 +911,9 @@ bool YaraDetector::analyze(
  *                      store all rules (not only detected)
  * @return @c true if analysis completed without any error, otherwise @c false.
  */
-bool YaraDetector::analyze(std::vector<std::uint8_t> &bytes, bool storeAllRules)
+bool YaraDetector::analyze(const std::vector<std::uint8_t> &bytes, bool storeAllRules)
 {
-	return analyzeWithScan(bytes, storeAllRules);
+	return analyzeData(bytes.data(), bytes.size(), storeAllRules);
 }
 
 /**
@@ -382,14 +935,23 @@ const std::vector<YaraRule>& YaraDetector::getUndetectedRules() const
 }
 
 /**
- * Analyze input sequence
- * @param value Value to analyze
+ * Analyze input bytes by all the rule sets
+ * @param data Input bytes
+ * @param size Number of input bytes
  * @param storeAllRules If this parameter is set to @c true,
  *                      store all rules (not only detected)
  * @return @c true if analysis completed without any error, otherwise @c false.
+ *
+ * All the text files are compiled into a single rule set, so their rules are
+ * evaluated by a single scan. Rules from text strings and from every
+ * precompiled file are separate rule sets, because YARA can neither merge
+ * compiled rule sets nor scan by more of them at once, so each of them is
+ * scanned over the same input bytes.
  */
-template <typename T>
-bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
+bool YaraDetector::analyzeData(
+		const std::uint8_t *data,
+		std::size_t size,
+		bool storeAllRules)
 {
 	auto settings = CallbackSettings(
 			storeAllRules,
@@ -397,16 +959,39 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 			undetectedRules
 	);
 
-	auto rules = getCompiledRules();
-	if (!(rules))
+	if (needsRecompilation && !getCompiledRules())
+		return false;
+
+	if (textRules && !scan(textRules, yaraCallback, settings, data, size))
 		return false;
 
-	if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+	if (!textFiles.empty() && !textFilesRules)
+	{
+		// Rule files are compiled only once per process, use the compiler
+		// the files have been checked by if it contains all of them
+		auto& cache = RulesCache::instance();
+		if (filesCompiler && compiledTextFiles == textFiles.size())
+		{
+			YR_RULES* rules = nullptr;
+			if (yr_compiler_get_rules(filesCompiler, &rules) == ERROR_SUCCESS)
+				textFilesRules = cache.addTextRules(textFiles, rules);
+			destroyFilesCompiler();
+		}
+		if (!textFilesRules)
+			textFilesRules = cache.getTextRules(textFiles);
+		if (!textFilesRules)
+			return false;
+	}
+
+	settings.setNamespaceFiles(&textFilesNamespaces);
+	if (textFilesRules
+			&& !scan(textFilesRules.get(), yaraCallback, settings, data, size))
 		return false;
 
-	for (auto* rules : precompiledRules)
+	for (const auto& rules : precompiledRules)
 	{
-		if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+		settings.setRuleFile(rules.first);
+		if (!scan(rules.second.get(), yaraCallback, settings, data, size))
 			return false;
 	}
 
@@ -414,15 +999,14 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 }
 
 /**
- * Returns the compiled rules from text files.
+ * Returns the compiled rules from text strings.
  * @return Compiled rules.
  */
 YR_RULES* YaraDetector::getCompiledRules()
 {
-	// File is text file and needs to be compiled first
-	// All text files are compiled into single YR_RULES structure and
+	// All text strings are compiled into single YR_RULES structure and
 	// we shouldn't compile it twice if it's not needed
-	// analyze() called for the first time or the file was added since the
+	// analyze() called for the first time or the string was added since the
 	// last analyze() call
 	if (needsRecompilation)
 	{
@@ -430,14 +1014,57 @@ YR_RULES* YaraDetector::getCompiledRules()
 		if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
 			return nullptr;
 
-		if (textFilesRules)
-			yr_rules_destroy(textFilesRules);
+		if (textRules)
+			yr_rules_destroy(textRules);
 
-		textFilesRules = rules;
+		textRules = rules;
 		needsRecompilation = false;
 	}
 
-	return textFilesRules;
+	return textRules;
+}
+
+/**
+ * Add text rule @a files into the compiler of text files. The files have to
+ * start with the files already added into it.
+ * @return @c true if all the files were compiled without errors.
+ */
+bool YaraDetector::addToFilesCompiler(
+		const std::vector<std::pair<std::string, std::string>>& files)
+{
+	if (!filesCompiler)
+	{
+		if (yr_compiler_create(&filesCompiler) != ERROR_SUCCESS)
+		{
+			filesCompiler = nullptr;
+			return false;
+		}
+		compiledTextFiles = 0;
+	}
+
+	for (; compiledTextFiles < files.size(); ++compiledTextFiles)
+	{
+		if (!addFileToCompiler(filesCompiler, files[compiledTextFiles]))
+		{
+			// The compiler can not be used after an error
+			destroyFilesCompiler();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Destroy the compiler of text files.
+ */
+void YaraDetector::destroyFilesCompiler()
+{
+	if (filesCompiler)
+		yr_compiler_destroy(filesCompiler);
+
+	filesCompiler = nullptr;
+	compiledTextFiles = 0;
 }
 
 } // namespace yaracpp
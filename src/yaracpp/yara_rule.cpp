@@ -20,6 +20,16 @@ const std::string &YaraRule::getName() const
 	return name;
 }
 
+/**
+ * Get path to the rule file this rule comes from
+ * @return Path to rule file or empty string if it is not known (e.g. the rule
+ *    comes from a text string)
+ */
+const std::string &YaraRule::getRuleFile() const
+{
+	return ruleFile;
+}
+
 /**
  * Get selected meta related to this rule
  * @param id Name of selected meta
@@ -135,6 +145,15 @@ void YaraRule::setName(const std::string &ruleName)
 	name = ruleName;
 }
 
+/**
+ * Set path to the rule file this rule comes from
+ * @param pathToFile Path to rule file
+ */
+void YaraRule::setRuleFile(const std::string &pathToFile)
+{
+	ruleFile = pathToFile;
+}
+
 /**
  * Add meta
  * @param meta Meta related to this rule
@@ -44,6 +44,53 @@ DummyTest)
 	EXPECT_EQ( nullptr, module->getGlobalVariable("glob1") );
 }
 
+TEST_F(ReachingDefinitionsTests,
+DefinitionsArePropagatedThroughLoopsButNotFromUnreachableBlocks)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1(i1 %c) {
+		entry:
+			store i32 1, i32* @glob0
+			br label %loop
+		loop:
+			%x = load i32, i32* @glob0
+			store i32 2, i32* @glob0
+			br i1 %c, label %loop, label %exit
+		dead:
+			store i32 3, i32* @glob0
+			br label %exit
+		exit:
+			%y = load i32, i32* @glob0
+			ret void
+		}
+	)");
+	auto* s1 = getNthInstruction<StoreInst>(0);
+	auto* s2 = getNthInstruction<StoreInst>(1);
+	auto* s3 = getNthInstruction<StoreInst>(2);
+	auto* x = getInstructionByName("x");
+	auto* y = getInstructionByName("y");
+
+	RDA.runOnModule(*module);
+
+	std::set<Instruction*> xDefs;
+	for (auto* d : RDA.defsFromUse(x))
+	{
+		xDefs.insert(d->def);
+	}
+	std::set<Instruction*> yDefs;
+	for (auto* d : RDA.defsFromUse(y))
+	{
+		yDefs.insert(d->def);
+	}
+	std::set<Instruction*> xExp = {s1, s2};
+	std::set<Instruction*> yExp = {s2};
+	EXPECT_EQ(xExp, xDefs);
+	EXPECT_EQ(yExp, yDefs);
+	EXPECT_EQ(2, RDA.usesFromDef(s2).size());
+	EXPECT_TRUE(RDA.usesFromDef(s3).empty());
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -0,0 +1,349 @@
+/**
+* @file tests/bin2llvmir/optimizations/decoder/instruction_cache_tests.cpp
+* @brief Tests for the @c InstructionCache.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "retdec/bin2llvmir/optimizations/decoder/instruction_cache.h"
+#include "retdec/utils/memory.h"
+#include "bin2llvmir/utils/llvmir_tests.h"
+
+using namespace ::testing;
+using namespace llvm;
+using namespace retdec::common;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c InstructionCache.
+ *
+ * The code is random, so there are many invalid instructions and the linear
+ * sweep is often misaligned with the instructions decoding would hit.
+ */
+class InstructionCacheTests: public LlvmIrTests
+{
+	protected:
+		/// Several chunks, the last one is not full.
+		static const std::size_t codeSize =
+				3 * InstructionCache::chunkSize + 123;
+
+		InstructionCacheTests() :
+				code(codeSize),
+				format(createFormat()),
+				config(Config::empty(module.get()))
+		{
+			std::mt19937 generator(7);
+			for (auto& b : code)
+			{
+				b = generator();
+			}
+			// Make the linear sweep hit "mov eax, imm32" crossing every chunk
+			// boundary: nops synchronize the sweep before it.
+			for (auto b = InstructionCache::chunkSize; b < codeSize;
+					b += InstructionCache::chunkSize)
+			{
+				std::fill(&code[b - 64], &code[b - 3], 0x90);
+				code[b - 3] = 0xB8;
+			}
+
+			auto data = std::make_unique<std::array<std::uint8_t, codeSize>>();
+			std::copy(code.begin(), code.end(), data->begin());
+			start = format->appendData(*data);
+			image = std::make_unique<FileImage>(module.get(), format, &config);
+
+			cs_open(CS_ARCH_X86, CS_MODE_32, &ce);
+			cs_option(ce, CS_OPT_DETAIL, CS_OPT_ON);
+			insn = cs_malloc(ce);
+		}
+
+		~InstructionCacheTests() override
+		{
+			cs_free(insn, 1);
+			cs_close(&ce);
+		}
+
+		void build(Address s, Address e, std::size_t threads = 4)
+		{
+			RangesToDecode ranges;
+			ranges.addPrimary(s, e);
+			cache.build(
+					CS_ARCH_X86,
+					CS_MODE_32,
+					CS_MODE_LITTLE_ENDIAN,
+					image.get(),
+					ranges,
+					threads);
+		}
+
+		/**
+		 * Disassemble the instruction on address @a a by Capstone.
+		 * @return The instruction or @c nullptr if there is no valid
+		 * instruction which is at most @a maxSize bytes long.
+		 */
+		const cs_insn* disassemble(Address a, std::size_t maxSize)
+		{
+			const uint8_t* bytes = code.data() + (a - start);
+			uint64_t addr = a;
+			return cs_disasm_iter(ce, &bytes, &maxSize, &addr, insn)
+					? insn
+					: nullptr;
+		}
+
+		static void expectSameInstructions(
+				const cs_insn* expected,
+				const cs_insn* actual)
+		{
+			ASSERT_NE(nullptr, expected);
+			ASSERT_NE(nullptr, actual);
+			EXPECT_EQ(expected->id, actual->id);
+			EXPECT_EQ(expected->address, actual->address);
+			ASSERT_EQ(expected->size, actual->size);
+			EXPECT_EQ(0, std::memcmp(
+					expected->bytes, actual->bytes, expected->size));
+			EXPECT_EQ(
+					std::string(expected->mnemonic),
+					std::string(actual->mnemonic));
+			EXPECT_EQ(
+					std::string(expected->op_str),
+					std::string(actual->op_str));
+			ASSERT_NE(nullptr, actual->detail);
+			EXPECT_EQ(0, std::memcmp(
+					expected->detail, actual->detail, sizeof(cs_detail)));
+		}
+
+		/**
+		 * Check that every instruction in the cache in <@a s, @a e) is equal
+		 * to the one disassembled by Capstone.
+		 * @return Number of the cached instructions.
+		 */
+		std::size_t checkCachedInstructions(Address s, Address e)
+		{
+			std::size_t cached = 0;
+			for (Address a = s; a < e; ++a)
+			{
+				std::size_t maxSize = start + codeSize - a;
+				if (auto* c = cache.get(CS_MODE_32, a, maxSize))
+				{
+					SCOPED_TRACE(a.toHexString());
+					expectSameInstructions(disassemble(a, maxSize), c);
+					++cached;
+				}
+			}
+			return cached;
+		}
+
+	protected:
+		std::vector<std::uint8_t> code;
+		std::shared_ptr<retdec::fileformat::RawDataFormat> format;
+		Config config;
+		std::unique_ptr<FileImage> image;
+		Address start;
+
+		csh ce = 0;
+		cs_insn* insn = nullptr;
+
+		InstructionCache cache;
+};
+
+TEST_F(InstructionCacheTests, cachedInstructionsAreEqualToDisassembledOnes)
+{
+	build(start, start + codeSize);
+
+	ASSERT_LT(0, cache.size());
+	EXPECT_EQ(cache.size(), checkCachedInstructions(start, start + codeSize));
+}
+
+TEST_F(InstructionCacheTests, sameInstructionsAreCachedByAnyNumberOfThreads)
+{
+	build(start, start + codeSize, 1);
+	std::vector<std::pair<uint64_t, uint16_t>> expected;
+	for (Address a = start; a < start + codeSize; ++a)
+	{
+		if (auto* c = cache.get(CS_MODE_32, a, start + codeSize - a))
+		{
+			expected.emplace_back(c->address, c->size);
+		}
+	}
+	ASSERT_FALSE(expected.empty());
+
+	build(start, start + codeSize, 4);
+	std::vector<std::pair<uint64_t, uint16_t>> cached;
+	for (Address a = start; a < start + codeSize; ++a)
+	{
+		if (auto* c = cache.get(CS_MODE_32, a, start + codeSize - a))
+		{
+			cached.emplace_back(c->address, c->size);
+		}
+	}
+	EXPECT_EQ(expected, cached);
+}
+
+TEST_F(InstructionCacheTests, instructionsAroundChunkBoundariesAreCorrect)
+{
+	build(start, start + codeSize);
+
+	for (std::size_t i = 1; i * InstructionCache::chunkSize < codeSize; ++i)
+	{
+		Address boundary = start + i * InstructionCache::chunkSize;
+		EXPECT_LT(0, checkCachedInstructions(boundary - 32, boundary + 32));
+
+		// The last instruction of a chunk may exceed it.
+		auto* crossing = cache.get(CS_MODE_32, boundary - 3, 5);
+		ASSERT_NE(nullptr, crossing);
+		EXPECT_EQ(5, crossing->size);
+		expectSameInstructions(disassemble(boundary - 3, 5), crossing);
+	}
+}
+
+TEST_F(InstructionCacheTests, misalignedSweepsGiveSameInstructionsAsCapstone)
+{
+	build(start, start + codeSize);
+
+	// Start outside of the instruction boundaries of the linear sweep.
+	for (std::size_t offset : {1, 2, 3, 7})
+	{
+		SCOPED_TRACE(offset);
+
+		const uint8_t* bytes = code.data() + offset;
+		std::size_t size = codeSize - offset;
+		uint64_t addr = start + offset;
+		cs_insn* cachedInsn = cs_malloc(ce);
+		std::size_t hits = 0;
+		while (size > 0)
+		{
+			auto* expected = disassemble(addr, size);
+			bool ok = cache.disasm(
+					ce,
+					CS_MODE_32,
+					&bytes,
+					&size,
+					&addr,
+					cachedInsn);
+			ASSERT_EQ(expected != nullptr, ok);
+			if (!ok)
+			{
+				++bytes;
+				--size;
+				++addr;
+				continue;
+			}
+			expectSameInstructions(expected, cachedInsn);
+			hits += cache.get(CS_MODE_32, expected->address, expected->size)
+					!= nullptr;
+		}
+		cs_free(cachedInsn, 1);
+
+		// Linear sweeps resynchronize quickly, most of the instructions are
+		// taken from the cache.
+		EXPECT_LT(0, hits);
+	}
+}
+
+TEST_F(InstructionCacheTests, instructionsLongerThanMaxSizeAreNotReturned)
+{
+	build(start, start + codeSize);
+
+	std::size_t checked = 0;
+	for (Address a = start; a < start + codeSize && checked < 100; ++a)
+	{
+		auto* c = cache.get(CS_MODE_32, a, start + codeSize - a);
+		if (c == nullptr || c->size < 2)
+		{
+			continue;
+		}
+		SCOPED_TRACE(a.toHexString());
+
+		EXPECT_EQ(c, cache.get(CS_MODE_32, a, c->size));
+		EXPECT_EQ(nullptr, cache.get(CS_MODE_32, a, c->size - 1));
+
+		// Truncated bytes are disassembled by Capstone.
+		std::size_t size = c->size - 1;
+		const uint8_t* bytes = code.data() + (a - start);
+		uint64_t addr = a;
+		cs_insn* truncated = cs_malloc(ce);
+		auto* expected = disassemble(a, size);
+		bool ok = cache.disasm(ce, CS_MODE_32, &bytes, &size, &addr, truncated);
+		EXPECT_EQ(expected != nullptr, ok);
+		if (expected && ok)
+		{
+			expectSameInstructions(expected, truncated);
+		}
+		cs_free(truncated, 1);
+
+		++checked;
+	}
+	EXPECT_EQ(100, checked);
+}
+
+TEST_F(InstructionCacheTests, instructionsAreNotCachedOutsideOfRanges)
+{
+	Address s = start + 1000;
+	Address e = start + 2000;
+	build(s, e);
+
+	ASSERT_LT(0, cache.size());
+	EXPECT_EQ(0, checkCachedInstructions(start, s));
+	EXPECT_EQ(cache.size(), checkCachedInstructions(s, e));
+	EXPECT_EQ(0, checkCachedInstructions(e, start + codeSize));
+}
+
+TEST_F(InstructionCacheTests, instructionsAreNotReturnedForOtherModes)
+{
+	build(start, start + codeSize);
+
+	for (Address a = start; a < start + 100; ++a)
+	{
+		EXPECT_EQ(nullptr, cache.get(CS_MODE_16, a, start + codeSize - a));
+	}
+}
+
+TEST_F(InstructionCacheTests, nothingIsCachedInThumbMode)
+{
+	RangesToDecode ranges;
+	ranges.addPrimary(start, start + codeSize);
+
+	cache.build(
+			CS_ARCH_ARM,
+			CS_MODE_THUMB,
+			CS_MODE_LITTLE_ENDIAN,
+			image.get(),
+			ranges);
+	EXPECT_EQ(0, cache.size());
+	EXPECT_EQ(nullptr, cache.get(CS_MODE_THUMB, start, codeSize));
+
+	cache.build(
+			CS_ARCH_ARM,
+			CS_MODE_ARM,
+			CS_MODE_LITTLE_ENDIAN,
+			image.get(),
+			ranges);
+	EXPECT_LT(0, cache.size());
+}
+
+TEST_F(InstructionCacheTests, maxCacheSizeIsScaledDownBySoftLimit)
+{
+	const std::size_t maxCacheSize = InstructionCache::maxCacheSize;
+	EXPECT_EQ(maxCacheSize, InstructionCache::getMaxCacheSize());
+
+	utils::setMemorySoftLimit(1024 * 1024 * 1024);
+	EXPECT_EQ(256 * 1024 * 1024, InstructionCache::getMaxCacheSize());
+
+	utils::setMemorySoftLimit(16ull * 1024 * 1024 * 1024);
+	EXPECT_EQ(maxCacheSize, InstructionCache::getMaxCacheSize());
+
+	utils::setMemorySoftLimit(0);
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
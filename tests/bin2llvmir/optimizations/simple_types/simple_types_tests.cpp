@@ -0,0 +1,130 @@
+/**
+* @file tests/bin2llvmir/optimizations/simple_types/simple_types_tests.cpp
+* @brief Tests for the @c SimpleTypesAnalysis pass.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <thread>
+
+#include "bin2llvmir/utils/llvmir_tests.h"
+#include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/optimizations/simple_types/simple_types.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c SimpleTypesAnalysis pass.
+ */
+class SimpleTypesAnalysisTests: public LlvmIrTests
+{
+	protected:
+		/**
+		 * One decompilation job -- its own context, module and providers.
+		 */
+		struct Session
+		{
+			llvm::LLVMContext ctx;
+			std::unique_ptr<llvm::Module> module;
+			retdec::config::Config c;
+		};
+
+		void initSession(Session& s)
+		{
+			// The first run of the pass makes string globals known to config
+			// constant, the second run does not.
+			s.module = _parseInput(R"(
+				@str = global [4 x i8] c"abc\00"
+			)", s.ctx);
+			s.c = config::Config::fromJsonString(R"({
+				"architecture" : {
+					"bitSize" : 32,
+					"endian" : "little",
+					"name" : "x86"
+				}
+			})");
+			s.c.globals.insert(retdec::common::Object(
+					"str",
+					retdec::common::Storage::inMemory(0x1000)));
+
+			auto* config = ConfigProvider::addConfig(s.module.get(), s.c);
+			FileImageProvider::addFileImage(
+					s.module.get(),
+					createFormat(),
+					config);
+			AbiProvider::addAbi(s.module.get(), config);
+		}
+
+		bool isStrConstant(Session& s)
+		{
+			return s.module->getGlobalVariable("str")->isConstant();
+		}
+};
+
+TEST_F(SimpleTypesAnalysisTests, runsAlternateIndependentlyInConcurrentSessions)
+{
+	Session s1;
+	Session s2;
+	initSession(s1);
+	initSession(s2);
+
+	std::atomic<unsigned> firstRunsDone(0);
+	auto run = [&firstRunsDone](Session& s, bool& firstRunResult)
+	{
+		SimpleTypesAnalysis pass;
+		pass.runOnModule(*s.module);
+		firstRunResult = s.module->getGlobalVariable("str")->isConstant();
+
+		// Both first runs must be done before any second run.
+		++firstRunsDone;
+		while (firstRunsDone < 2)
+		{
+			std::this_thread::yield();
+		}
+
+		s.module->getGlobalVariable("str")->setConstant(false);
+		pass.runOnModule(*s.module);
+	};
+
+	bool firstRun1 = false;
+	bool firstRun2 = false;
+	std::thread t1(run, std::ref(s1), std::ref(firstRun1));
+	std::thread t2(run, std::ref(s2), std::ref(firstRun2));
+	t1.join();
+	t2.join();
+
+	EXPECT_TRUE(firstRun1);
+	EXPECT_TRUE(firstRun2);
+	EXPECT_FALSE(isStrConstant(s1));
+	EXPECT_FALSE(isStrConstant(s2));
+
+	ProviderInitialization::clearProviders(s1.module.get());
+	ProviderInitialization::clearProviders(s2.module.get());
+}
+
+TEST_F(SimpleTypesAnalysisTests, clearingModuleStartsWithTheFirstRunAgain)
+{
+	Session s;
+	initSession(s);
+	SimpleTypesAnalysis pass;
+
+	pass.runOnModule(*s.module);
+	s.module->getGlobalVariable("str")->setConstant(false);
+	ProviderInitialization::clearProviders(s.module.get());
+	initSession(s);
+	pass.runOnModule(*s.module);
+
+	EXPECT_TRUE(isStrConstant(s));
+
+	ProviderInitialization::clearProviders(s.module.get());
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
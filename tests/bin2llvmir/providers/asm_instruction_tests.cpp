@@ -296,6 +296,30 @@ TEST_F(AsmInstructionTests, AsmInstructionCtorInstructionConstructsValidIfInDiff
 	EXPECT_EQ(ref, a.getLlvmToAsmInstruction());
 }
 
+TEST_F(AsmInstructionTests, AsmInstructionCtorInstructionFollowsMovedInstruction)
+{
+	parseInput(R"(
+		define void @fnc() {
+			store volatile i64 1234, i64* @llvm2asm
+			%a = add i32 1, 2
+			store volatile i64 5678, i64* @llvm2asm
+			%b = mul i32 %a, 3
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	auto* ref1 = getNthInstruction<StoreInst>(0);
+	auto* ref2 = getNthInstruction<StoreInst>(1);
+	auto* b = getNthInstruction<BinaryOperator>(1);
+	ASSERT_EQ(ref2, AsmInstruction(b).getLlvmToAsmInstruction());
+
+	b->moveBefore(ref2);
+
+	EXPECT_EQ(ref1, AsmInstruction(b).getLlvmToAsmInstruction());
+}
+
 //
 // AsmInstruction(llvm::Module*, retdec::common::Address)
 //
@@ -201,6 +201,36 @@ TEST_F(DemanglerProviderTests, clearRemovesAllData)
 	EXPECT_EQ(nullptr, r2);
 }
 
+TEST_F(DemanglerProviderTests, clearModuleRemovesOnlyItsData)
+{
+	auto c = config::Config::fromJsonString(R"({
+		"architecture" : {
+			"bitSize" : 32,
+			"endian" : "little",
+			"name" : "x86"
+		}
+	})");
+	llvm::LLVMContext otherContext;
+	auto otherModule = _parseInput("", otherContext);
+	auto config = Config::fromConfig(module.get(), c);
+	auto otherConfig = Config::fromConfig(otherModule.get(), c);
+	DemanglerProvider::addDemangler(
+		module.get(),
+		&config,
+		std::make_unique<ctypesparser::TypeConfig>());
+	DemanglerProvider::addDemangler(
+		otherModule.get(),
+		&otherConfig,
+		std::make_unique<ctypesparser::TypeConfig>());
+
+	DemanglerProvider::clear(module.get());
+
+	EXPECT_EQ(nullptr, DemanglerProvider::getDemangler(module.get()));
+	EXPECT_NE(nullptr, DemanglerProvider::getDemangler(otherModule.get()));
+
+	DemanglerProvider::clear(otherModule.get());
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
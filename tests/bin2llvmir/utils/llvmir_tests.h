@@ -377,7 +377,7 @@ class LlvmIrTests : public ::testing::Test
 			passManager.doFinalization();
 		}
 
-	private:
+	protected:
 		/**
 		 * Print LLVM diagnostics error.
 		 * @param err LLVM diagnostic error.
@@ -0,0 +1,107 @@
+/**
+ * @file tests/capstone2llvmir/insn_arena_tests.cpp
+ * @brief InsnArena unit tests.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "retdec/capstone2llvmir/insn_arena.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace capstone2llvmir {
+namespace tests {
+
+class InsnArenaTests : public Test
+{
+
+};
+
+TEST_F(InsnArenaTests, AllocatedInstructionsHaveTheirOwnDetails)
+{
+	InsnArena arena(2);
+
+	std::set<cs_insn*> insns;
+	std::set<cs_detail*> details;
+	for (unsigned i = 0; i < 5; ++i)
+	{
+		auto* insn = arena.allocate();
+		insn->id = i;
+		insns.insert(insn);
+		details.insert(insn->detail);
+		EXPECT_NE(nullptr, insn->detail);
+	}
+
+	EXPECT_EQ(5, arena.size());
+	EXPECT_EQ(5, insns.size());
+	EXPECT_EQ(5, details.size());
+	EXPECT_EQ(
+			3 * 2 * (sizeof(cs_insn) + sizeof(cs_detail)),
+			arena.getMemoryUsage());
+}
+
+TEST_F(InsnArenaTests, LastInstructionCanBeDeallocated)
+{
+	InsnArena arena;
+
+	auto* i1 = arena.allocate();
+	arena.deallocateLast();
+	auto* i2 = arena.allocate();
+
+	EXPECT_EQ(i1, i2);
+	EXPECT_EQ(1, arena.size());
+}
+
+TEST_F(InsnArenaTests, InstructionIsCopiedWithDetails)
+{
+	InsnArena arena;
+	cs_detail detail{};
+	detail.groups_count = 3;
+	cs_insn insn{};
+	insn.id = 123;
+	insn.size = 4;
+	insn.detail = &detail;
+
+	auto* copy = arena.allocate(insn);
+
+	EXPECT_EQ(123, copy->id);
+	EXPECT_EQ(4, copy->size);
+	EXPECT_NE(&detail, copy->detail);
+	EXPECT_EQ(3, copy->detail->groups_count);
+}
+
+TEST_F(InsnArenaTests, ReleasedDetailsAreNotKept)
+{
+	InsnArena arena(2);
+	auto* i1 = arena.allocate();
+	auto* i2 = arena.allocate();
+	auto* i3 = arena.allocate();
+
+	arena.releaseDetails();
+
+	EXPECT_EQ(nullptr, i1->detail);
+	EXPECT_EQ(nullptr, i2->detail);
+	EXPECT_EQ(nullptr, i3->detail);
+	EXPECT_EQ(2 * 2 * sizeof(cs_insn), arena.getMemoryUsage());
+	EXPECT_NE(nullptr, arena.allocate()->detail);
+}
+
+TEST_F(InsnArenaTests, ClearFreesEverything)
+{
+	InsnArena arena;
+	arena.allocate();
+	arena.allocate();
+
+	arena.clear();
+
+	EXPECT_EQ(0, arena.size());
+	EXPECT_EQ(0, arena.getMemoryUsage());
+}
+
+} // namespace tests
+} // namespace capstone2llvmir
+} // namespace retdec
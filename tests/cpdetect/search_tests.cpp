@@ -0,0 +1,180 @@
+/**
+* @file tests/cpdetect/search_tests.cpp
+* @brief Tests for the @c search module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/search.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+/**
+ * Tests for search of signatures without slashes.
+ */
+class SearchTests : public Test
+{
+	protected:
+		std::unique_ptr<RawDataFormat> parser;
+		std::unique_ptr<Search> search;
+
+		void load(const std::vector<std::uint8_t> &bytes)
+		{
+			parser = std::make_unique<RawDataFormat>(
+					bytes.data(),
+					bytes.size());
+			search = std::make_unique<Search>(*parser);
+		}
+
+		/**
+		 * Reference implementation comparing the pattern with the nibble
+		 * string of the file on each nibble offset
+		 */
+		bool naiveFind(
+				const std::string &pattern,
+				std::size_t startOffset,
+				std::size_t stopOffset) const
+		{
+			const auto &nibbles = search->getNibbles();
+			const auto stop = std::min(2 * stopOffset + 1, nibbles.length());
+			for (auto i = 2 * startOffset; i + pattern.length() <= stop; ++i)
+			{
+				std::size_t j = 0;
+				while (j < pattern.length()
+						&& (pattern[j] == nibbles[i + j]
+							|| pattern[j] == '-'
+							|| pattern[j] == '?'
+							|| pattern[j] == ';'))
+				{
+					++j;
+				}
+				if (j == pattern.length())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	public:
+		SearchTests()
+		{
+			load({0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0});
+		}
+};
+
+TEST_F(SearchTests, FileIsLoadedAndSupported)
+{
+	EXPECT_TRUE(search->isFileLoaded());
+	EXPECT_TRUE(search->isFileSupported());
+	EXPECT_EQ("123456789ABCDEF0", search->getNibbles());
+}
+
+TEST_F(SearchTests, PatternAtStartOfContentIsFound)
+{
+	EXPECT_EQ(4, search->findUnslashedSignature("1234", 0, 8));
+	EXPECT_EQ(1, search->findUnslashedSignature("1", 0, 8));
+	EXPECT_EQ(16, search->findUnslashedSignature("123456789ABCDEF0", 0, 8));
+}
+
+TEST_F(SearchTests, PatternAtEndOfContentIsFound)
+{
+	EXPECT_EQ(4, search->findUnslashedSignature("DEF0", 0, 8));
+	EXPECT_EQ(3, search->findUnslashedSignature("EF0", 0, 8));
+	EXPECT_EQ(1, search->findUnslashedSignature("0", 7, 8));
+}
+
+TEST_F(SearchTests, PatternStartingOnOddNibbleIsFound)
+{
+	EXPECT_EQ(4, search->findUnslashedSignature("2345", 0, 8));
+	EXPECT_EQ(3, search->findUnslashedSignature("89A", 0, 8));
+	EXPECT_EQ(15, search->findUnslashedSignature("23456789ABCDEF0", 0, 8));
+}
+
+TEST_F(SearchTests, PatternWithOddLengthIsFound)
+{
+	EXPECT_EQ(3, search->findUnslashedSignature("123", 0, 8));
+	EXPECT_EQ(5, search->findUnslashedSignature("9ABCD", 0, 8));
+}
+
+TEST_F(SearchTests, WildcardsMatchAnyNibble)
+{
+	EXPECT_EQ(2, search->findUnslashedSignature("1-3-", 0, 8));
+	EXPECT_EQ(2, search->findUnslashedSignature("5?;8", 0, 8));
+	EXPECT_EQ(3, search->findUnslashedSignature("-BC-E", 0, 8));
+	EXPECT_EQ(2, search->findUnslashedSignature("??????????????F0", 0, 8));
+}
+
+TEST_F(SearchTests, WildcardsDoNotMatchOutsideOfContent)
+{
+	EXPECT_EQ(0, search->findUnslashedSignature("-12", 0, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("F0-", 0, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("1????????????????", 0, 8));
+}
+
+TEST_F(SearchTests, MissingPatternIsNotFound)
+{
+	EXPECT_EQ(0, search->findUnslashedSignature("1235", 0, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("F01", 0, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("12ab", 0, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("", 0, 8));
+}
+
+TEST_F(SearchTests, SearchIsLimitedToSelectedArea)
+{
+	EXPECT_EQ(0, search->findUnslashedSignature("1234", 1, 8));
+	EXPECT_EQ(4, search->findUnslashedSignature("3456", 1, 8));
+	EXPECT_EQ(0, search->findUnslashedSignature("DEF0", 0, 5));
+	EXPECT_EQ(4, search->findUnslashedSignature("DEF0", 6, 8));
+	// Only the first nibble on the stop offset belongs to the area
+	EXPECT_EQ(3, search->findUnslashedSignature("DEF", 6, 7));
+	EXPECT_EQ(0, search->findUnslashedSignature("DEF0", 6, 7));
+	EXPECT_EQ(0, search->findUnslashedSignature("2345", 2, 1));
+}
+
+TEST_F(SearchTests, ResultsAreEqualToNaiveSearchOfNibbles)
+{
+	std::mt19937 generator(7);
+	std::vector<std::uint8_t> bytes(64);
+	for (auto &b : bytes)
+	{
+		// Small alphabet so that random patterns match often
+		b = generator() % 4 * 0x11;
+	}
+	load(bytes);
+
+	const std::string alphabet = "0123F-?;";
+	for (std::size_t i = 0; i < 2000; ++i)
+	{
+		std::string pattern(1 + generator() % 9, '0');
+		for (auto &c : pattern)
+		{
+			c = alphabet[generator() % alphabet.length()];
+		}
+		const std::size_t start = generator() % bytes.size();
+		const std::size_t stop = start + generator() % (bytes.size() - start);
+
+		const auto expected = naiveFind(pattern, start, stop)
+				? search->countImpNibbles(pattern)
+				: 0;
+		EXPECT_EQ(expected, search->findUnslashedSignature(pattern, start, stop))
+				<< "pattern " << pattern << " in <" << start << ", " << stop << ">";
+	}
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
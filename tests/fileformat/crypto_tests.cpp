@@ -0,0 +1,107 @@
+/**
+* @file tests/fileformat/crypto_tests.cpp
+* @brief Tests for the @c crypto module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/crypto.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c crypto module.
+ */
+class CryptoTests : public Test
+{
+	protected:
+		std::vector<unsigned char> createData(std::size_t size)
+		{
+			std::vector<unsigned char> data(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				data[i] = static_cast<unsigned char>((i * 31 + i / 256) & 0xFF);
+			}
+			return data;
+		}
+
+		void checkAllHashesMatch(const std::vector<unsigned char>& data)
+		{
+			std::string crc32, md5, sha256;
+			getCrc32Md5Sha256(data.data(), data.size(), crc32, md5, sha256);
+
+			EXPECT_EQ(getCrc32(data.data(), data.size()), crc32);
+			EXPECT_EQ(getMd5(data.data(), data.size()), md5);
+			EXPECT_EQ(getSha256(data.data(), data.size()), sha256);
+		}
+};
+
+TEST_F(CryptoTests, getCrc32Md5Sha256OfEmptyData)
+{
+	std::string crc32, md5, sha256;
+	getCrc32Md5Sha256(nullptr, 0, crc32, md5, sha256);
+
+	EXPECT_EQ("00000000", crc32);
+	EXPECT_EQ("d41d8cd98f00b204e9800998ecf8427e", md5);
+	EXPECT_EQ(
+		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+		sha256
+	);
+}
+
+TEST_F(CryptoTests, getCrc32Md5Sha256OfKnownData)
+{
+	std::string text = "The quick brown fox jumps over the lazy dog";
+	std::vector<unsigned char> data(text.begin(), text.end());
+
+	std::string crc32, md5, sha256;
+	getCrc32Md5Sha256(data.data(), data.size(), crc32, md5, sha256);
+
+	EXPECT_EQ("414fa339", crc32);
+	EXPECT_EQ("9e107d9d372bb6826bd81d3542a419d6", md5);
+	EXPECT_EQ(
+		"d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592",
+		sha256
+	);
+}
+
+TEST_F(CryptoTests, getCrc32Md5Sha256MatchesSeparateHashesForSmallData)
+{
+	for (std::size_t size : {1, 3, 55, 56, 63, 64, 65, 127, 128, 129})
+	{
+		SCOPED_TRACE(size);
+		checkAllHashesMatch(createData(size));
+	}
+}
+
+TEST_F(CryptoTests, getCrc32Md5Sha256MatchesSeparateHashesAtHashBlockBoundaries)
+{
+	// Data are hashed in blocks of 64 KiB.
+	for (std::size_t size : {0x10000 - 1, 0x10000, 0x10000 + 1, 3 * 0x10000 + 7})
+	{
+		SCOPED_TRACE(size);
+		checkAllHashesMatch(createData(size));
+	}
+}
+
+TEST_F(CryptoTests, getCrc32Md5Sha256MatchesSeparateHashesForLargeData)
+{
+	// Data of at least 8 MiB are hashed by each digest in its own thread.
+	for (std::size_t size : {0x800000 - 1, 0x800000, 0x800000 + 0x10000 + 1})
+	{
+		SCOPED_TRACE(size);
+		checkAllHashesMatch(createData(size));
+	}
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,239 @@
+/**
+* @file tests/fileformat/import_export_table_benchmarks.cpp
+* @brief Benchmarks of the lookups in import and export tables.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/export_table/export_table.h"
+#include "retdec/fileformat/types/import_table/import_table.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+namespace
+{
+
+/**
+ * Number of repetitions of the lookups of all the keys.
+ */
+const std::size_t ITERATIONS = 3;
+
+/**
+ * Linear scans over all the entries, which were used before the indexes.
+ */
+const Import* getImportLinearly(const ImportTable &table, const std::string &name)
+{
+	for(const auto &import : table)
+	{
+		if(import->getName() == name)
+		{
+			return import.get();
+		}
+	}
+	return nullptr;
+}
+
+const Import* getImportLinearly(const ImportTable &table, const std::string &libraryName,
+		std::uint64_t ordinalNumber)
+{
+	std::uint64_t ordinal = 0;
+	for(const auto &import : table)
+	{
+		if(table.getLibrary(import->getLibraryIndex()) == libraryName
+				&& import->getOrdinalNumber(ordinal) && ordinal == ordinalNumber)
+		{
+			return import.get();
+		}
+	}
+	return nullptr;
+}
+
+const Import* getImportOnAddressLinearly(const ImportTable &table, unsigned long long address)
+{
+	for(const auto &import : table)
+	{
+		if(import->getAddress() == address)
+		{
+			return import.get();
+		}
+	}
+	return nullptr;
+}
+
+const Export* getExportLinearly(const ExportTable &table, const std::string &name)
+{
+	for(const auto &exp : table)
+	{
+		if(exp.getName() == name)
+		{
+			return &exp;
+		}
+	}
+	return nullptr;
+}
+
+const Export* getExportByOrdinalLinearly(const ExportTable &table, std::uint64_t ordinalNumber)
+{
+	std::uint64_t ordinal = 0;
+	for(const auto &exp : table)
+	{
+		if(exp.getOrdinalNumber(ordinal) && ordinal == ordinalNumber)
+		{
+			return &exp;
+		}
+	}
+	return nullptr;
+}
+
+const Export* getExportOnAddressLinearly(const ExportTable &table, unsigned long long address)
+{
+	for(const auto &exp : table)
+	{
+		if(exp.getAddress() == address)
+		{
+			return &exp;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Returns the duration of the lookups of all the keys (in seconds).
+ */
+template <typename Lookup>
+double measure(std::size_t keys, Lookup lookup, std::vector<const void*> &results)
+{
+	results.clear();
+	const auto start = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < ITERATIONS; ++i)
+	{
+		for(std::size_t k = 0; k < keys; ++k)
+		{
+			results.push_back(lookup(k));
+		}
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printResult(const std::string &what, std::size_t entries, std::size_t lookups,
+		double linear, double index)
+{
+	std::cout << "[ BENCHMARK] " << what << ", " << entries << " entries, " << lookups << " lookups: "
+		<< "linear scan " << linear * 1e9 / lookups << " ns/lookup, "
+		<< "index " << index * 1e9 / lookups << " ns/lookup" << std::endl;
+}
+
+} // anonymous namespace
+
+/**
+ * Benchmarks of the lookups in import and export tables.
+ *
+ * Every entry is looked up by all its keys and by keys of a missing entry,
+ * through the linear scans and through the indexes of the same table.
+ */
+class ImportExportTableBenchmarks : public TestWithParam<std::size_t>
+{
+	protected:
+		std::string getName(std::size_t i)
+		{
+			return "function_" + std::to_string(i);
+		}
+
+		std::uint64_t getAddress(std::size_t i)
+		{
+			return 0x401000 + 8 * i;
+		}
+};
+
+TEST_P(ImportExportTableBenchmarks, ImportIndexesAreNotSlowerThanLinearScans)
+{
+	const auto entries = GetParam();
+	ImportTable table;
+	table.addLibrary("kernel32.dll");
+	table.addLibrary("user32.dll");
+	for(std::size_t i = 0; i < entries; ++i)
+	{
+		auto import = std::make_unique<Import>();
+		import->setName(getName(i));
+		import->setLibraryIndex(i % 2);
+		import->setAddress(getAddress(i));
+		import->setOrdinalNumber(i);
+		table.addImport(std::move(import));
+	}
+
+	// Every entry and one missing entry.
+	const auto keys = entries + 1;
+	std::vector<const void*> linearResults, indexResults;
+	double linear = 0.0, index = 0.0;
+
+	linear += measure(keys, [&](std::size_t k) { return getImportLinearly(table, getName(k)); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getImport(getName(k)); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	linear += measure(keys, [&](std::size_t k) { return getImportOnAddressLinearly(table, getAddress(k)); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getImportOnAddress(getAddress(k)); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	linear += measure(keys, [&](std::size_t k) { return getImportLinearly(table, table.getLibrary(k % 2), k); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getImport(table.getLibrary(k % 2), k); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	printResult("imports", entries, 3 * keys * ITERATIONS, linear, index);
+	// Small tables may be dominated by noise, so only larger ones are checked.
+	if(entries >= 1000)
+	{
+		EXPECT_LT(index, linear);
+	}
+}
+
+TEST_P(ImportExportTableBenchmarks, ExportIndexesAreNotSlowerThanLinearScans)
+{
+	const auto entries = GetParam();
+	ExportTable table;
+	for(std::size_t i = 0; i < entries; ++i)
+	{
+		Export newExport;
+		newExport.setName(getName(i));
+		newExport.setAddress(getAddress(i));
+		newExport.setOrdinalNumber(i);
+		table.addExport(newExport);
+	}
+
+	// Every entry and one missing entry.
+	const auto keys = entries + 1;
+	std::vector<const void*> linearResults, indexResults;
+	double linear = 0.0, index = 0.0;
+
+	linear += measure(keys, [&](std::size_t k) { return getExportLinearly(table, getName(k)); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getExport(getName(k)); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	linear += measure(keys, [&](std::size_t k) { return getExportOnAddressLinearly(table, getAddress(k)); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getExportOnAddress(getAddress(k)); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	linear += measure(keys, [&](std::size_t k) { return getExportByOrdinalLinearly(table, k); }, linearResults);
+	index += measure(keys, [&](std::size_t k) { return table.getExportByOrdinal(k); }, indexResults);
+	EXPECT_EQ(linearResults, indexResults);
+
+	printResult("exports", entries, 3 * keys * ITERATIONS, linear, index);
+	// Small tables may be dominated by noise, so only larger ones are checked.
+	if(entries >= 1000)
+	{
+		EXPECT_LT(index, linear);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(TableSizes, ImportExportTableBenchmarks, Values(10, 100, 1000, 5000));
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
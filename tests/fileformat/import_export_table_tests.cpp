@@ -0,0 +1,99 @@
+/**
+* @file tests/fileformat/import_export_table_tests.cpp
+* @brief Tests for the lookups in import and export tables.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/export_table/export_table.h"
+#include "retdec/fileformat/types/import_table/import_table.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the lookups in import and export tables.
+ */
+class ImportExportTableTests : public Test
+{
+	protected:
+		ImportTable importTable;
+		ExportTable exportTable;
+
+		void addImport(const std::string &name, std::uint64_t libraryIndex,
+				std::uint64_t address, std::uint64_t ordinalNumber)
+		{
+			auto import = std::make_unique<Import>();
+			import->setName(name);
+			import->setLibraryIndex(libraryIndex);
+			import->setAddress(address);
+			import->setOrdinalNumber(ordinalNumber);
+			importTable.addImport(std::move(import));
+		}
+
+		void addExport(const std::string &name, std::uint64_t address,
+				std::uint64_t ordinalNumber)
+		{
+			Export newExport;
+			newExport.setName(name);
+			newExport.setAddress(address);
+			newExport.setOrdinalNumber(ordinalNumber);
+			exportTable.addExport(newExport);
+		}
+};
+
+TEST_F(ImportExportTableTests, ImportLookupsReturnFirstMatchingImport)
+{
+	importTable.addLibrary("kernel32.dll");
+	importTable.addLibrary("user32.dll");
+	addImport("LoadLibraryA", 0, 0x1000, 1);
+	addImport("MessageBoxA", 1, 0x1008, 1);
+	addImport("LoadLibraryA", 1, 0x1010, 2);
+
+	EXPECT_EQ(0x1000, importTable.getImport("LoadLibraryA")->getAddress());
+	EXPECT_EQ("MessageBoxA", importTable.getImportOnAddress(0x1008)->getName());
+	EXPECT_EQ(0x1008, importTable.getImport("user32.dll", 1)->getAddress());
+	EXPECT_EQ(0x1010, importTable.getImport("user32.dll", 2)->getAddress());
+	EXPECT_EQ(nullptr, importTable.getImport("kernel32.dll", 2));
+	EXPECT_EQ(nullptr, importTable.getImport("ExitProcess"));
+	EXPECT_FALSE(importTable.hasImport(0x1004ULL));
+}
+
+TEST_F(ImportExportTableTests, ImportAddedAfterLookupIsFound)
+{
+	importTable.addLibrary("kernel32.dll");
+	addImport("LoadLibraryA", 0, 0x1000, 1);
+	ASSERT_EQ(nullptr, importTable.getImport("ExitProcess"));
+
+	addImport("ExitProcess", 0, 0x1008, 2);
+	addImport("LoadLibraryA", 0, 0x1010, 3);
+
+	EXPECT_EQ(0x1008, importTable.getImport("ExitProcess")->getAddress());
+	EXPECT_EQ(0x1000, importTable.getImport("LoadLibraryA")->getAddress());
+	EXPECT_EQ("LoadLibraryA", importTable.getImportOnAddress(0x1010)->getName());
+
+	importTable.clear();
+	EXPECT_EQ(nullptr, importTable.getImport("ExitProcess"));
+}
+
+TEST_F(ImportExportTableTests, ExportLookupsAreKeptInSyncWithAddedExports)
+{
+	addExport("foo", 0x2000, 1);
+	EXPECT_EQ(nullptr, exportTable.getExport("bar"));
+
+	addExport("bar", 0x2010, 2);
+	addExport("foo", 0x2020, 3);
+
+	EXPECT_EQ(0x2000, exportTable.getExport("foo")->getAddress());
+	EXPECT_EQ("bar", exportTable.getExportOnAddress(0x2010)->getName());
+	EXPECT_EQ(0x2020, exportTable.getExportByOrdinal(3)->getAddress());
+	EXPECT_EQ(nullptr, exportTable.getExportByOrdinal(4));
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -84,6 +84,24 @@ TEST_F(RawDataFormatTests_istream, TestInvalidEP)
 	EXPECT_EQ(0x8000, result);
 }
 
+TEST_F(RawDataFormatTests_istream, TestOffsetAddressTranslationAfterBaseAddressChange)
+{
+	std::uint64_t result = 0;
+	EXPECT_EQ(true, parser->getAddressFromOffset(result, 0x4));
+	EXPECT_EQ(0x4, result);
+
+	parser->setBaseAddress(0x8000);
+
+	EXPECT_EQ(true, parser->getAddressFromOffset(result, 0x4));
+	EXPECT_EQ(0x8004, result);
+	EXPECT_EQ(true, parser->getOffsetFromAddress(result, 0x8009));
+	EXPECT_EQ(0x9, result);
+	EXPECT_EQ(false, parser->getOffsetFromAddress(result, 0x800A));
+	EXPECT_EQ(nullptr, parser->getSectionFromAddress(0x4));
+	EXPECT_EQ(parser->getSections()[0], parser->getSectionFromAddress(0x8000));
+	EXPECT_EQ(nullptr, parser->getSectionFromOffset(0xA));
+}
+
 /**
  * Tests for the @c raw_data module - using istream constructor.
  */
@@ -0,0 +1,104 @@
+/**
+* @file tests/fileformat/signature_reader_tests.cpp
+* @brief Tests for the @c signature_reader module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/dotnet_headers/blob_stream.h"
+#include "retdec/fileformat/types/dotnet_headers/signature_reader.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c signature_reader module.
+ */
+class SignatureReaderTests : public Test
+{
+	protected:
+		std::vector<std::uint8_t> data;
+
+		SignatureReader reader()
+		{
+			return SignatureReader(data.data(), data.size());
+		}
+};
+
+TEST_F(SignatureReaderTests, ReadsCompressedUnsignedIntegers)
+{
+	data = { 0x03, 0x7F, 0x80, 0x80, 0xBF, 0xFF, 0xC0, 0x00, 0x40, 0x00, 0xDF, 0xFF, 0xFF, 0xFF };
+	auto signature = reader();
+
+	std::uint64_t value;
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x03, value);
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x7F, value);
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x80, value);
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x3FFF, value);
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x4000, value);
+	ASSERT_TRUE(signature.readUnsigned(value));
+	EXPECT_EQ(0x1FFFFFFF, value);
+	EXPECT_TRUE(signature.isEmpty());
+	EXPECT_FALSE(signature.readUnsigned(value));
+}
+
+TEST_F(SignatureReaderTests, ReadsCompressedSignedIntegers)
+{
+	data = { 0x06, 0x7B, 0x80, 0x80, 0xC0, 0x00, 0x40, 0x00 };
+	auto signature = reader();
+
+	std::int64_t value;
+	ASSERT_TRUE(signature.readSigned(value));
+	EXPECT_EQ(3, value);
+	ASSERT_TRUE(signature.readSigned(value));
+	EXPECT_EQ(-3, value);
+	ASSERT_TRUE(signature.readSigned(value));
+	EXPECT_EQ(64, value);
+	ASSERT_TRUE(signature.readSigned(value));
+	EXPECT_EQ(8192, value);
+	EXPECT_TRUE(signature.isEmpty());
+}
+
+TEST_F(SignatureReaderTests, TruncatedIntegerIsNotRead)
+{
+	data = { 0xC0, 0x00, 0x40 };
+	auto signature = reader();
+
+	std::uint64_t value;
+	EXPECT_FALSE(signature.readUnsigned(value));
+	EXPECT_EQ(3, signature.getRemainingSize());
+	EXPECT_FALSE(signature.skip(4));
+	EXPECT_TRUE(signature.skip(3));
+	EXPECT_TRUE(signature.isEmpty());
+}
+
+TEST_F(SignatureReaderTests, BlobStreamReturnsSignatureWithoutLengthPrefix)
+{
+	BlobStream blob({ 0x00, 0x03, 0x06, 0x08, 0x1C, 0x80, 0x01, 0x11 }, 0, 8);
+
+	auto signature = blob.getSignature(1);
+	ASSERT_EQ(3, signature.getRemainingSize());
+
+	std::uint8_t byte;
+	ASSERT_TRUE(signature.readByte(byte));
+	EXPECT_EQ(0x06, byte);
+
+	EXPECT_EQ(1, blob.getSignature(5).getRemainingSize());
+	EXPECT_TRUE(blob.getSignature(0).isEmpty());
+	EXPECT_TRUE(blob.getSignature(8).isEmpty());
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,112 @@
+/**
+* @file tests/fileformat/string_scanner_tests.cpp
+* @brief Tests for the @c string_scanner module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c string_scanner module.
+ */
+class StringScannerTests : public Test
+{
+	protected:
+		std::vector<std::uint8_t> data;
+
+		void setData(const std::string &bytes)
+		{
+			data.assign(bytes.begin(), bytes.end());
+		}
+
+		std::vector<StringRange> find(bool bigEndian = false)
+		{
+			return findStrings(data.data(), data.size(), 4, bigEndian);
+		}
+};
+
+TEST_F(StringScannerTests, FindsAsciiStringsOfMinimalLength)
+{
+	setData(std::string("\x01" "abc" "\x01" "abcd" "\x01" "hello", 15));
+
+	auto ranges = find();
+
+	ASSERT_EQ(2, ranges.size());
+	EXPECT_EQ(StringType::Ascii, ranges[0].type);
+	EXPECT_EQ(5, ranges[0].offset);
+	EXPECT_EQ(4, ranges[0].length);
+	EXPECT_EQ("abcd", getStringContent(data.data(), ranges[0], false));
+	EXPECT_EQ(10, ranges[1].offset);
+	EXPECT_EQ("hello", getStringContent(data.data(), ranges[1], false));
+}
+
+TEST_F(StringScannerTests, FindsLittleEndianWideStringAtOddOffset)
+{
+	setData(std::string("\x01" "w\0i\0d\0e\0" "\x01", 10));
+
+	auto ranges = find();
+
+	ASSERT_EQ(1, ranges.size());
+	EXPECT_EQ(StringType::Wide, ranges[0].type);
+	EXPECT_EQ(1, ranges[0].offset);
+	EXPECT_EQ(4, ranges[0].length);
+	EXPECT_EQ("wide", getStringContent(data.data(), ranges[0], false));
+}
+
+TEST_F(StringScannerTests, FindsBigEndianWideString)
+{
+	setData(std::string("\0w\0i\0d\0e", 8));
+
+	auto ranges = find(true);
+
+	ASSERT_EQ(1, ranges.size());
+	EXPECT_EQ(StringType::Wide, ranges[0].type);
+	EXPECT_EQ(0, ranges[0].offset);
+	EXPECT_EQ("wide", getStringContent(data.data(), ranges[0], true));
+}
+
+TEST_F(StringScannerTests, FindsStringsCrossingBlocksAndEndingAtEndOfData)
+{
+	setData(std::string(60, '\x01') + std::string(100, 'a'));
+
+	auto ranges = find();
+
+	ASSERT_EQ(1, ranges.size());
+	EXPECT_EQ(60, ranges[0].offset);
+	EXPECT_EQ(100, ranges[0].length);
+}
+
+TEST_F(StringScannerTests, FindsSameStringsInLargeDataAsInSmallData)
+{
+	const std::string pattern("\x01" "some text\0w\0i\0d\0e\0", 19);
+	std::string bytes;
+	while (bytes.size() < 0x800000)
+		bytes += pattern;
+	setData(bytes);
+
+	auto ranges = find();
+
+	ASSERT_EQ(2 * (bytes.size() / pattern.size()), ranges.size());
+	for (const auto &range : ranges)
+	{
+		if (range.type == StringType::Ascii)
+			EXPECT_EQ(1, range.offset % pattern.size());
+		else
+			EXPECT_EQ(9, range.offset % pattern.size());
+	}
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
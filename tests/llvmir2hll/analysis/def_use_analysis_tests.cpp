@@ -0,0 +1,225 @@
+/**
+* @file tests/llvmir2hll/analysis/def_use_analysis_tests.cpp
+* @brief Tests for the @c def_use_analysis module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <functional>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "llvmir2hll/analysis/tests_with_value_analysis.h"
+#include "llvmir2hll/ir/tests_with_module.h"
+#include "retdec/llvmir2hll/analysis/def_use_analysis.h"
+#include "retdec/llvmir2hll/analysis/use_def_analysis.h"
+#include "retdec/llvmir2hll/analysis/var_uses_visitor.h"
+#include "retdec/llvmir2hll/graphs/cfg/cfg_builders/non_recursive_cfg_builder.h"
+#include "retdec/llvmir2hll/ir/add_op_expr.h"
+#include "retdec/llvmir2hll/ir/assign_stmt.h"
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/ir/if_stmt.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/lt_op_expr.h"
+#include "retdec/llvmir2hll/ir/return_stmt.h"
+#include "retdec/llvmir2hll/ir/var_def_stmt.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/ir/while_loop_stmt.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c def_use_analysis module.
+*
+* The tests check that def-use and use-def chains which are updated after
+* a modification of a function are the same as the chains computed from
+* scratch.
+*
+* The function used by the tests:
+* @code
+* void test() {
+*     int a = 1;
+*     int b = a;
+*     int c = 0;
+*     while (c < b) {
+*         c = c + a;
+*     }
+*     if (b) {
+*         a = 2;
+*     }
+*     return a + c;
+* }
+* @endcode
+*/
+class DefUseAnalysisTests: public TestsWithModule {
+protected:
+	/// Modification of the function. It gets the CFG the chains have been
+	/// computed for and the used visitor of variable uses, and returns the
+	/// variables whose chains have to be updated.
+	using Modification = std::function<VarSet (ShPtr<CFG>,
+		ShPtr<VarUsesVisitor>)>;
+
+	DefUseAnalysisTests();
+
+	void checkUpdatedChainsAreEqualToRecomputedOnes(
+		ShPtr<ValueAnalysis> va, Modification modify);
+
+	static std::map<DefUseChains::StmtVarPair, StmtSet> toMap(
+		const DefUseChains::DefUseChain &du);
+
+protected:
+	ShPtr<Variable> varA;
+	ShPtr<Variable> varB;
+	ShPtr<Variable> varC;
+	ShPtr<VarDefStmt> varDefA;
+	ShPtr<VarDefStmt> varDefB;
+	ShPtr<VarDefStmt> varDefC;
+	ShPtr<AssignStmt> assignC;
+	ShPtr<WhileLoopStmt> whileLoop;
+	ShPtr<AssignStmt> assignA;
+	ShPtr<IfStmt> ifStmt;
+	ShPtr<ReturnStmt> returnStmt;
+};
+
+DefUseAnalysisTests::DefUseAnalysisTests():
+	varA(Variable::create("a", IntType::create(32))),
+	varB(Variable::create("b", IntType::create(32))),
+	varC(Variable::create("c", IntType::create(32))) {
+	testFunc->addLocalVar(varA);
+	testFunc->addLocalVar(varB);
+	testFunc->addLocalVar(varC);
+
+	returnStmt = ReturnStmt::create(AddOpExpr::create(varA, varC));
+	assignA = AssignStmt::create(varA, ConstInt::create(2, 32));
+	ifStmt = IfStmt::create(varB, assignA, returnStmt);
+	assignC = AssignStmt::create(varC, AddOpExpr::create(varC, varA));
+	whileLoop = WhileLoopStmt::create(LtOpExpr::create(varC, varB), assignC,
+		ifStmt);
+	varDefC = VarDefStmt::create(varC, ConstInt::create(0, 32), whileLoop);
+	varDefB = VarDefStmt::create(varB, varA, varDefC);
+	varDefA = VarDefStmt::create(varA, ConstInt::create(1, 32), varDefB);
+	testFunc->setBody(varDefA);
+}
+
+/**
+* @brief Computes the chains of @c testFunc, modifies the function by @a modify,
+*        updates the chains, and checks that they are equal to the chains
+*        computed from scratch.
+*/
+void DefUseAnalysisTests::checkUpdatedChainsAreEqualToRecomputedOnes(
+		ShPtr<ValueAnalysis> va, Modification modify) {
+	// Compute and update the chains in the same way as
+	// CopyPropagationOptimizer does.
+	auto vuv = VarUsesVisitor::create(va, true, module);
+	auto dua = DefUseAnalysis::create(module, va, vuv);
+	auto uda = UseDefAnalysis::create(module);
+	auto ducs = dua->getDefUseChains(testFunc,
+		NonRecursiveCFGBuilder::create()->getCFG(testFunc));
+	auto udcs = uda->getUseDefChains(testFunc, ducs);
+	auto originalDu = ducs->du;
+
+	auto vars = modify(ducs->cfg, vuv);
+	dua->updateDefUseChains(ducs, vars);
+	uda->updateUseDefChains(udcs, ducs, vars);
+
+	// Compute the chains from scratch, without any cached data.
+	va->clearCache();
+	auto expectedDucs = DefUseAnalysis::create(module, va)->getDefUseChains(
+		testFunc, ducs->cfg);
+	auto expectedUdcs = UseDefAnalysis::create(module)->getUseDefChains(
+		testFunc, expectedDucs);
+
+	EXPECT_FALSE(originalDu == expectedDucs->du) <<
+		"the modification should change the def-use chains";
+	EXPECT_TRUE(expectedDucs->du == ducs->du) <<
+		"the updated def-use chains differ from the recomputed ones";
+	EXPECT_TRUE(expectedUdcs->ud == udcs->ud) <<
+		"the updated use-def chains differ from the recomputed ones";
+
+	// A CFG built from scratch may order its nodes differently, so only the
+	// chains themselves are compared.
+	auto freshDucs = DefUseAnalysis::create(module, va)->getDefUseChains(
+		testFunc, NonRecursiveCFGBuilder::create()->getCFG(testFunc));
+	EXPECT_TRUE(toMap(freshDucs->du) == toMap(ducs->du)) <<
+		"the updated def-use chains differ from the chains of a new CFG";
+}
+
+/**
+* @brief Returns @a du as a mapping of definitions into their uses.
+*/
+std::map<DefUseChains::StmtVarPair, StmtSet> DefUseAnalysisTests::toMap(
+		const DefUseChains::DefUseChain &du) {
+	return std::map<DefUseChains::StmtVarPair, StmtSet>(du.begin(), du.end());
+}
+
+TEST_F(DefUseAnalysisTests,
+UpdatedChainsAreEqualToRecomputedChainsAfterChangingStatement) {
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+
+	// int b = a;  ->  int b = 1;
+	checkUpdatedChainsAreEqualToRecomputedOnes(va,
+		[&](ShPtr<CFG>, ShPtr<VarUsesVisitor> vuv) {
+			varDefB->setInitializer(ConstInt::create(1, 32));
+			va->removeFromCache(varDefB);
+			vuv->stmtHasBeenChanged(varDefB, testFunc);
+			return VarSet{varA, varB};
+		}
+	);
+}
+
+TEST_F(DefUseAnalysisTests,
+UpdatedChainsAreEqualToRecomputedChainsAfterChangingStatementInLoop) {
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+
+	// c = c + a;  ->  c = c + b;
+	checkUpdatedChainsAreEqualToRecomputedOnes(va,
+		[&](ShPtr<CFG>, ShPtr<VarUsesVisitor> vuv) {
+			assignC->setRhs(AddOpExpr::create(varC, varB));
+			va->removeFromCache(assignC);
+			vuv->stmtHasBeenChanged(assignC, testFunc);
+			return VarSet{varA, varB, varC};
+		}
+	);
+}
+
+TEST_F(DefUseAnalysisTests,
+UpdatedChainsAreEqualToRecomputedChainsAfterRemovingStatement) {
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+
+	// int c = 0;  ->  (removed)
+	checkUpdatedChainsAreEqualToRecomputedOnes(va,
+		[&](ShPtr<CFG> cfg, ShPtr<VarUsesVisitor> vuv) {
+			Statement::removeStatement(varDefC);
+			cfg->removeStmt(varDefC);
+			va->removeFromCache(varDefC);
+			vuv->stmtHasBeenRemoved(varDefC, testFunc);
+			return VarSet{varC};
+		}
+	);
+}
+
+TEST_F(DefUseAnalysisTests,
+UpdatedChainsAreEqualToRecomputedChainsAfterReplacingStatement) {
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+
+	// a = 2;  ->  b = 2;
+	checkUpdatedChainsAreEqualToRecomputedOnes(va,
+		[&](ShPtr<CFG> cfg, ShPtr<VarUsesVisitor> vuv) {
+			auto assignB = AssignStmt::create(varB, ConstInt::create(2, 32));
+			Statement::replaceStatement(assignA, assignB);
+			cfg->replaceStmt(assignA, {assignB});
+			va->removeFromCache(assignA);
+			vuv->stmtHasBeenRemoved(assignA, testFunc);
+			vuv->stmtHasBeenAdded(assignB, testFunc);
+			return VarSet{varA, varB};
+		}
+	);
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
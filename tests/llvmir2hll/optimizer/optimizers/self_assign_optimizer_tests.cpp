@@ -204,6 +204,93 @@ FuncWithJustSelfAssignIsOptimizedToEmptyBody) {
 		testFunc->getBody()->getSuccessor();
 }
 
+TEST_F(SelfAssignOptimizerTests,
+SelfAssignsInAllFunctionsAreRemovedWhenOptimizedInParallel) {
+	// Add the following body to the testing function and to many other
+	// functions (g is a global variable):
+	//
+	//   g = g
+	//   return
+	//
+	ShPtr<Variable> varG(Variable::create("g", IntType::create(16)));
+	module->addGlobalVar(varG);
+	FuncVector funcs{testFunc};
+	for (int i = 0; i < 100; ++i) {
+		funcs.push_back(addFuncDef("func" + std::to_string(i)));
+	}
+	for (const auto &func : funcs) {
+		func->setBody(AssignStmt::create(varG, varG, ReturnStmt::create()));
+	}
+
+	// Optimize the module by several optimizers in parallel.
+	std::vector<ShPtr<FuncOptimizer>> optimizers;
+	for (int i = 0; i < 4; ++i) {
+		optimizers.push_back(std::make_shared<SelfAssignOptimizer>(module));
+	}
+	ASSERT_TRUE(optimizers.front()->canBeRunInParallel());
+	FuncOptimizer::optimizeInParallel(optimizers);
+
+	// Check that the output is correct.
+	for (const auto &func : funcs) {
+		ShPtr<ReturnStmt> outFuncBody(cast<ReturnStmt>(func->getBody()));
+		ASSERT_TRUE(outFuncBody) <<
+			"expected ReturnStmt, got " << func->getBody();
+		EXPECT_TRUE(!outFuncBody->hasSuccessor()) <<
+			"expected no successor, got " << outFuncBody->getSuccessor();
+	}
+}
+
+TEST_F(SelfAssignOptimizerTests,
+CancelledOptimizerLeavesFunctionsUnchanged) {
+	// Add a body to the testing function:
+	//
+	//   a = a
+	//   return
+	//
+	ShPtr<Variable> var(Variable::create("a", IntType::create(16)));
+	ShPtr<AssignStmt> assignStmt(
+		AssignStmt::create(var, var,
+		ReturnStmt::create())); // successor
+	testFunc->setBody(assignStmt);
+
+	// Optimize the module.
+	retdec::utils::CancellationToken cancellation;
+	cancellation.cancel();
+	ShPtr<SelfAssignOptimizer> optimizer(new SelfAssignOptimizer(module));
+	optimizer->setCancellationToken(&cancellation);
+	optimizer->optimize();
+
+	// Check that the output is correct.
+	EXPECT_EQ(assignStmt, testFunc->getBody());
+}
+
+TEST_F(SelfAssignOptimizerTests,
+CancelledParallelOptimizersLeaveFunctionsUnchanged) {
+	// Add a body to the testing function:
+	//
+	//   a = a
+	//   return
+	//
+	ShPtr<Variable> var(Variable::create("a", IntType::create(16)));
+	ShPtr<AssignStmt> assignStmt(
+		AssignStmt::create(var, var,
+		ReturnStmt::create())); // successor
+	testFunc->setBody(assignStmt);
+
+	// Optimize the module.
+	retdec::utils::CancellationToken cancellation;
+	cancellation.cancel();
+	std::vector<ShPtr<FuncOptimizer>> optimizers;
+	for (int i = 0; i < 2; ++i) {
+		optimizers.push_back(std::make_shared<SelfAssignOptimizer>(module));
+		optimizers.back()->setCancellationToken(&cancellation);
+	}
+	FuncOptimizer::optimizeInParallel(optimizers);
+
+	// Check that the output is correct.
+	EXPECT_EQ(assignStmt, testFunc->getBody());
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,126 @@
+/**
+ * @file tests/loader/image_benchmarks.cpp
+ * @brief Benchmarks of segment lookups of the @c image module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "retdec/loader/loader/image.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace loader {
+namespace tests {
+
+namespace {
+
+/**
+ * Number of repetitions of the lookups of all the addresses.
+ */
+const std::size_t ITERATIONS = 200;
+
+class BenchmarkImage : public Image
+{
+public:
+	BenchmarkImage() : Image(nullptr) {}
+
+	virtual bool load() override { return true; }
+
+	void addSegment(std::uint64_t address, std::uint64_t size)
+	{
+		insertSegment(std::make_unique<Segment>(nullptr, address, size, nullptr));
+	}
+};
+
+/**
+ * Linear scan over all the segments, which was used before the index.
+ */
+const Segment* getSegmentFromAddressLinearly(const Image& image, std::uint64_t address)
+{
+	for (const auto& segment : image.getSegments())
+	{
+		if (segment->containsAddress(address))
+			return segment.get();
+	}
+	return nullptr;
+}
+
+/**
+ * Returns the duration of the lookups of all the addresses (in seconds).
+ */
+template <typename Lookup>
+double measure(const std::vector<std::uint64_t>& addresses, Lookup lookup,
+		std::vector<const Segment*>& results)
+{
+	results.clear();
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < ITERATIONS; ++i)
+	{
+		for (auto address : addresses)
+			results.push_back(lookup(address));
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+class ImageBenchmarks : public TestWithParam<std::size_t>
+{
+};
+
+TEST_P(ImageBenchmarks,
+IndexIsNotSlowerThanLinearScan) {
+	// Segments of a fragmented image, with gaps among them.
+	BenchmarkImage image;
+	const auto segmentsCount = GetParam();
+	for (std::uint64_t i = 0; i < segmentsCount; ++i)
+		image.addSegment(0x400000 + (segmentsCount - i - 1) * 0x2000, 0x1000);
+
+	// The start, the middle, the last and the first following address of each
+	// segment, in the order of the segments (as the sequential reads of the
+	// decompiler) and then in a random order.
+	std::vector<std::uint64_t> addresses;
+	for (const auto& segment : image.getSegments())
+	{
+		auto range = segment->getAddressRange();
+		addresses.push_back(range.getStart());
+		addresses.push_back(range.getStart() + (range.getEnd() - range.getStart()) / 2);
+		addresses.push_back(range.getEnd() - 1);
+		addresses.push_back(range.getEnd());
+	}
+	auto shuffled = addresses;
+	std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+	addresses.insert(addresses.end(), shuffled.begin(), shuffled.end());
+
+	std::vector<const Segment*> linearResults, indexResults;
+	const Image& constImage = image;
+	auto linear = measure(addresses, [&](std::uint64_t address) {
+		return getSegmentFromAddressLinearly(constImage, address);
+	}, linearResults);
+	auto index = measure(addresses, [&](std::uint64_t address) {
+		return constImage.getSegmentFromAddress(address);
+	}, indexResults);
+
+	const auto lookups = linearResults.size();
+	std::cout << "[ BENCHMARK] " << segmentsCount << " segments, " << lookups << " lookups: "
+		<< "linear scan " << linear * 1e9 / lookups << " ns/lookup, "
+		<< "index " << index * 1e9 / lookups << " ns/lookup" << std::endl;
+
+	EXPECT_EQ(linearResults, indexResults);
+	// Small images may be dominated by noise, so only larger ones are checked.
+	if (segmentsCount >= 64)
+		EXPECT_LT(index, linear);
+}
+
+INSTANTIATE_TEST_SUITE_P(SegmentCounts, ImageBenchmarks, Values(8, 32, 200, 1000));
+
+} // namespace tests
+} // namespace loader
+} // namespace retdec
@@ -0,0 +1,121 @@
+/**
+ * @file tests/loader/image_tests.cpp
+ * @brief Tests for the @c image module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <gtest/gtest.h>
+
+#include "retdec/loader/loader/image.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace loader {
+namespace tests {
+
+class TestImage : public Image
+{
+public:
+	TestImage() : Image(nullptr) {}
+
+	virtual bool load() override { return true; }
+
+	Segment* addSegment(std::uint64_t address, std::uint64_t size)
+	{
+		return insertSegment(std::make_unique<Segment>(nullptr, address, size, nullptr));
+	}
+
+	using Image::removeSegment;
+	using Image::sortSegments;
+};
+
+class ImageTests : public Test
+{
+public:
+	TestImage image;
+};
+
+TEST_F(ImageTests,
+GetSegmentFromAddressWorksForDisjointSegments) {
+	auto* seg1 = image.addSegment(0x3000, 0x100);
+	auto* seg2 = image.addSegment(0x1000, 0x200);
+	auto* seg3 = image.addSegment(0x2000, 0x1000);
+
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x0));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0xFFF));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1000));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x11FF));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x1200));
+	EXPECT_EQ(seg3, image.getSegmentFromAddress(0x2000));
+	EXPECT_EQ(seg3, image.getSegmentFromAddress(0x2FFF));
+	EXPECT_EQ(seg1, image.getSegmentFromAddress(0x3000));
+	EXPECT_EQ(seg1, image.getSegmentFromAddress(0x30FF));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x3100));
+}
+
+TEST_F(ImageTests,
+GetSegmentFromAddressPrefersFirstSegmentWhenOverlapping) {
+	auto* seg1 = image.addSegment(0x1800, 0x100);
+	auto* seg2 = image.addSegment(0x1000, 0x1000);
+	auto* seg3 = image.addSegment(0x1F00, 0x200);
+
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x17FF));
+	EXPECT_EQ(seg1, image.getSegmentFromAddress(0x1800));
+	EXPECT_EQ(seg1, image.getSegmentFromAddress(0x18FF));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1900));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1FFF));
+	EXPECT_EQ(seg3, image.getSegmentFromAddress(0x2000));
+	EXPECT_EQ(seg3, image.getSegmentFromAddress(0x20FF));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x2100));
+}
+
+TEST_F(ImageTests,
+GetSegmentFromAddressWorksForEmptySegment) {
+	auto* seg = image.addSegment(0x1000, 0);
+
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0xFFF));
+	EXPECT_EQ(seg, image.getSegmentFromAddress(0x1000));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x1001));
+}
+
+TEST_F(ImageTests,
+GetSegmentFromAddressReflectsChangesOfSegments) {
+	auto* seg1 = image.addSegment(0x1000, 0x100);
+	auto* seg2 = image.addSegment(0x1000, 0x200);
+
+	EXPECT_EQ(seg1, image.getSegmentFromAddress(0x1080));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1180));
+	EXPECT_EQ(nullptr, image.getSegmentFromAddress(0x2000));
+
+	auto* seg3 = image.addSegment(0x2000, 0x100);
+	EXPECT_EQ(seg3, image.getSegmentFromAddress(0x2000));
+
+	image.removeSegment(seg1);
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1080));
+
+	auto* seg4 = image.addSegment(0x0, 0x1100);
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1080));
+	image.sortSegments();
+	EXPECT_EQ(seg4, image.getSegmentFromAddress(0x1080));
+	EXPECT_EQ(seg2, image.getSegmentFromAddress(0x1100));
+}
+
+TEST_F(ImageTests,
+GetSegmentFromAddressWorksForManySegments) {
+	std::vector<Segment*> segments;
+	for (std::uint64_t i = 0; i < 1000; ++i)
+		segments.push_back(image.addSegment(0x400000 + (999 - i) * 0x2000, 0x1000));
+
+	for (std::uint64_t i = 0; i < 1000; ++i)
+	{
+		auto address = 0x400000 + (999 - i) * 0x2000;
+		EXPECT_EQ(segments[i], image.getSegmentFromAddress(address));
+		EXPECT_EQ(segments[i], image.getSegmentFromAddress(address + 0xFFF));
+		EXPECT_EQ(nullptr, image.getSegmentFromAddress(address + 0x1000));
+	}
+}
+
+} // namespace tests
+} // namespace loader
+} // namespace retdec
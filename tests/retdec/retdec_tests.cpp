@@ -0,0 +1,184 @@
+/**
+* @file tests/retdec/retdec_tests.cpp
+* @brief Tests for the @c retdec module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <iterator>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/config/config.h"
+#include "retdec/retdec/retdec.h"
+#include "retdec/utils/filesystem.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace tests {
+
+/**
+ * End-to-end tests of the cache of decompilation results.
+ */
+class DecompilationCacheTests : public Test
+{
+	protected:
+		DecompilationCacheTests() :
+				directory(fs::temp_directory_path()
+					/ ("retdec-decompilation-cache-"
+						+ std::to_string(std::random_device()())))
+		{
+			fs::create_directories(directory);
+
+			// Raw x86 code:
+			//   0x1000: push 2; call 0x100c; add esp, 4; ret
+			//   0x100c: push ebp; mov ebp, esp; mov eax, [ebp+8];
+			//           add eax, eax; pop ebp; ret
+			const std::vector<std::uint8_t> code = {
+				0x6A, 0x02,
+				0xE8, 0x04, 0x00, 0x00, 0x00,
+				0x83, 0xC4, 0x04,
+				0xC3,
+				0x90,
+				0x55,
+				0x89, 0xE5,
+				0x8B, 0x45, 0x08,
+				0x01, 0xC0,
+				0x5D,
+				0xC3
+			};
+			writeFile("input.bin", std::string(code.begin(), code.end()));
+			fs::create_directories(directory / "ordinals");
+		}
+
+		~DecompilationCacheTests() override
+		{
+			std::error_code ec;
+			fs::remove_all(directory, ec);
+		}
+
+		std::string path(const std::string& name) const
+		{
+			return (directory / name).string();
+		}
+
+		void writeFile(const std::string& name, const std::string& content)
+		{
+			std::ofstream(path(name), std::ios::binary) << content;
+		}
+
+		std::string readFile(const std::string& name) const
+		{
+			std::ifstream in(path(name), std::ios::binary);
+			return std::string(
+					(std::istreambuf_iterator<char>(in)),
+					std::istreambuf_iterator<char>());
+		}
+
+		std::size_t getCacheEntriesCount() const
+		{
+			std::error_code ec;
+			std::size_t count = 0;
+			for (fs::directory_iterator it(path("cache"), ec), end;
+					!ec && it != end;
+					it.increment(ec))
+			{
+				++count;
+			}
+			return count;
+		}
+
+		/**
+		 * Decompiles the input in the raw mode and returns the outputs
+		 * (output name -> content).
+		 */
+		std::map<std::string, std::string> decompile()
+		{
+			auto config = config::Config::fromFile(
+					RETDEC_TESTS_DECOMPILER_CONFIG);
+			auto& params = config.parameters;
+
+			// Do not depend on the support package, use only files created
+			// by the test.
+			params.userStaticSignaturePaths.clear();
+			params.staticSignaturePaths.clear();
+			params.libraryTypeInfoPaths.clear();
+			params.cryptoPatternPaths.clear();
+			params.abiPaths.clear();
+			params.setOrdinalNumbersDirectory(path("ordinals"));
+
+			params.setIsVerboseOutput(false);
+			params.setIsBackendNoTimeVaryingInfo(true);
+			params.setInputFile(path("input.bin"));
+			params.setOutputFile(path("output.c"));
+			params.setOutputLlvmirFile(path("output.ll"));
+			params.setOutputBitcodeFile(path("output.bc"));
+			params.setOutputAsmFile(path("output.dsm"));
+			params.setOutputConfigFile(path("output.config.json"));
+			params.setCacheDirectory(path("cache"));
+
+			params.setSectionVMA(0x1000);
+			params.setEntryPoint(0x1000);
+			config.architecture.setName("x86");
+			config.architecture.setIsEndianLittle();
+			config.architecture.setBitSize(32);
+			config.fileFormat.setIsRaw();
+			config.fileFormat.setFileClassBits(32);
+
+			EXPECT_EQ(EXIT_SUCCESS, retdec::decompile(config));
+
+			std::map<std::string, std::string> outputs;
+			for (const auto* name : {
+					"output.c",
+					"output.ll",
+					"output.dsm",
+					"output.config.json"})
+			{
+				outputs[name] = readFile(name);
+				std::error_code ec;
+				fs::remove(path(name), ec);
+			}
+			return outputs;
+		}
+
+	private:
+		fs::path directory;
+};
+
+TEST_F(DecompilationCacheTests, CachedResultsAreEqualToResultsOfColdRun)
+{
+	auto cold = decompile();
+	ASSERT_EQ(1, getCacheEntriesCount());
+	for (const auto& output : cold)
+	{
+		EXPECT_FALSE(output.second.empty()) << output.first;
+	}
+
+	auto cached = decompile();
+	EXPECT_EQ(1, getCacheEntriesCount());
+	for (const auto& output : cold)
+	{
+		EXPECT_EQ(output.second, cached[output.first]) << output.first;
+	}
+}
+
+TEST_F(DecompilationCacheTests, ChangedSupportFilesAreNotServedFromCache)
+{
+	auto cold = decompile();
+	ASSERT_EQ(1, getCacheEntriesCount());
+
+	writeFile("ordinals/test.ord", "1 f\n");
+	auto changed = decompile();
+	EXPECT_EQ(2, getCacheEntriesCount());
+	EXPECT_EQ(cold["output.c"], changed["output.c"]);
+}
+
+} // namespace tests
+} // namespace retdec
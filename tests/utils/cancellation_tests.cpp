@@ -0,0 +1,94 @@
+/**
+* @file tests/utils/cancellation_tests.cpp
+* @brief Tests for the @c cancellation module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/cancellation.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c cancellation module.
+*/
+class CancellationTokenTests: public Test {};
+
+TEST_F(CancellationTokenTests,
+NewTokenIsNotCancelledAndHasNoDeadline) {
+	CancellationToken token;
+
+	ASSERT_FALSE(token.isCancelled());
+	ASSERT_FALSE(token.hasDeadline());
+}
+
+TEST_F(CancellationTokenTests,
+TokenIsCancelledAfterCancel) {
+	CancellationToken token;
+
+	token.cancel();
+
+	ASSERT_TRUE(token.isCancelled());
+}
+
+TEST_F(CancellationTokenTests,
+TokenIsCancelledWhenDeadlinePasses) {
+	CancellationToken token;
+
+	token.setDeadline(CancellationToken::Clock::now() - 1s);
+
+	ASSERT_TRUE(token.hasDeadline());
+	ASSERT_TRUE(token.isCancelled());
+}
+
+TEST_F(CancellationTokenTests,
+TokenIsNotCancelledBeforeTimeoutPasses) {
+	CancellationToken token;
+
+	token.setTimeout(1h);
+
+	ASSERT_FALSE(token.isCancelled());
+}
+
+TEST_F(CancellationTokenTests,
+ChildTokenIsCancelledWithItsParent) {
+	CancellationToken parent;
+	CancellationToken child(&parent);
+
+	parent.cancel();
+
+	ASSERT_TRUE(child.isCancelled());
+}
+
+TEST_F(CancellationTokenTests,
+ParentTokenIsNotCancelledWithItsChild) {
+	CancellationToken parent;
+	CancellationToken child(&parent);
+
+	child.setDeadline(CancellationToken::Clock::now() - 1s);
+
+	ASSERT_TRUE(child.isCancelled());
+	ASSERT_FALSE(parent.isCancelled());
+}
+
+TEST_F(CancellationTokenTests,
+TokenCanBeCancelledFromOtherThread) {
+	CancellationToken token;
+
+	std::thread t([&]() { token.cancel(); });
+	t.join();
+
+	ASSERT_TRUE(token.isCancelled());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -4,6 +4,8 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
 #include "retdec/utils/memory.h"
@@ -28,6 +30,7 @@ protected:
 
 	virtual void TearDown() override {
 		limitSystemMemory(totalSystemMemory);
+		setMemorySoftLimit(0);
 	}
 
 private:
@@ -73,6 +76,81 @@ LimitSystemMemoryToHalfOfTotalSystemMemoryReturnsTrue) {
 	ASSERT_TRUE(limitSystemMemoryToHalfOfTotalSystemMemory());
 }
 
+TEST_F(MemoryTests,
+GetCurrentResidentMemoryReturnsNonZeroSize) {
+	ASSERT_GT(getCurrentResidentMemory(), 0);
+}
+
+TEST_F(MemoryTests,
+GetPeakResidentMemoryReturnsNonZeroSize) {
+	ASSERT_GT(getPeakResidentMemory(), 0);
+}
+
+TEST_F(MemoryTests,
+GetCurrentVirtualMemoryReturnsSizeNotBelowResidentMemory) {
+	auto resident = getCurrentResidentMemory();
+
+	ASSERT_GE(getCurrentVirtualMemory(), resident);
+}
+
+TEST_F(MemoryTests,
+MemorySoftLimitIsNotExceededWhenThereIsNoLimit) {
+	setMemorySoftLimit(0);
+
+	ASSERT_EQ(0, getMemorySoftLimit());
+	ASSERT_FALSE(isMemorySoftLimitExceeded());
+}
+
+TEST_F(MemoryTests,
+MemorySoftLimitIsExceededWhenItIsBelowCurrentResidentMemory) {
+	setMemorySoftLimit(1);
+
+	ASSERT_EQ(1, getMemorySoftLimit());
+	ASSERT_TRUE(isMemorySoftLimitExceeded());
+}
+
+TEST_F(MemoryTests,
+MemorySoftLimitIsNotExceededWhenItIsAboveCurrentResidentMemory) {
+	setMemorySoftLimit(getCurrentResidentMemory() * 1024);
+
+	ASSERT_FALSE(isMemorySoftLimitExceeded());
+}
+
+TEST_F(MemoryTests,
+MemorySoftLimitIsComparedWithResidentMemoryByDefault) {
+	setMemorySoftLimit(1);
+
+	ASSERT_EQ(MemoryKind::Resident, getMemorySoftLimitKind());
+}
+
+TEST_F(MemoryTests,
+VirtualMemorySoftLimitIsExceededWhenItIsBelowCurrentVirtualMemory) {
+	setMemorySoftLimit(1, MemoryKind::Virtual);
+
+	ASSERT_EQ(MemoryKind::Virtual, getMemorySoftLimitKind());
+	ASSERT_TRUE(isMemorySoftLimitExceeded());
+}
+
+#ifdef OS_LINUX
+TEST_F(MemoryTests,
+SoftLimitBetweenResidentAndVirtualMemoryIsExceededOnlyForVirtualMemory) {
+	// Memory that is allocated but never touched is part of the virtual
+	// memory, but not of the resident memory.
+	const std::size_t reservedSize = 512 * 1024 * 1024;
+	auto *volatile reserved = static_cast<char *>(std::malloc(reservedSize));
+	ASSERT_NE(nullptr, reserved);
+	auto limit = getCurrentResidentMemory() + reservedSize / 2;
+
+	setMemorySoftLimit(limit, MemoryKind::Resident);
+	EXPECT_FALSE(isMemorySoftLimitExceeded());
+
+	setMemorySoftLimit(limit, MemoryKind::Virtual);
+	EXPECT_TRUE(isMemorySoftLimitExceeded());
+
+	std::free(reserved);
+}
+#endif
+
 } // namespace tests
 } // namespace utils
 } // namespace retdec
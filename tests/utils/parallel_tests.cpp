@@ -0,0 +1,130 @@
+/**
+* @file tests/utils/parallel_tests.cpp
+* @brief Tests for the @c parallel module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/parallel.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c parallel module.
+*/
+class ParallelTests: public Test {};
+
+TEST_F(ParallelTests,
+GetNumberOfThreadsReturnsConfiguredNumber) {
+	EXPECT_EQ(1, getNumberOfThreads(1));
+	EXPECT_EQ(8, getNumberOfThreads(8));
+}
+
+TEST_F(ParallelTests,
+GetNumberOfThreadsReturnsAtLeastOneThreadForAllCores) {
+	EXPECT_GE(getNumberOfThreads(0), 1);
+}
+
+TEST_F(ParallelTests,
+ParallelForProcessesEveryItemExactlyOnce) {
+	std::vector<std::atomic<int>> processed(1000);
+	std::mutex threadsMutex;
+	std::set<std::size_t> threads;
+
+	parallelFor(processed.size(), 4, [&](std::size_t item, std::size_t thread) {
+		++processed[item];
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		threads.insert(thread);
+		return true;
+	});
+
+	for (auto &p : processed) {
+		EXPECT_EQ(1, p);
+	}
+	EXPECT_FALSE(threads.empty());
+	EXPECT_LT(*threads.rbegin(), 4);
+}
+
+TEST_F(ParallelTests,
+ParallelForUsesOnlyCallingThreadForOneThread) {
+	std::vector<std::size_t> items;
+
+	parallelFor(5, 1, [&](std::size_t item, std::size_t thread) {
+		EXPECT_EQ(0, thread);
+		items.push_back(item);
+		return true;
+	});
+
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3, 4}), items);
+}
+
+TEST_F(ParallelTests,
+ParallelForDoesNothingForNoItems) {
+	parallelFor(0, 4, [&](std::size_t, std::size_t) {
+		ADD_FAILURE() << "no item should be processed";
+		return true;
+	});
+}
+
+TEST_F(ParallelTests,
+ParallelForStopsWhenItemProcessingReturnsFalse) {
+	std::vector<std::size_t> items;
+
+	parallelFor(10, 1, [&](std::size_t item, std::size_t) {
+		items.push_back(item);
+		return item < 3;
+	});
+
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3}), items);
+}
+
+TEST_F(ParallelTests,
+ParallelForRethrowsExceptionAfterAllThreadsFinish) {
+	std::atomic<std::size_t> running(0);
+
+	EXPECT_THROW(
+		parallelFor(1000, 4, [&](std::size_t item, std::size_t) {
+			++running;
+			if (item == 10) {
+				--running;
+				throw std::runtime_error("failure");
+			}
+			--running;
+			return true;
+		}),
+		std::runtime_error
+	);
+	EXPECT_EQ(0, running);
+}
+
+TEST_F(ParallelTests,
+ParallelForStopsWhenItemProcessingThrows) {
+	std::vector<std::size_t> items;
+
+	EXPECT_THROW(
+		parallelFor(10, 1, [&](std::size_t item, std::size_t) {
+			if (item == 3) {
+				throw std::runtime_error("failure");
+			}
+			items.push_back(item);
+			return true;
+		}),
+		std::runtime_error
+	);
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), items);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
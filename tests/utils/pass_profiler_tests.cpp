@@ -0,0 +1,173 @@
+/**
+* @file tests/utils/pass_profiler_tests.cpp
+* @brief Tests for the @c pass_profiler module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/pass_profiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c pass_profiler module.
+*/
+class PassProfilerTests: public Test {
+protected:
+	IrSize irSize(std::uint64_t functions, std::uint64_t blocks,
+			std::uint64_t instructions) {
+		IrSize size;
+		size.functions = functions;
+		size.blocks = blocks;
+		size.instructions = instructions;
+		return size;
+	}
+
+	PassProfiler profiler;
+};
+
+TEST_F(PassProfilerTests,
+NoProfilesAreRecordedByDefault) {
+	ASSERT_TRUE(profiler.getProfiles().empty());
+	ASSERT_FALSE(profiler.isPassRunning());
+}
+
+TEST_F(PassProfilerTests,
+FinishedPassIsRecordedWithItsNameAndIrSizes) {
+	profiler.startPass("bin2llvmir", "retdec-decoder", irSize(1, 2, 3));
+	ASSERT_TRUE(profiler.isPassRunning());
+	profiler.endPass(irSize(4, 5, 6));
+
+	ASSERT_FALSE(profiler.isPassRunning());
+	ASSERT_EQ(1, profiler.getProfiles().size());
+	auto &p = profiler.getProfiles().front();
+	EXPECT_EQ("bin2llvmir", p.component);
+	EXPECT_EQ("retdec-decoder", p.name);
+	EXPECT_EQ(1, p.irSizeBefore.functions);
+	EXPECT_EQ(2, p.irSizeBefore.blocks);
+	EXPECT_EQ(3, p.irSizeBefore.instructions);
+	EXPECT_EQ(4, p.irSizeAfter.functions);
+	EXPECT_EQ(5, p.irSizeAfter.blocks);
+	EXPECT_EQ(6, p.irSizeAfter.instructions);
+	EXPECT_GE(p.wallTime, 0.0);
+	EXPECT_GE(p.cpuTime, 0.0);
+	EXPECT_GE(p.threadCpuTime, 0.0);
+	EXPECT_TRUE(p.ranAlone);
+	EXPECT_GE(p.peakResidentMemory, p.residentMemoryAfter);
+	EXPECT_EQ(
+		static_cast<std::int64_t>(p.residentMemoryAfter)
+			- static_cast<std::int64_t>(p.residentMemoryBefore),
+		p.getResidentMemoryDelta()
+	);
+}
+
+TEST_F(PassProfilerTests,
+EndPassWithoutRunningPassDoesNothing) {
+	profiler.endPass();
+
+	ASSERT_TRUE(profiler.getProfiles().empty());
+}
+
+TEST_F(PassProfilerTests,
+EndPassEndsMostRecentlyStartedNestedPass) {
+	profiler.startPass("bin2llvmir", "retdec-llvmir2hll");
+	profiler.startPass("llvmir2hll", "CopyPropagation", irSize(1, 0, 10));
+	profiler.endPass(irSize(1, 0, 7));
+	ASSERT_TRUE(profiler.isPassRunning());
+	profiler.endPass();
+
+	ASSERT_FALSE(profiler.isPassRunning());
+	ASSERT_EQ(2, profiler.getProfiles().size());
+	auto &outer = profiler.getProfiles()[0];
+	auto &inner = profiler.getProfiles()[1];
+	EXPECT_EQ("retdec-llvmir2hll", outer.name);
+	EXPECT_EQ(0, outer.depth);
+	EXPECT_EQ("CopyPropagation", inner.name);
+	EXPECT_EQ(1, inner.depth);
+	EXPECT_EQ(10, inner.irSizeBefore.instructions);
+	EXPECT_EQ(7, inner.irSizeAfter.instructions);
+	EXPECT_GE(outer.wallTime, inner.wallTime);
+}
+
+TEST_F(PassProfilerTests,
+EndAllPassesEndsAllRunningPasses) {
+	profiler.startPass("bin2llvmir", "retdec-llvmir2hll");
+	profiler.startPass("llvmir2hll", "CopyPropagation");
+
+	profiler.endAllPasses();
+
+	ASSERT_FALSE(profiler.isPassRunning());
+	ASSERT_EQ(2, profiler.getProfiles().size());
+}
+
+TEST_F(PassProfilerTests,
+ThreadCpuTimeDoesNotIncludeWorkOfOtherThreads) {
+	std::atomic<bool> stop(false);
+	std::thread busy([&]() {
+		volatile std::uint64_t x = 0;
+		while (!stop) {
+			x = x + 1;
+		}
+	});
+
+	profiler.startPass("bin2llvmir", "retdec-decoder");
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+	profiler.endPass();
+	stop = true;
+	busy.join();
+
+	auto &p = profiler.getProfiles().front();
+	EXPECT_GE(p.wallTime, 0.3);
+	EXPECT_LT(p.threadCpuTime, 0.15);
+}
+
+TEST_F(PassProfilerTests,
+CpuTimeIncludesWorkOfWorkerThreads) {
+	profiler.startPass("bin2llvmir", "retdec-decoder");
+	std::atomic<bool> stop(false);
+	std::thread busy([&]() {
+		volatile std::uint64_t x = 0;
+		while (!stop) {
+			x = x + 1;
+		}
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+	stop = true;
+	busy.join();
+	profiler.endPass();
+
+	auto &p = profiler.getProfiles().front();
+	EXPECT_TRUE(p.ranAlone);
+	EXPECT_GE(p.cpuTime, 0.15);
+	EXPECT_LT(p.threadCpuTime, 0.15);
+}
+
+TEST_F(PassProfilerTests,
+PassDidNotRunAloneWhenOtherJobRan) {
+	RunningJob job;
+	profiler.startPass("bin2llvmir", "retdec-decoder");
+	{
+		RunningJob otherJob;
+	}
+	profiler.endPass();
+
+	profiler.startPass("bin2llvmir", "retdec-decoder");
+	profiler.endPass();
+
+	ASSERT_EQ(2, profiler.getProfiles().size());
+	EXPECT_FALSE(profiler.getProfiles()[0].ranAlone);
+	EXPECT_TRUE(profiler.getProfiles()[1].ranAlone);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,139 @@
+/**
+* @file tests/utils/result_cache_tests.cpp
+* @brief Tests for the @c result_cache module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/result_cache.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c result_cache module.
+*/
+class ResultCacheTests: public Test {
+protected:
+	ResultCacheTests():
+		directory((fs::temp_directory_path()
+			/ ("retdec-result-cache-" + std::to_string(std::random_device()()))).string()),
+		cache(directory) {}
+
+	~ResultCacheTests() override {
+		std::error_code ec;
+		fs::remove_all(directory, ec);
+	}
+
+	std::string writeFile(const std::string &name, const std::string &content) {
+		auto path = fs::path(directory) / name;
+		fs::create_directories(path.parent_path());
+		std::ofstream(path, std::ios::binary) << content;
+		return path.string();
+	}
+
+	std::string directory;
+	ResultCache cache;
+};
+
+TEST_F(ResultCacheTests,
+StoredArtifactsAreLoaded) {
+	ResultCache::Artifacts artifacts = {
+		{"config.json", "{}"},
+		{"module.bc", std::string("BC\0\xC0\xDE", 5)}
+	};
+	ASSERT_TRUE(cache.store("abc-123", artifacts));
+
+	ResultCache::Artifacts loaded;
+	ASSERT_TRUE(cache.load("abc-123", loaded));
+	EXPECT_EQ(artifacts, loaded);
+}
+
+TEST_F(ResultCacheTests,
+MissingEntryIsNotLoaded) {
+	ResultCache::Artifacts loaded;
+	EXPECT_FALSE(cache.load("abc", loaded));
+	EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(ResultCacheTests,
+ExistingEntryIsNotReplaced) {
+	ASSERT_TRUE(cache.store("abc", {{"a", "first"}}));
+	EXPECT_FALSE(cache.store("abc", {{"a", "second"}}));
+
+	ResultCache::Artifacts loaded;
+	ASSERT_TRUE(cache.load("abc", loaded));
+	EXPECT_EQ("first", loaded["a"]);
+}
+
+TEST_F(ResultCacheTests,
+KeysWhichAreNotPlainNamesAreRejected) {
+	EXPECT_FALSE(cache.store("", {{"a", "b"}}));
+	EXPECT_FALSE(cache.store("../abc", {{"a", "b"}}));
+	EXPECT_FALSE(cache.store("a/b", {{"a", "b"}}));
+}
+
+TEST_F(ResultCacheTests,
+CacheWithoutDirectoryIsDisabled) {
+	ResultCache disabled("");
+	EXPECT_FALSE(disabled.isEnabled());
+	EXPECT_FALSE(disabled.store("abc", {{"a", "b"}}));
+}
+
+TEST_F(ResultCacheTests,
+FilesStampIsStableForUnchangedFiles) {
+	auto file = writeFile("rules/a.yara", "rule a {}");
+	EXPECT_EQ(ResultCache::getFilesStamp({file}), ResultCache::getFilesStamp({file}));
+}
+
+TEST_F(ResultCacheTests,
+FilesStampChangesWhenSizeOfFileChanges) {
+	auto file = writeFile("rules/a.yara", "rule a {}");
+	auto stamp = ResultCache::getFilesStamp({file});
+
+	writeFile("rules/a.yara", "rule a { condition: true }");
+	EXPECT_NE(stamp, ResultCache::getFilesStamp({file}));
+}
+
+TEST_F(ResultCacheTests,
+FilesStampChangesWhenFileIsModified) {
+	auto file = writeFile("rules/a.yara", "rule a {}");
+	auto stamp = ResultCache::getFilesStamp({file});
+
+	// Same size, so only the modification time differs.
+	writeFile("rules/a.yara", "rule b {}");
+	fs::last_write_time(file, fs::last_write_time(file) + std::chrono::seconds(5));
+	EXPECT_NE(stamp, ResultCache::getFilesStamp({file}));
+}
+
+TEST_F(ResultCacheTests,
+FilesStampOfDirectoryChangesWhenFileIsAdded) {
+	writeFile("rules/a.yara", "rule a {}");
+	auto rules = (fs::path(directory) / "rules").string();
+	auto stamp = ResultCache::getFilesStamp({rules});
+
+	writeFile("rules/nested/b.yara", "rule b {}");
+	EXPECT_NE(stamp, ResultCache::getFilesStamp({rules}));
+}
+
+TEST_F(ResultCacheTests,
+FilesStampChangesWhenMissingFileIsCreated) {
+	auto file = (fs::path(directory) / "a.yara").string();
+	auto stamp = ResultCache::getFilesStamp({file});
+	EXPECT_NE(std::string(), stamp);
+
+	writeFile("a.yara", "");
+	EXPECT_NE(stamp, ResultCache::getFilesStamp({file}));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
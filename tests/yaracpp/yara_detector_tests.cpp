@@ -0,0 +1,219 @@
+/**
+* @file tests/yaracpp/yara_detector_tests.cpp
+* @brief Tests for the @c yara_detector module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_detector.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace yaracpp {
+namespace tests {
+
+/**
+* @brief Tests for the @c yara_detector module.
+*/
+class YaraDetectorTests: public Test
+{
+	protected:
+		YaraDetectorTests()
+			: directory((fs::temp_directory_path()
+				/ ("retdec-yaracpp-" + std::to_string(std::random_device()()))))
+		{
+			fs::create_directories(directory);
+			YaraDetector::setRulesCacheDirectory(cacheDirectory().string());
+		}
+
+		~YaraDetectorTests() override
+		{
+			YaraDetector::setRulesCacheDirectory(std::string());
+			std::error_code ec;
+			fs::remove_all(directory, ec);
+		}
+
+		fs::path cacheDirectory() const
+		{
+			return directory / "cache";
+		}
+
+		std::vector<std::string> getFileExtensions(const fs::path& dir) const
+		{
+			std::vector<std::string> extensions;
+			for (const auto& entry : fs::directory_iterator(dir))
+			{
+				extensions.push_back(entry.path().extension().string());
+			}
+			std::sort(extensions.begin(), extensions.end());
+			return extensions;
+		}
+
+		std::string writeRuleFile(const std::string& name, const std::string& text)
+		{
+			auto path = (directory / name).string();
+			std::ofstream(path) << text;
+			return path;
+		}
+
+		fs::path directory;
+		const std::vector<std::uint8_t> content = {'x', 'H', 'E', 'L', 'L', 'O', 'x'};
+};
+
+TEST_F(YaraDetectorTests,
+RuleFromTextRuleFileIsDetected)
+{
+	auto path = writeRuleFile("hello.yara",
+		"rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(path));
+	ASSERT_TRUE(detector.analyze(content));
+
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("hello", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests,
+RulesMayReferenceRulesFromPreviouslyAddedFiles)
+{
+	auto first = writeRuleFile("first.yara",
+		"private rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+	auto second = writeRuleFile("second.yara",
+		"rule greeting { condition: hello }\n");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(first));
+	ASSERT_TRUE(detector.addRuleFile(second));
+	ASSERT_TRUE(detector.analyze(content));
+
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("greeting", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests,
+DetectedRulesKnowTheirRuleFiles)
+{
+	auto first = writeRuleFile("first.yara",
+		"rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+	auto second = writeRuleFile("second.yara",
+		"rule hello { strings: $s = \"LLO\" condition: $s }\n");
+	auto input = writeRuleFile("input.bin", "xHELLOx");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(first, first));
+	ASSERT_TRUE(detector.addRuleFile(second, second));
+	ASSERT_TRUE(detector.analyze(input));
+
+	ASSERT_EQ(2, detector.getDetectedRules().size());
+	EXPECT_EQ(first, detector.getDetectedRules()[0].getRuleFile());
+	EXPECT_EQ(second, detector.getDetectedRules()[1].getRuleFile());
+}
+
+TEST_F(YaraDetectorTests,
+RuleFileWhichCanNotBeCompiledIsNotAdded)
+{
+	auto broken = writeRuleFile("broken.yara",
+		"rule broken { condition: unknown_identifier }\n");
+	auto path = writeRuleFile("hello.yara",
+		"rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+
+	YaraDetector detector;
+	EXPECT_FALSE(detector.addRuleFile(broken));
+	// The failure is remembered, the file is not added the next time either.
+	EXPECT_FALSE(detector.addRuleFile(broken));
+	ASSERT_TRUE(detector.addRuleFile(path));
+	ASSERT_TRUE(detector.analyze(content));
+
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("hello", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests,
+CompiledRulesAreSavedOnlyIntoCacheDirectory)
+{
+	auto first = writeRuleFile("first.yara",
+		"private rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+	auto second = writeRuleFile("second.yara",
+		"rule greeting { condition: hello }\n");
+
+	{
+		YaraDetector detector;
+		ASSERT_TRUE(detector.addRuleFile(first));
+		ASSERT_TRUE(detector.addRuleFile(second));
+		ASSERT_TRUE(detector.analyze(content));
+	}
+
+	// Rules compiled from both files and a mark that the first file can be
+	// compiled alone, nothing that could be taken for a rule file.
+	EXPECT_EQ(
+		std::vector<std::string>({".rules", ".valid"}),
+		getFileExtensions(cacheDirectory()));
+	EXPECT_EQ(
+		std::vector<std::string>({"", ".yara", ".yara"}),
+		getFileExtensions(directory));
+
+	// Later detectors use the same rules.
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(first));
+	ASSERT_TRUE(detector.addRuleFile(second));
+	ASSERT_TRUE(detector.analyze(content));
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("greeting", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests,
+DetectorsCreatedConcurrentlyInBatchModeDetectRules)
+{
+	// Like workers of the batch mode of fileinfo, every thread creates its
+	// own detectors, so YARA is initialized and finalized concurrently.
+	auto path = writeRuleFile("hello.yara",
+		"rule hello { strings: $s = \"HELLO\" condition: $s }\n");
+
+	const std::size_t threadCount = 8;
+	const std::size_t filesPerThread = 25;
+	std::atomic<std::size_t> detected(0);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back([&]() {
+			for (std::size_t j = 0; j < filesPerThread; ++j)
+			{
+				YaraDetector detector;
+				if (detector.addRuleFile(path)
+						&& detector.analyze(content)
+						&& detector.getDetectedRules().size() == 1)
+				{
+					++detected;
+				}
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(threadCount * filesPerThread, detected);
+
+	// YARA has to be still usable afterwards.
+	YaraDetector detector;
+	ASSERT_TRUE(detector.isInValidState());
+	ASSERT_TRUE(detector.addRuleFile(path));
+	ASSERT_TRUE(detector.analyze(content));
+	EXPECT_EQ(1, detector.getDetectedRules().size());
+}
+
+} // namespace tests
+} // namespace yaracpp
+} // namespace retdec